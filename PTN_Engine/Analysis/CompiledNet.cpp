@@ -0,0 +1,261 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <iterator>
+
+namespace ptne
+{
+using namespace std;
+
+CompiledNet::~CompiledNet() = default;
+
+CompiledNet::CompiledNet(const vector<PlaceProperties> &placesProperties,
+						 const vector<TransitionProperties> &transitionsProperties)
+{
+	for (const auto &placeProperties : placesProperties)
+	{
+		m_places.push_back(Place{ .name = placeProperties.name,
+								  .initialNumberOfTokens = placeProperties.initialNumberOfTokens,
+								  .input = placeProperties.input,
+								  .hasActions = !placeProperties.onEnterActionFunctionName.empty() ||
+												!placeProperties.onExitActionFunctionName.empty() ||
+												placeProperties.onEnterAction != nullptr ||
+												placeProperties.onExitAction != nullptr ||
+												placeProperties.onEnterContextAction.function != nullptr ||
+												placeProperties.onExitContextAction.function != nullptr,
+								  .capacity = placeProperties.capacity });
+	}
+	ranges::sort(m_places, {}, &Place::name);
+	for (size_t i = 0; i < m_places.size(); ++i)
+	{
+		if (!m_placeIndexes.emplace(m_places[i].name, i).second)
+		{
+			throw RepeatedPlaceException(m_places[i].name);
+		}
+	}
+
+	auto toArcs = [this](const vector<ArcProperties> &arcsProperties)
+	{
+		vector<Arc> arcs;
+		for (const auto &arcProperties : arcsProperties)
+		{
+			arcs.push_back(Arc{ .place = getPlaceIndex(arcProperties.placeName), .weight = arcProperties.weight });
+		}
+		return arcs;
+	};
+
+	for (const auto &transitionProperties : transitionsProperties)
+	{
+		Transition transition{ .name = transitionProperties.name,
+							   .activationArcs = toArcs(transitionProperties.activationArcs),
+							   .destinationArcs = toArcs(transitionProperties.destinationArcs),
+							   .readArcs = toArcs(transitionProperties.readArcs),
+							   .minimumDelay = transitionProperties.minimumDelay,
+							   .maximumDelay = transitionProperties.maximumDelay,
+							   .hasAdditionalConditions = !transitionProperties.additionalConditionsNames.empty() ||
+														  !transitionProperties.additionalConditions.empty() ||
+														  !transitionProperties.additionalContextConditions.empty() };
+		for (const auto &arcProperties : transitionProperties.inhibitorArcs)
+		{
+			transition.inhibitorPlaces.push_back(getPlaceIndex(arcProperties.placeName));
+		}
+		for (const auto &arcProperties : transitionProperties.resetArcs)
+		{
+			transition.resetPlaces.push_back(getPlaceIndex(arcProperties.placeName));
+		}
+		addTokenLimits(transition);
+		m_transitions.push_back(std::move(transition));
+	}
+	ranges::sort(m_transitions, {}, &Transition::name);
+	for (size_t i = 0; i < m_transitions.size(); ++i)
+	{
+		m_transitionIndexes.emplace(m_transitions[i].name, i);
+	}
+
+	// The enabling of a transition only depends on the places of its activation, inhibitor and read arcs, and on
+	// its destination places with a capacity.
+	vector<vector<size_t>> transitionsByInputPlace(m_places.size());
+	for (size_t i = 0; i < m_transitions.size(); ++i)
+	{
+		for (const Arc &arc : m_transitions[i].activationArcs)
+		{
+			transitionsByInputPlace[arc.place].push_back(i);
+		}
+		for (const size_t place : m_transitions[i].inhibitorPlaces)
+		{
+			transitionsByInputPlace[place].push_back(i);
+		}
+		for (const Arc &arc : m_transitions[i].readArcs)
+		{
+			transitionsByInputPlace[arc.place].push_back(i);
+		}
+		for (const Arc &arc : m_transitions[i].tokenLimits)
+		{
+			transitionsByInputPlace[arc.place].push_back(i);
+		}
+	}
+
+	m_dependentTransitions.resize(m_transitions.size());
+	for (size_t i = 0; i < m_transitions.size(); ++i)
+	{
+		vector<size_t> &dependentTransitions = m_dependentTransitions[i];
+		for (const auto *arcs : { &m_transitions[i].activationArcs, &m_transitions[i].destinationArcs })
+		{
+			for (const Arc &arc : *arcs)
+			{
+				ranges::copy(transitionsByInputPlace[arc.place], back_inserter(dependentTransitions));
+			}
+		}
+		for (const size_t place : m_transitions[i].resetPlaces)
+		{
+			ranges::copy(transitionsByInputPlace[place], back_inserter(dependentTransitions));
+		}
+		dependentTransitions.push_back(i);
+		ranges::sort(dependentTransitions);
+		const auto [first, last] = ranges::unique(dependentTransitions);
+		dependentTransitions.erase(first, last);
+	}
+}
+
+CompiledNet::CompiledNet(const PTN_Engine &ptnEngine)
+: CompiledNet(ptnEngine.getPlacesProperties(), ptnEngine.getTransitionsProperties())
+{
+}
+
+const vector<CompiledNet::Place> &CompiledNet::getPlaces() const
+{
+	return m_places;
+}
+
+const vector<CompiledNet::Transition> &CompiledNet::getTransitions() const
+{
+	return m_transitions;
+}
+
+size_t CompiledNet::getPlaceIndex(const string &name) const
+{
+	const auto it = m_placeIndexes.find(name);
+	if (it == m_placeIndexes.end())
+	{
+		throw InvalidNameException(name);
+	}
+	return it->second;
+}
+
+size_t CompiledNet::getTransitionIndex(const string &name) const
+{
+	const auto it = m_transitionIndexes.find(name);
+	if (it == m_transitionIndexes.end())
+	{
+		throw InvalidNameException(name);
+	}
+	return it->second;
+}
+
+CompiledNet::Marking CompiledNet::getInitialMarking() const
+{
+	Marking marking;
+	marking.reserve(m_places.size());
+	ranges::transform(m_places, back_inserter(marking), &Place::initialNumberOfTokens);
+	return marking;
+}
+
+const vector<size_t> &CompiledNet::getDependentTransitions(const size_t transition) const
+{
+	return m_dependentTransitions.at(transition);
+}
+
+bool CompiledNet::isEnabled(const size_t transition, const Marking &marking) const
+{
+	const Transition &compiledTransition = m_transitions[transition];
+	auto hasEnoughTokens = [&marking](const Arc &arc) { return marking[arc.place] >= arc.weight; };
+	return !compiledTransition.exceedsCapacities &&
+		   ranges::all_of(compiledTransition.inhibitorPlaces,
+						  [&marking](const size_t place) { return marking[place] == 0; }) &&
+		   ranges::all_of(compiledTransition.activationArcs, hasEnoughTokens) &&
+		   ranges::all_of(compiledTransition.readArcs, hasEnoughTokens) &&
+		   ranges::all_of(compiledTransition.tokenLimits,
+						  [&marking](const Arc &arc) { return marking[arc.place] <= arc.weight; });
+}
+
+void CompiledNet::fire(const size_t transition, Marking &marking) const
+{
+	const Transition &compiledTransition = m_transitions[transition];
+	for (const Arc &arc : compiledTransition.activationArcs)
+	{
+		marking[arc.place] -= arc.weight;
+	}
+	for (const size_t place : compiledTransition.resetPlaces)
+	{
+		marking[place] = 0;
+	}
+	for (const Arc &arc : compiledTransition.destinationArcs)
+	{
+		marking[arc.place] += arc.weight;
+	}
+}
+
+void CompiledNet::addTokenLimits(Transition &transition) const
+{
+	for (const Arc &destinationArc : transition.destinationArcs)
+	{
+		const size_t capacity = m_places[destinationArc.place].capacity;
+		if (capacity == 0)
+		{
+			continue;
+		}
+
+		// The tokens consumed or reset by the transition leave before the produced ones enter.
+		if (destinationArc.weight > capacity)
+		{
+			transition.exceedsCapacities = true;
+		}
+		else if (ranges::find(transition.resetPlaces, destinationArc.place) == transition.resetPlaces.end())
+		{
+			const auto it = ranges::find(transition.activationArcs, destinationArc.place, &Arc::place);
+			const size_t consumed = it != transition.activationArcs.end() ? it->weight : 0;
+			transition.tokenLimits.push_back(
+			Arc{ .place = destinationArc.place, .weight = capacity + consumed - destinationArc.weight });
+		}
+	}
+}
+
+CompiledNet::PartialMarking CompiledNet::toPartialMarking(const map<string, size_t> &namedMarking) const
+{
+	PartialMarking partialMarking;
+	for (const auto &[name, numberOfTokens] : namedMarking)
+	{
+		partialMarking.emplace_back(getPlaceIndex(name), numberOfTokens);
+	}
+	return partialMarking;
+}
+
+map<string, size_t> CompiledNet::toNamedMarking(const Marking &marking) const
+{
+	map<string, size_t> namedMarking;
+	for (size_t i = 0; i < m_places.size(); ++i)
+	{
+		namedMarking.emplace(m_places[i].name, marking[i]);
+	}
+	return namedMarking;
+}
+
+} // namespace ptne
@@ -0,0 +1,194 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <chrono>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Token game representation of a Petri net, used by the analyses.
+//!
+//! Places and transitions are indexed by the order of their names, and a marking is the vector of the number of
+//! tokens in each place. Additional conditions and actions are not part of the token game.
+//!
+class CompiledNet final
+{
+public:
+	using Marking = std::vector<size_t>;
+
+	//! Number of tokens of some of the places, as pairs of place index and number of tokens.
+	using PartialMarking = std::vector<std::pair<size_t, size_t>>;
+
+	//! Arc between a place and a transition.
+	struct Arc
+	{
+		size_t place = 0;
+		size_t weight = 1;
+	};
+
+	//! Place of the token game.
+	struct Place
+	{
+		std::string name;
+		size_t initialNumberOfTokens = 0;
+		bool input = false;
+		bool hasActions = false;
+		//! Maximum number of tokens, zero if unbounded.
+		size_t capacity = 0;
+	};
+
+	//! Transition of the token game.
+	struct Transition
+	{
+		std::string name;
+		std::vector<Arc> activationArcs;
+		std::vector<Arc> destinationArcs;
+		std::vector<size_t> inhibitorPlaces;
+		std::vector<size_t> resetPlaces;
+		std::vector<Arc> readArcs;
+		//! Maximum number of tokens each destination place with a capacity can have for the transition to fire.
+		std::vector<Arc> tokenLimits;
+		std::chrono::milliseconds minimumDelay = std::chrono::milliseconds::zero();
+		std::chrono::milliseconds maximumDelay = std::chrono::milliseconds::zero();
+		bool hasAdditionalConditions = false;
+		//! Whether the transition produces more tokens than the capacity of a destination place, and never fires.
+		bool exceedsCapacities = false;
+	};
+
+	~CompiledNet();
+
+	//!
+	//! \brief CompiledNet constructor.
+	//! \param placesProperties - The places of the net.
+	//! \param transitionsProperties - The transitions of the net.
+	//!
+	CompiledNet(const std::vector<PlaceProperties> &placesProperties,
+				const std::vector<TransitionProperties> &transitionsProperties);
+
+	//!
+	//! \brief CompiledNet constructor. The initial marking is the current marking of the net.
+	//! \param ptnEngine - The net.
+	//!
+	explicit CompiledNet(const PTN_Engine &ptnEngine);
+
+	CompiledNet(const CompiledNet &) = delete;
+	CompiledNet(CompiledNet &&) = delete;
+	CompiledNet &operator=(const CompiledNet &) = delete;
+	CompiledNet &operator=(CompiledNet &&) = delete;
+
+	//!
+	//! \brief Get the places of the net.
+	//! \return The places, by index.
+	//!
+	const std::vector<Place> &getPlaces() const;
+
+	//!
+	//! \brief Get the transitions of the net.
+	//! \return The transitions, by index.
+	//!
+	const std::vector<Transition> &getTransitions() const;
+
+	//!
+	//! \brief Get the index of a place. Throws InvalidNameException if the place does not exist.
+	//! \param name - Name of the place.
+	//! \return Index of the place.
+	//!
+	size_t getPlaceIndex(const std::string &name) const;
+
+	//!
+	//! \brief Get the index of a transition. Throws InvalidNameException if the transition does not exist.
+	//! \param name - Name of the transition.
+	//! \return Index of the transition.
+	//!
+	size_t getTransitionIndex(const std::string &name) const;
+
+	//!
+	//! \brief Get the initial marking of the net.
+	//! \return The initial marking.
+	//!
+	Marking getInitialMarking() const;
+
+	//!
+	//! \brief Get the transitions whose enabling may change when a transition fires, including itself.
+	//! \param transition - Index of the fired transition.
+	//! \return Indexes of the dependent transitions, in ascending order.
+	//!
+	const std::vector<size_t> &getDependentTransitions(const size_t transition) const;
+
+	//!
+	//! \brief Check if a transition is enabled by the tokens of a marking.
+	//! \param transition - Index of the transition.
+	//! \param marking - The marking.
+	//! \return True if the transition is enabled.
+	//!
+	bool isEnabled(const size_t transition, const Marking &marking) const;
+
+	//!
+	//! \brief Fire an enabled transition.
+	//! \param transition - Index of the transition.
+	//! \param marking - The marking to be changed.
+	//!
+	void fire(const size_t transition, Marking &marking) const;
+
+	//!
+	//! \brief Convert a marking of named places into indexes. Throws InvalidNameException for unknown places.
+	//! \param namedMarking - Number of tokens by place name.
+	//! \return The marking of the listed places.
+	//!
+	PartialMarking toPartialMarking(const std::map<std::string, size_t> &namedMarking) const;
+
+	//!
+	//! \brief Convert a marking into a map of named places.
+	//! \param marking - The marking.
+	//! \return Number of tokens by place name.
+	//!
+	std::map<std::string, size_t> toNamedMarking(const Marking &marking) const;
+
+private:
+	//!
+	//! \brief Compute the limits the destination places with a capacity impose on the enabling of a transition.
+	//! \param transition - The transition, with its arcs already set.
+	//!
+	void addTokenLimits(Transition &transition) const;
+
+	//! Places, in order of their names.
+	std::vector<Place> m_places;
+
+	//! Transitions, in order of their names.
+	std::vector<Transition> m_transitions;
+
+	//! Indexes of the places by name.
+	std::unordered_map<std::string, size_t> m_placeIndexes;
+
+	//! Indexes of the transitions by name.
+	std::unordered_map<std::string, size_t> m_transitionIndexes;
+
+	//! For each transition, the transitions whose enabling may change when it fires.
+	std::vector<std::vector<size_t>> m_dependentTransitions;
+};
+
+} // namespace ptne
@@ -0,0 +1,347 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/Coverability.h"
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! Number of tokens of a place that can grow without bound.
+constexpr size_t OMEGA = numeric_limits<size_t>::max();
+
+//! Number of nodes a thread takes from the frontier at once.
+constexpr size_t nodesPerBatch = 16;
+
+//!
+//! \brief Karp-Miller coverability tree, built level by level. The threads expand the nodes of a level, and the
+//! new nodes are then added to the tree in a deterministic order.
+//!
+class CoverabilityExplorer final
+{
+public:
+	CoverabilityExplorer(const CompiledNet &net, const CoverabilityOptions &options)
+	: m_net(net)
+	, m_options(options)
+	, m_limitedPlaces(net.getPlaces().size(), false)
+	{
+		for (const CompiledNet::Transition &transition : m_net.getTransitions())
+		{
+			for (const CompiledNet::Arc &arc : transition.tokenLimits)
+			{
+				m_limitedPlaces[arc.place] = true;
+			}
+		}
+	}
+
+	CoverabilityExplorer(const CoverabilityExplorer &) = delete;
+	CoverabilityExplorer(CoverabilityExplorer &&) = delete;
+	CoverabilityExplorer &operator=(const CoverabilityExplorer &) = delete;
+	CoverabilityExplorer &operator=(CoverabilityExplorer &&) = delete;
+
+	CoverabilityResult run()
+	{
+		vector<CompiledNet::PartialMarking> targetMarkings;
+		for (const auto &targetMarking : m_options.targetMarkings)
+		{
+			targetMarkings.push_back(m_net.toPartialMarking(targetMarking));
+		}
+
+		size_t numberOfThreads =
+		m_options.numberOfThreads != 0 ? m_options.numberOfThreads : thread::hardware_concurrency();
+		numberOfThreads = max<size_t>(numberOfThreads, 1);
+
+		CompiledNet::Marking initialMarking = m_net.getInitialMarking();
+		for (size_t place = 0; place < initialMarking.size(); ++place)
+		{
+			if (m_net.getPlaces()[place].input)
+			{
+				initialMarking[place] = OMEGA;
+			}
+		}
+		bool complete = m_options.maxNodes > 0;
+		if (complete)
+		{
+			addNode(Node{ .marking = std::move(initialMarking), .parent = 0 });
+		}
+
+		for (size_t levelBegin = 0; levelBegin < m_nodes.size() && complete;)
+		{
+			const size_t levelEnd = m_nodes.size();
+			m_successors.assign(levelEnd - levelBegin, {});
+			m_nextIndex.store(levelBegin, memory_order_relaxed);
+			{
+				vector<jthread> threads;
+				for (size_t i = 1; i < min(numberOfThreads, levelEnd - levelBegin); ++i)
+				{
+					threads.emplace_back([this, levelBegin, levelEnd] { expandLevel(levelBegin, levelEnd); });
+				}
+				expandLevel(levelBegin, levelEnd);
+			}
+
+			// Successors covered by the nodes of the next level are discarded here, those covered by the previous
+			// nodes were already discarded while expanding.
+			for (size_t i = 0; i < m_successors.size() && complete; ++i)
+			{
+				for (Node &successor : m_successors[i])
+				{
+					const bool isCovered = any_of(ranges::lower_bound(m_maximalNodes, levelEnd), m_maximalNodes.end(),
+												  [this, &successor](const size_t node)
+												  { return isCoveredBy(successor.marking, m_nodes[node].marking); });
+					if (isCovered)
+					{
+						continue;
+					}
+					if (m_nodes.size() == m_options.maxNodes)
+					{
+						complete = false;
+						break;
+					}
+					addNode(std::move(successor));
+				}
+			}
+			levelBegin = levelEnd;
+		}
+
+		CoverabilityResult result;
+		result.complete = complete;
+		result.numberOfNodes = m_nodes.size();
+		vector<size_t> placeBounds(m_net.getPlaces().size(), 0);
+		for (const Node &node : m_nodes)
+		{
+			ranges::transform(placeBounds, node.marking, placeBounds.begin(),
+							  [](const size_t a, const size_t b) { return max(a, b); });
+		}
+		for (size_t place = 0; place < placeBounds.size(); ++place)
+		{
+			// Input places are unbounded sources of tokens, but never hold more tokens than their capacity.
+			if (const size_t capacity = m_net.getPlaces()[place].capacity; capacity != 0)
+			{
+				placeBounds[place] = min(placeBounds[place], capacity);
+			}
+			if (placeBounds[place] == OMEGA)
+			{
+				result.unboundedPlaces.push_back(m_net.getPlaces()[place].name);
+			}
+			else
+			{
+				result.placeBounds[m_net.getPlaces()[place].name] = placeBounds[place];
+			}
+		}
+		for (const CompiledNet::PartialMarking &targetMarking : targetMarkings)
+		{
+			result.coverableTargetMarkings.push_back(
+			ranges::any_of(m_maximalNodes,
+						   [this, &targetMarking](const size_t node)
+						   {
+							   return ranges::all_of(targetMarking, [&marking = m_nodes[node].marking](const auto &entry)
+													 { return entry.second <= marking[entry.first]; });
+						   }));
+		}
+		return result;
+	}
+
+private:
+	//! Node of the coverability tree.
+	struct Node
+	{
+		//! The marking, with OMEGA in the unbounded places.
+		CompiledNet::Marking marking;
+
+		//! Index of the parent node. The root is its own parent.
+		size_t parent = 0;
+	};
+
+	//!
+	//! \brief Check if a marking is covered by another. Extra tokens in a place limiting the tokens a transition can
+	//! produce may disable the transition, so the limited places must have the same number of tokens.
+	//! \param marking - The marking.
+	//! \param other - The other marking.
+	//! \return True if the other marking has at least as many tokens in every place, and as many in the limited
+	//! places.
+	//!
+	bool isCoveredBy(const CompiledNet::Marking &marking, const CompiledNet::Marking &other) const
+	{
+		for (size_t place = 0; place < marking.size(); ++place)
+		{
+			if (m_limitedPlaces[place] ? marking[place] != other[place] : marking[place] > other[place])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//!
+	//! \brief Add a node to the tree, and update the nodes not covered by others.
+	//! \param node - The node.
+	//!
+	void addNode(Node &&node)
+	{
+		erase_if(m_maximalNodes,
+				 [this, &node](const size_t other) { return isCoveredBy(m_nodes[other].marking, node.marking); });
+		m_maximalNodes.push_back(m_nodes.size());
+		m_nodes.push_back(std::move(node));
+	}
+
+	//!
+	//! \brief Thread function, expands the nodes of a level.
+	//! \param levelBegin - Index of the first node of the level.
+	//! \param levelEnd - Index after the last node of the level.
+	//!
+	void expandLevel(const size_t levelBegin, const size_t levelEnd)
+	{
+		for (size_t begin = m_nextIndex.fetch_add(nodesPerBatch, memory_order_relaxed); begin < levelEnd;
+			 begin = m_nextIndex.fetch_add(nodesPerBatch, memory_order_relaxed))
+		{
+			for (size_t node = begin; node < min(begin + nodesPerBatch, levelEnd); ++node)
+			{
+				expand(node, m_successors[node - levelBegin]);
+			}
+		}
+	}
+
+	//!
+	//! \brief Fire each enabled transition of a node, and collect the successors not covered by the tree.
+	//! \param node - Index of the node.
+	//! \param successors - Receives the successors.
+	//!
+	void expand(const size_t node, vector<Node> &successors) const
+	{
+		const CompiledNet::Marking &marking = m_nodes[node].marking;
+		for (size_t transition = 0; transition < m_net.getTransitions().size(); ++transition)
+		{
+			if (!m_net.isEnabled(transition, marking))
+			{
+				continue;
+			}
+
+			Node successor{ .marking = marking, .parent = node };
+			fire(transition, successor.marking);
+			accelerate(node, successor.marking);
+			const bool isCovered = ranges::any_of(m_maximalNodes, [this, &successor](const size_t other)
+												  { return isCoveredBy(successor.marking, m_nodes[other].marking); });
+			const bool isRepeated = ranges::any_of(successors, [this, &successor](const Node &other)
+												   { return isCoveredBy(successor.marking, other.marking); });
+			if (!isCovered && !isRepeated)
+			{
+				successors.push_back(std::move(successor));
+			}
+		}
+	}
+
+	//!
+	//! \brief Fire a transition, keeping the unbounded places unbounded unless a reset arc empties them.
+	//! \param transition - Index of the transition.
+	//! \param marking - The marking, updated.
+	//!
+	void fire(const size_t transition, CompiledNet::Marking &marking) const
+	{
+		const CompiledNet::Transition &compiledTransition = m_net.getTransitions()[transition];
+		for (const CompiledNet::Arc &arc : compiledTransition.activationArcs)
+		{
+			if (marking[arc.place] != OMEGA)
+			{
+				marking[arc.place] -= arc.weight;
+			}
+		}
+		for (const size_t place : compiledTransition.resetPlaces)
+		{
+			marking[place] = 0;
+		}
+		for (const CompiledNet::Arc &arc : compiledTransition.destinationArcs)
+		{
+			if (marking[arc.place] != OMEGA)
+			{
+				marking[arc.place] += arc.weight;
+			}
+		}
+	}
+
+	//!
+	//! \brief Mark as unbounded the places that grew since an ancestor covered by the marking. Places with a
+	//! capacity are bounded, and keep their number of tokens.
+	//! \param parent - Index of the node the marking was reached from.
+	//! \param marking - The marking, updated.
+	//!
+	void accelerate(const size_t parent, CompiledNet::Marking &marking) const
+	{
+		for (size_t ancestor = parent;; ancestor = m_nodes[ancestor].parent)
+		{
+			const CompiledNet::Marking &ancestorMarking = m_nodes[ancestor].marking;
+			if (isCoveredBy(ancestorMarking, marking))
+			{
+				for (size_t place = 0; place < marking.size(); ++place)
+				{
+					if (ancestorMarking[place] < marking[place] && m_net.getPlaces()[place].capacity == 0)
+					{
+						marking[place] = OMEGA;
+					}
+				}
+			}
+			if (ancestor == 0)
+			{
+				break;
+			}
+		}
+	}
+
+	const CompiledNet &m_net;
+	const CoverabilityOptions &m_options;
+
+	//! Whether each place limits the tokens a transition can produce, because of its capacity.
+	vector<bool> m_limitedPlaces;
+
+	//! Nodes of the tree, in breadth first order.
+	vector<Node> m_nodes;
+
+	//! Nodes whose marking is not covered by another node, in ascending order.
+	vector<size_t> m_maximalNodes;
+
+	//! Successors of each node of the level being expanded.
+	vector<vector<Node>> m_successors;
+
+	//! Index of the next node of the level to be expanded.
+	atomic<size_t> m_nextIndex = 0;
+};
+
+} // namespace
+
+CoverabilityResult exploreCoverability(const PTN_Engine &ptnEngine, const CoverabilityOptions &options)
+{
+	const CompiledNet net(ptnEngine);
+	return CoverabilityExplorer(net, options).run();
+}
+
+CoverabilityResult exploreCoverability(const vector<PlaceProperties> &placesProperties,
+									   const vector<TransitionProperties> &transitionsProperties,
+									   const CoverabilityOptions &options)
+{
+	const CompiledNet net(placesProperties, transitionsProperties);
+	return CoverabilityExplorer(net, options).run();
+}
+
+} // namespace ptne
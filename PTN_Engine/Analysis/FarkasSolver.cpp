@@ -0,0 +1,316 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/FarkasSolver.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <ranges>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+int64_t multiply(const int64_t a, const int64_t b)
+{
+	if (a != 0 && (b > numeric_limits<int64_t>::max() / a || b < -numeric_limits<int64_t>::max() / a))
+	{
+		throw PTN_Exception("Integer overflow while computing the invariants.");
+	}
+	return a * b;
+}
+
+int64_t add(const int64_t a, const int64_t b)
+{
+	if ((b > 0 && a > numeric_limits<int64_t>::max() - b) || (b < 0 && a < -numeric_limits<int64_t>::max() - b))
+	{
+		throw PTN_Exception("Integer overflow while computing the invariants.");
+	}
+	return a + b;
+}
+
+//!
+//! \brief Compute a * x + b * y for sparse vectors, skipping an index and the zero results.
+//!
+void combineSparse(const FarkasSolver::SparseVector &x,
+				   const int64_t a,
+				   const FarkasSolver::SparseVector &y,
+				   const int64_t b,
+				   const size_t skippedIndex,
+				   FarkasSolver::SparseVector &result)
+{
+	auto itX = x.begin();
+	auto itY = y.begin();
+	while (itX != x.end() || itY != y.end())
+	{
+		size_t index = 0;
+		int64_t value = 0;
+		if (itY == y.end() || (itX != x.end() && itX->first < itY->first))
+		{
+			index = itX->first;
+			value = multiply(a, itX->second);
+			++itX;
+		}
+		else if (itX == x.end() || itY->first < itX->first)
+		{
+			index = itY->first;
+			value = multiply(b, itY->second);
+			++itY;
+		}
+		else
+		{
+			index = itX->first;
+			value = add(multiply(a, itX->second), multiply(b, itY->second));
+			++itX;
+			++itY;
+		}
+		if (value != 0 && index != skippedIndex)
+		{
+			result.emplace_back(index, value);
+		}
+	}
+}
+
+} // namespace
+
+FarkasSolver::~FarkasSolver() = default;
+
+FarkasSolver::FarkasSolver(const vector<SparseVector> &rows, const size_t numberOfColumns, const size_t maxRows)
+: m_maxRows(maxRows)
+, m_columnRows(numberOfColumns)
+, m_positiveEntries(numberOfColumns, 0)
+, m_negativeEntries(numberOfColumns, 0)
+, m_supportSizes(numberOfColumns, 0)
+, m_eliminated(numberOfColumns, false)
+, m_columnVersions(numberOfColumns, 0)
+, m_rowsBySupportStart(rows.size())
+{
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		addRow(Row{ .entries = rows[i], .coefficients = { { i, 1 } } });
+	}
+	for (size_t column = 0; column < numberOfColumns; ++column)
+	{
+		updateColumn(column);
+	}
+}
+
+vector<FarkasSolver::SparseVector> FarkasSolver::solve()
+{
+	for (size_t column = chooseColumn(); column < m_columnRows.size(); column = chooseColumn())
+	{
+		if (!eliminate(column))
+		{
+			m_complete = false;
+			break;
+		}
+	}
+
+	vector<SparseVector> solutions;
+	for (const Row &row : m_rows)
+	{
+		if (row.alive && row.entries.empty())
+		{
+			solutions.push_back(row.coefficients);
+		}
+	}
+	ranges::sort(solutions);
+	const auto [first, last] = ranges::unique(solutions);
+	solutions.erase(first, last);
+	return solutions;
+}
+
+bool FarkasSolver::isComplete() const
+{
+	return m_complete;
+}
+
+void FarkasSolver::addRow(Row &&row)
+{
+	const size_t index = m_rows.size();
+	for (const auto &[column, value] : row.entries)
+	{
+		m_columnRows[column].push_back(index);
+		++(value > 0 ? m_positiveEntries : m_negativeEntries)[column];
+		m_supportSizes[column] += row.coefficients.size();
+	}
+	m_rowsBySupportStart[row.coefficients.front().first].push_back(index);
+	m_rows.push_back(std::move(row));
+	++m_numberOfRows;
+}
+
+void FarkasSolver::removeRow(const size_t row)
+{
+	m_rows[row].alive = false;
+	for (const auto &[column, value] : m_rows[row].entries)
+	{
+		--(value > 0 ? m_positiveEntries : m_negativeEntries)[column];
+		m_supportSizes[column] -= m_rows[row].coefficients.size();
+	}
+	--m_numberOfRows;
+}
+
+void FarkasSolver::updateColumn(const size_t column)
+{
+	const auto positive = static_cast<int64_t>(m_positiveEntries[column]);
+	const auto negative = static_cast<int64_t>(m_negativeEntries[column]);
+	if (m_eliminated[column] || positive + negative == 0)
+	{
+		return;
+	}
+
+	// Number of rows added minus number of rows removed.
+	const int64_t cost = positive * negative - positive - negative;
+	m_columns.emplace(cost, m_supportSizes[column], column, ++m_columnVersions[column]);
+}
+
+size_t FarkasSolver::chooseColumn()
+{
+	while (!m_columns.empty())
+	{
+		const auto [cost, supportSize, column, version] = m_columns.top();
+		m_columns.pop();
+		if (version == m_columnVersions[column] && !m_eliminated[column])
+		{
+			return column;
+		}
+	}
+	return m_columnRows.size();
+}
+
+bool FarkasSolver::eliminate(const size_t column)
+{
+	m_eliminated[column] = true;
+	vector<size_t> positiveRows;
+	vector<size_t> negativeRows;
+	for (const size_t row : m_columnRows[column])
+	{
+		if (m_rows[row].alive)
+		{
+			const auto it = ranges::lower_bound(m_rows[row].entries, column, {}, &pair<size_t, int64_t>::first);
+			(it->second > 0 ? positiveRows : negativeRows).push_back(row);
+		}
+	}
+	m_columnRows[column].clear();
+
+	// The combinations are only compared against the rows before the elimination, so they are added at the end.
+	vector<Row> newRows;
+	vector<size_t> support;
+	for (const size_t positive : positiveRows)
+	{
+		for (const size_t negative : negativeRows)
+		{
+			support.clear();
+			ranges::set_union(m_rows[positive].coefficients | views::keys, m_rows[negative].coefficients | views::keys,
+							  back_inserter(support));
+			if (isSupportDominated(support, positive, negative))
+			{
+				continue;
+			}
+			if (m_numberOfRows + newRows.size() >= m_maxRows)
+			{
+				return false;
+			}
+			newRows.push_back(combine(m_rows[positive], m_rows[negative], column));
+		}
+	}
+
+	vector<size_t> changedColumns;
+	for (const size_t row : positiveRows)
+	{
+		removeRow(row);
+		ranges::copy(m_rows[row].entries | views::keys, back_inserter(changedColumns));
+	}
+	for (const size_t row : negativeRows)
+	{
+		removeRow(row);
+		ranges::copy(m_rows[row].entries | views::keys, back_inserter(changedColumns));
+	}
+	for (Row &row : newRows)
+	{
+		ranges::copy(row.entries | views::keys, back_inserter(changedColumns));
+		addRow(std::move(row));
+	}
+
+	ranges::sort(changedColumns);
+	const auto [first, last] = ranges::unique(changedColumns);
+	changedColumns.erase(first, last);
+	for (const size_t changedColumn : changedColumns)
+	{
+		updateColumn(changedColumn);
+	}
+	return true;
+}
+
+bool FarkasSolver::isSupportDominated(const vector<size_t> &support, const size_t first, const size_t second)
+{
+	// A row with a support contained in the given one has its smallest index in it.
+	for (const size_t start : support)
+	{
+		auto &rows = m_rowsBySupportStart[start];
+		erase_if(rows, [this](const size_t row) { return !m_rows[row].alive; });
+		for (const size_t row : rows)
+		{
+			if (row != first && row != second &&
+				ranges::includes(support, m_rows[row].coefficients, {}, {}, &pair<size_t, int64_t>::first))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+FarkasSolver::Row FarkasSolver::combine(const Row &positive, const Row &negative, const size_t column) const
+{
+	const int64_t positiveValue = ranges::lower_bound(positive.entries, column, {}, &pair<size_t, int64_t>::first)->second;
+	const int64_t negativeValue = ranges::lower_bound(negative.entries, column, {}, &pair<size_t, int64_t>::first)->second;
+
+	Row row;
+	combineSparse(positive.entries, -negativeValue, negative.entries, positiveValue, column, row.entries);
+	combineSparse(positive.coefficients, -negativeValue, negative.coefficients, positiveValue,
+				  numeric_limits<size_t>::max(), row.coefficients);
+
+	int64_t divisor = 0;
+	for (const auto &[_, value] : row.entries)
+	{
+		divisor = gcd(divisor, value);
+	}
+	for (const auto &[_, value] : row.coefficients)
+	{
+		divisor = gcd(divisor, value);
+	}
+	if (divisor > 1)
+	{
+		for (auto &[_, value] : row.entries)
+		{
+			value /= divisor;
+		}
+		for (auto &[_, value] : row.coefficients)
+		{
+			value /= divisor;
+		}
+	}
+	return row;
+}
+
+} // namespace ptne
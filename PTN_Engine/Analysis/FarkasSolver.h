@@ -0,0 +1,179 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Computes the minimal support non-negative integer solutions of y * A = 0, for a sparse integer matrix A,
+//! with the Farkas algorithm.
+//!
+//! The algorithm starts from the rows of A, each extended with its row of the identity matrix, and eliminates one
+//! column of A at a time by replacing the rows with non zero entries in that column by the non negative
+//! combinations of a positive and a negative row that cancel it. Combinations whose support contains the support
+//! of another row are discarded, since they are not minimal. The next column is the one that creates the fewest
+//! rows, and among those the one whose rows have the smallest supports, which keeps the rows of chains of nodes
+//! short.
+//!
+class FarkasSolver final
+{
+public:
+	//! Sparse vector, as pairs of index and value in ascending order of index.
+	using SparseVector = std::vector<std::pair<size_t, int64_t>>;
+
+	~FarkasSolver();
+
+	//!
+	//! \brief FarkasSolver constructor.
+	//! \param rows - The rows of the matrix.
+	//! \param numberOfColumns - The number of columns of the matrix.
+	//! \param maxRows - Maximum number of intermediate rows, after which the solver stops.
+	//!
+	FarkasSolver(const std::vector<SparseVector> &rows, const size_t numberOfColumns, const size_t maxRows);
+
+	FarkasSolver(const FarkasSolver &) = delete;
+	FarkasSolver(FarkasSolver &&) = delete;
+	FarkasSolver &operator=(const FarkasSolver &) = delete;
+	FarkasSolver &operator=(FarkasSolver &&) = delete;
+
+	//!
+	//! \brief Compute the solutions. Throws PTN_Exception if the coefficients overflow.
+	//! \return The minimal support solutions, as sparse vectors indexed by row, with coprime positive values.
+	//! Only a part of them if the maximum number of intermediate rows was reached.
+	//!
+	std::vector<SparseVector> solve();
+
+	//!
+	//! \brief Check whether solve found all the solutions.
+	//! \return False if the maximum number of intermediate rows was reached.
+	//!
+	bool isComplete() const;
+
+private:
+	//! Row of the extended matrix.
+	struct Row
+	{
+		//! The remaining entries of the matrix.
+		SparseVector entries;
+
+		//! The coefficients of the combination of original rows, which are the solution once entries is empty.
+		SparseVector coefficients;
+
+		bool alive = true;
+	};
+
+	//!
+	//! \brief Add a row to the extended matrix.
+	//! \param row - The row.
+	//!
+	void addRow(Row &&row);
+
+	//!
+	//! \brief Remove a row from the extended matrix.
+	//! \param row - Index of the row.
+	//!
+	void removeRow(const size_t row);
+
+	//!
+	//! \brief Update the priority of a column after its rows changed.
+	//! \param column - The column.
+	//!
+	void updateColumn(const size_t column);
+
+	//!
+	//! \brief Choose the next column to be eliminated.
+	//! \return The column, or the number of columns if all are eliminated.
+	//!
+	size_t chooseColumn();
+
+	//!
+	//! \brief Eliminate a column.
+	//! \param column - The column.
+	//! \return False if the maximum number of rows was reached.
+	//!
+	bool eliminate(const size_t column);
+
+	//!
+	//! \brief Check if another row has a support contained in a support.
+	//! \param support - The support, in ascending order.
+	//! \param first - Row to be ignored.
+	//! \param second - Row to be ignored.
+	//! \return True if such a row exists.
+	//!
+	bool isSupportDominated(const std::vector<size_t> &support, const size_t first, const size_t second);
+
+	//!
+	//! \brief Combine two rows so that a column cancels out.
+	//! \param positive - Row with a positive entry in the column.
+	//! \param negative - Row with a negative entry in the column.
+	//! \param column - The column.
+	//! \return The combined row, normalized.
+	//!
+	Row combine(const Row &positive, const Row &negative, const size_t column) const;
+
+	//! Rows of the extended matrix, including the removed ones.
+	std::vector<Row> m_rows;
+
+	//! Number of rows not removed.
+	size_t m_numberOfRows = 0;
+
+	//! Maximum number of rows.
+	const size_t m_maxRows;
+
+	//! For each column, the rows with a non zero entry in it, including removed rows.
+	std::vector<std::vector<size_t>> m_columnRows;
+
+	//! For each column, the number of rows with a positive entry in it.
+	std::vector<size_t> m_positiveEntries;
+
+	//! For each column, the number of rows with a negative entry in it.
+	std::vector<size_t> m_negativeEntries;
+
+	//! For each column, the sum of the support sizes of the rows with a non zero entry in it.
+	std::vector<size_t> m_supportSizes;
+
+	//! Whether each column was eliminated.
+	std::vector<bool> m_eliminated;
+
+	//! For each column, the version of its latest priority, to discard outdated priorities.
+	std::vector<size_t> m_columnVersions;
+
+	//! Priority of a column: number of rows created, sum of the support sizes, column and version.
+	using ColumnPriority = std::tuple<int64_t, size_t, size_t, size_t>;
+
+	//! Priorities of the columns, best first, including outdated ones.
+	std::priority_queue<ColumnPriority, std::vector<ColumnPriority>, std::greater<ColumnPriority>> m_columns;
+
+	//! For each original row, the rows whose support starts with it, including removed rows.
+	std::vector<std::vector<size_t>> m_rowsBySupportStart;
+
+	//! Whether all the solutions were found.
+	bool m_complete = true;
+};
+
+} // namespace ptne
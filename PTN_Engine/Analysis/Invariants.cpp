@@ -0,0 +1,200 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/Invariants.h"
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include "PTN_Engine/Analysis/FarkasSolver.h"
+#include <algorithm>
+#include <limits>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//!
+//! \brief Build the incidence matrix of a net, with a row per transition.
+//! \param net - The net.
+//! \return The net change of the number of tokens of each place when each transition fires.
+//!
+vector<FarkasSolver::SparseVector> getTransitionEffects(const CompiledNet &net)
+{
+	vector<FarkasSolver::SparseVector> effects;
+	map<size_t, int64_t> effect;
+	for (const CompiledNet::Transition &transition : net.getTransitions())
+	{
+		effect.clear();
+		for (const CompiledNet::Arc &arc : transition.activationArcs)
+		{
+			effect[arc.place] -= static_cast<int64_t>(arc.weight);
+		}
+		for (const CompiledNet::Arc &arc : transition.destinationArcs)
+		{
+			effect[arc.place] += static_cast<int64_t>(arc.weight);
+		}
+		FarkasSolver::SparseVector &row = effects.emplace_back();
+		for (const auto &[place, value] : effect)
+		{
+			if (value != 0)
+			{
+				row.emplace_back(place, value);
+			}
+		}
+	}
+	return effects;
+}
+
+//!
+//! \brief Transpose a sparse matrix.
+//! \param rows - The rows of the matrix.
+//! \param numberOfColumns - The number of columns of the matrix.
+//! \return The rows of the transposed matrix.
+//!
+vector<FarkasSolver::SparseVector> transpose(const vector<FarkasSolver::SparseVector> &rows,
+											 const size_t numberOfColumns)
+{
+	vector<FarkasSolver::SparseVector> columns(numberOfColumns);
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		for (const auto &[column, value] : rows[i])
+		{
+			columns[column].emplace_back(i, value);
+		}
+	}
+	return columns;
+}
+
+//!
+//! \brief Compute the bounds of the places covered by the place invariants.
+//! \param net - The net.
+//! \param placeInvariants - The place invariants, indexed by place.
+//! \return The upper bound of each covered place.
+//!
+map<string, size_t> getPlaceBounds(const CompiledNet &net, const vector<FarkasSolver::SparseVector> &placeInvariants)
+{
+	const CompiledNet::Marking marking = net.getInitialMarking();
+	vector<size_t> bounds(net.getPlaces().size(), numeric_limits<size_t>::max());
+	for (const FarkasSolver::SparseVector &invariant : placeInvariants)
+	{
+		// The weighted sum of tokens is constant, so no place can have more tokens than it allows.
+		size_t weightedSum = 0;
+		for (const auto &[place, weight] : invariant)
+		{
+			weightedSum += static_cast<size_t>(weight) * marking[place];
+		}
+		for (const auto &[place, weight] : invariant)
+		{
+			bounds[place] = min(bounds[place], weightedSum / static_cast<size_t>(weight));
+		}
+	}
+
+	map<string, size_t> placeBounds;
+	for (size_t place = 0; place < bounds.size(); ++place)
+	{
+		if (bounds[place] != numeric_limits<size_t>::max())
+		{
+			placeBounds[net.getPlaces()[place].name] = bounds[place];
+		}
+	}
+	return placeBounds;
+}
+
+//!
+//! \brief Whether the support of an invariant contains any of the given places or transitions.
+//! \param invariant - The invariant.
+//! \param excluded - Whether each place or transition is excluded.
+//! \return true if the invariant involves an excluded place or transition.
+//!
+bool involvesAny(const FarkasSolver::SparseVector &invariant, const vector<bool> &excluded)
+{
+	return ranges::any_of(invariant, [&excluded](const auto &entry) { return excluded[entry.first]; });
+}
+
+InvariantsResult computeNetInvariants(const CompiledNet &net, const InvariantsOptions &options)
+{
+	InvariantsResult result;
+	const size_t numberOfPlaces = net.getPlaces().size();
+	const vector<FarkasSolver::SparseVector> transitionEffects = getTransitionEffects(net);
+
+	// The incidence matrix does not describe resets, so the invariants involving them do not hold.
+	vector<bool> resetPlaces(numberOfPlaces, false);
+	vector<bool> resettingTransitions(net.getTransitions().size(), false);
+	for (size_t transition = 0; transition < net.getTransitions().size(); ++transition)
+	{
+		for (const size_t place : net.getTransitions()[transition].resetPlaces)
+		{
+			resetPlaces[place] = true;
+			resettingTransitions[transition] = true;
+		}
+	}
+
+	if (options.computePlaceInvariants)
+	{
+		FarkasSolver solver(transpose(transitionEffects, numberOfPlaces), transitionEffects.size(), options.maxRows);
+		vector<FarkasSolver::SparseVector> placeInvariants = solver.solve();
+		erase_if(placeInvariants, [&resetPlaces](const auto &invariant) { return involvesAny(invariant, resetPlaces); });
+		result.complete = solver.isComplete();
+		for (const FarkasSolver::SparseVector &placeInvariant : placeInvariants)
+		{
+			map<string, size_t> &invariant = result.placeInvariants.emplace_back();
+			for (const auto &[place, weight] : placeInvariant)
+			{
+				invariant[net.getPlaces()[place].name] = static_cast<size_t>(weight);
+			}
+		}
+		result.placeBounds = getPlaceBounds(net, placeInvariants);
+	}
+
+	if (options.computeTransitionInvariants)
+	{
+		FarkasSolver solver(transitionEffects, numberOfPlaces, options.maxRows);
+		vector<FarkasSolver::SparseVector> transitionInvariants = solver.solve();
+		erase_if(transitionInvariants,
+				 [&resettingTransitions](const auto &invariant) { return involvesAny(invariant, resettingTransitions); });
+		for (const FarkasSolver::SparseVector &transitionInvariant : transitionInvariants)
+		{
+			map<string, size_t> &invariant = result.transitionInvariants.emplace_back();
+			for (const auto &[transition, count] : transitionInvariant)
+			{
+				invariant[net.getTransitions()[transition].name] = static_cast<size_t>(count);
+			}
+		}
+		result.complete = result.complete && solver.isComplete();
+	}
+	return result;
+}
+
+} // namespace
+
+InvariantsResult computeInvariants(const PTN_Engine &ptnEngine, const InvariantsOptions &options)
+{
+	const CompiledNet net(ptnEngine);
+	return computeNetInvariants(net, options);
+}
+
+InvariantsResult computeInvariants(const vector<PlaceProperties> &placesProperties,
+								   const vector<TransitionProperties> &transitionsProperties,
+								   const InvariantsOptions &options)
+{
+	const CompiledNet net(placesProperties, transitionsProperties);
+	return computeNetInvariants(net, options);
+}
+
+} // namespace ptne
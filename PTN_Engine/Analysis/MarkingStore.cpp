@@ -0,0 +1,265 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/MarkingStore.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! The slots keep the highest bits of the hash as a tag, to skip most mismatching markings without reading them.
+constexpr uint64_t tagMask = 0xFFFF000000000000ULL;
+
+//! Maximum number of bytes of a variable length integer.
+constexpr size_t maxVarintSize = 10;
+
+void encodeVarint(uint64_t value, vector<uint8_t> &buffer)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<uint8_t>(value));
+}
+
+uint8_t *writeVarint(uint64_t value, uint8_t *position)
+{
+	while (value >= 0x80)
+	{
+		*position++ = static_cast<uint8_t>(value | 0x80);
+		value >>= 7;
+	}
+	*position++ = static_cast<uint8_t>(value);
+	return position;
+}
+
+uint64_t decodeVarint(const uint8_t *&position)
+{
+	uint64_t value = 0;
+	for (size_t shift = 0;; shift += 7)
+	{
+		const uint8_t byte = *position++;
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return value;
+		}
+	}
+}
+
+size_t getVarintSize(uint64_t value)
+{
+	size_t size = 1;
+	while (value >= 0x80)
+	{
+		value >>= 7;
+		++size;
+	}
+	return size;
+}
+
+uint64_t hashBytes(const vector<uint8_t> &bytes)
+{
+	// FNV-1a followed by the splitmix64 finalizer, so that the low bits used as index and the high bits used as
+	// tag are both well mixed.
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (const uint8_t byte : bytes)
+	{
+		hash = (hash ^ byte) * 0x100000001B3ULL;
+	}
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+	return hash ^ (hash >> 31);
+}
+
+} // namespace
+
+void MarkingStore::FreeDeleter::operator()(uint64_t *slots) const
+{
+	free(slots);
+}
+
+MarkingStore::~MarkingStore()
+{
+	const size_t numberOfChunks = min(m_nextChunk.load(), m_maxChunks);
+	for (size_t i = 0; i < numberOfChunks; ++i)
+	{
+		delete[] m_chunks[i].load();
+	}
+}
+
+MarkingStore::MarkingStore(const size_t numberOfPlaces, const size_t memoryLimit, const size_t maxSize)
+: m_numberOfPlaces(numberOfPlaces)
+{
+	// A quarter of the memory goes to the hash table, the rest to the chunks.
+	m_numberOfSlots = bit_floor(memoryLimit / 4 / sizeof(uint64_t));
+	const size_t maxRecordSize = maxVarintSize * (numberOfPlaces + 1);
+	const size_t chunkSize = max(bit_ceil(maxRecordSize), min<size_t>(1 << 20, bit_floor(memoryLimit / 64)));
+	m_chunkShift = static_cast<size_t>(countr_zero(chunkSize));
+
+	// References, plus one, must fit below the tag.
+	m_maxChunks = min((memoryLimit - m_numberOfSlots * sizeof(uint64_t)) / chunkSize,
+					  (size_t{ 1 } << (countr_zero(tagMask) - m_chunkShift)) - 1);
+	if (m_numberOfSlots < 2 || m_maxChunks == 0)
+	{
+		throw PTN_Exception("The memory limit is too small to store a marking.");
+	}
+	m_maxSize = min(maxSize, m_numberOfSlots / 4 * 3);
+
+	m_slots.reset(static_cast<uint64_t *>(calloc(m_numberOfSlots, sizeof(uint64_t))));
+	if (m_slots == nullptr)
+	{
+		throw bad_alloc();
+	}
+	m_chunks = make_unique<atomic<uint8_t *>[]>(m_maxChunks);
+}
+
+MarkingStore::InsertStatus
+MarkingStore::insert(const CompiledNet::Marking &marking, Writer &writer, Reference &reference)
+{
+	vector<uint8_t> &buffer = writer.m_buffer;
+	buffer.clear();
+	for (const size_t numberOfTokens : marking)
+	{
+		encodeVarint(numberOfTokens, buffer);
+	}
+	const uint64_t hash = hashBytes(buffer);
+	const uint64_t tag = hash & tagMask;
+	const size_t recordSize = getVarintSize(buffer.size()) + buffer.size();
+
+	// The record is written before trying to claim a free slot, and given back if the marking turns out to be
+	// stored by another thread meanwhile.
+	uint64_t value = 0;
+	Reference newReference = 0;
+	auto releaseRecord = [&]
+	{
+		if (value != 0)
+		{
+			m_size.fetch_sub(1, memory_order_relaxed);
+			writer.m_offset -= recordSize;
+			writer.m_available += recordSize;
+		}
+	};
+
+	size_t index = hash & (m_numberOfSlots - 1);
+	for (size_t probes = 0; probes < m_numberOfSlots;)
+	{
+		atomic_ref<uint64_t> slot(m_slots[index]);
+		uint64_t current = slot.load(memory_order_acquire);
+		if (current == 0)
+		{
+			if (value == 0)
+			{
+				// The marking is counted before it is published, so that the maximum size is never exceeded.
+				if (m_size.fetch_add(1, memory_order_relaxed) >= m_maxSize)
+				{
+					m_size.fetch_sub(1, memory_order_relaxed);
+					return InsertStatus::FULL;
+				}
+				uint8_t *record = allocate(recordSize, writer, newReference);
+				if (record == nullptr)
+				{
+					m_size.fetch_sub(1, memory_order_relaxed);
+					return InsertStatus::FULL;
+				}
+				memcpy(writeVarint(buffer.size(), record), buffer.data(), buffer.size());
+				value = tag | (newReference + 1);
+			}
+			if (slot.compare_exchange_strong(current, value, memory_order_release, memory_order_acquire))
+			{
+				reference = newReference;
+				return InsertStatus::INSERTED;
+			}
+		}
+
+		if ((current & tagMask) == tag)
+		{
+			const Reference storedReference = (current & ~tagMask) - 1;
+			const uint8_t *record = getRecord(storedReference);
+			if (decodeVarint(record) == buffer.size() && memcmp(record, buffer.data(), buffer.size()) == 0)
+			{
+				releaseRecord();
+				reference = storedReference;
+				return InsertStatus::ALREADY_STORED;
+			}
+		}
+		index = (index + 1) & (m_numberOfSlots - 1);
+		++probes;
+	}
+
+	releaseRecord();
+	return InsertStatus::FULL;
+}
+
+void MarkingStore::get(const Reference reference, CompiledNet::Marking &marking) const
+{
+	const uint8_t *position = getRecord(reference);
+	decodeVarint(position);
+	marking.resize(m_numberOfPlaces);
+	for (size_t &numberOfTokens : marking)
+	{
+		numberOfTokens = static_cast<size_t>(decodeVarint(position));
+	}
+}
+
+size_t MarkingStore::size() const
+{
+	return m_size.load(memory_order_relaxed);
+}
+
+const uint8_t *MarkingStore::getRecord(const Reference reference) const
+{
+	const size_t chunk = reference >> m_chunkShift;
+	const size_t offset = reference & ((size_t{ 1 } << m_chunkShift) - 1);
+	return m_chunks[chunk].load(memory_order_acquire) + offset;
+}
+
+uint8_t *MarkingStore::allocate(const size_t size, Writer &writer, Reference &reference)
+{
+	if (writer.m_available < size)
+	{
+		const size_t chunk = m_nextChunk.fetch_add(1, memory_order_relaxed);
+		if (chunk >= m_maxChunks)
+		{
+			return nullptr;
+		}
+		const size_t chunkSize = size_t{ 1 } << m_chunkShift;
+		m_chunks[chunk].store(new uint8_t[chunkSize], memory_order_release);
+		writer.m_chunk = chunk;
+		writer.m_offset = 0;
+		writer.m_available = chunkSize;
+	}
+
+	reference = (writer.m_chunk << m_chunkShift) | writer.m_offset;
+	uint8_t *record = m_chunks[writer.m_chunk].load(memory_order_relaxed) + writer.m_offset;
+	writer.m_offset += size;
+	writer.m_available -= size;
+	return record;
+}
+
+} // namespace ptne
@@ -0,0 +1,167 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Concurrent set of markings, stored compressed within a memory limit.
+//!
+//! Markings are encoded as variable length integers and appended to chunks of memory, which each thread fills
+//! on its own. An open addressing hash table of fixed size indexes them. Insertions and lookups are lock-free.
+//! Markings are never removed.
+//!
+class MarkingStore final
+{
+public:
+	//! Identifies a stored marking.
+	using Reference = uint64_t;
+
+	//! Outcome of an insertion.
+	enum class InsertStatus
+	{
+		INSERTED,
+		ALREADY_STORED,
+		FULL
+	};
+
+	//!
+	//! \brief Per thread state of the insertions: the chunk being filled and a buffer for the encoding.
+	//!
+	class Writer final
+	{
+	public:
+		Writer() = default;
+
+	private:
+		friend class MarkingStore;
+
+		//! Index of the chunk being filled, if any.
+		size_t m_chunk = 0;
+
+		//! Position of the next record in the chunk.
+		size_t m_offset = 0;
+
+		//! Free bytes in the chunk.
+		size_t m_available = 0;
+
+		//! Encoding of the marking being inserted.
+		std::vector<uint8_t> m_buffer;
+	};
+
+	~MarkingStore();
+
+	//!
+	//! \brief MarkingStore constructor. Throws PTN_Exception if the memory limit cannot hold a single marking.
+	//! \param numberOfPlaces - Number of places of the markings.
+	//! \param memoryLimit - Maximum number of bytes used by the hash table and the markings.
+	//! \param maxSize - Maximum number of markings.
+	//!
+	MarkingStore(const size_t numberOfPlaces,
+				 const size_t memoryLimit,
+				 const size_t maxSize = std::numeric_limits<size_t>::max());
+
+	MarkingStore(const MarkingStore &) = delete;
+	MarkingStore(MarkingStore &&) = delete;
+	MarkingStore &operator=(const MarkingStore &) = delete;
+	MarkingStore &operator=(MarkingStore &&) = delete;
+
+	//!
+	//! \brief Insert a marking, if it is not stored yet.
+	//! \param marking - The marking.
+	//! \param writer - State of the calling thread.
+	//! \param reference - Receives the reference to the stored marking, unless the store is full.
+	//! \return Whether the marking was inserted, was already stored, or could not be stored.
+	//!
+	InsertStatus insert(const CompiledNet::Marking &marking, Writer &writer, Reference &reference);
+
+	//!
+	//! \brief Get a stored marking.
+	//! \param reference - Reference to the marking.
+	//! \param marking - Receives the marking.
+	//!
+	void get(const Reference reference, CompiledNet::Marking &marking) const;
+
+	//!
+	//! \brief Get the number of stored markings.
+	//! \return The number of stored markings.
+	//!
+	size_t size() const;
+
+private:
+	//! Frees the memory of the hash table.
+	struct FreeDeleter
+	{
+		void operator()(uint64_t *slots) const;
+	};
+
+	//!
+	//! \brief Get the record of a stored marking.
+	//! \param reference - Reference to the marking.
+	//! \return Pointer to the record, which starts with its length.
+	//!
+	const uint8_t *getRecord(const Reference reference) const;
+
+	//!
+	//! \brief Reserve space for a record in the chunk of a writer, taking a new chunk if needed.
+	//! \param size - Size of the record.
+	//! \param writer - State of the calling thread.
+	//! \param reference - Receives the reference to the record.
+	//! \return Pointer to the reserved space, or null if the memory limit was reached.
+	//!
+	uint8_t *allocate(const size_t size, Writer &writer, Reference &reference);
+
+	//! Number of places of the markings.
+	const size_t m_numberOfPlaces;
+
+	//! Number of bits of the offset of a record within its chunk.
+	size_t m_chunkShift = 0;
+
+	//! Maximum number of chunks within the memory limit.
+	size_t m_maxChunks = 0;
+
+	//! Maximum number of markings, also limited to keep the hash table load low enough for short probe sequences.
+	size_t m_maxSize = 0;
+
+	//! Hash table slots, each holding a tag of the hash and the reference of a marking plus one, or zero if free.
+	//! Allocated zeroed, so the operating system only commits the pages that are used.
+	std::unique_ptr<uint64_t[], FreeDeleter> m_slots;
+
+	//! Number of slots, a power of two.
+	size_t m_numberOfSlots = 0;
+
+	//! Memory of the chunks, published to the other threads before any of their records.
+	std::unique_ptr<std::atomic<uint8_t *>[]> m_chunks;
+
+	//! Index of the next chunk to be allocated.
+	std::atomic<size_t> m_nextChunk = 0;
+
+	//! Number of stored markings.
+	std::atomic<size_t> m_size = 0;
+};
+
+} // namespace ptne
@@ -0,0 +1,341 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/MonteCarlo.h"
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include "PTN_Engine/Analysis/TokenGame.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! Replications are distributed to the threads, and their statistics summed, in blocks of consecutive indexes.
+//! Summing the blocks in order makes the floating point results independent of the number of threads.
+constexpr size_t replicationsPerBlock = 64;
+
+//!
+//! \brief Derive the seed of a replication, so that close indexes get unrelated seeds.
+//! \param seed - Seed of the analysis.
+//! \param replication - Index of the replication.
+//! \return Seed of the replication.
+//!
+uint64_t getReplicationSeed(const uint64_t seed, const uint64_t replication)
+{
+	// splitmix64 finalizer.
+	uint64_t z = seed + (replication + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+//! Statistics summed over a number of replications.
+struct Statistics
+{
+	Statistics(const size_t numberOfPlaces, const size_t numberOfTransitions, const size_t numberOfTargets)
+	: firings(numberOfTransitions, 0)
+	, occupancy(numberOfPlaces, 0)
+	, maxTokens(numberOfPlaces, 0)
+	, targetsReached(numberOfTargets, 0)
+	, timeToReach(numberOfTargets, 0)
+	, firingsToReach(numberOfTargets, 0)
+	{
+	}
+
+	void add(const Statistics &other)
+	{
+		ranges::transform(firings, other.firings, firings.begin(), plus<>{});
+		ranges::transform(occupancy, other.occupancy, occupancy.begin(), plus<>{});
+		ranges::transform(maxTokens, other.maxTokens, maxTokens.begin(),
+						  [](const size_t a, const size_t b) { return max(a, b); });
+		ranges::transform(targetsReached, other.targetsReached, targetsReached.begin(), plus<>{});
+		ranges::transform(timeToReach, other.timeToReach, timeToReach.begin(), plus<>{});
+		ranges::transform(firingsToReach, other.firingsToReach, firingsToReach.begin(), plus<>{});
+		endTime += other.endTime;
+	}
+
+	vector<size_t> firings;
+	vector<double> occupancy;
+	vector<size_t> maxTokens;
+	vector<size_t> targetsReached;
+	vector<double> timeToReach;
+	vector<size_t> firingsToReach;
+	double endTime = 0;
+};
+
+//!
+//! \brief Runs replications in one thread, reusing its memory between them.
+//!
+class ReplicationRunner final
+{
+public:
+	ReplicationRunner(const CompiledNet &net,
+					  const vector<CompiledNet::PartialMarking> &targetMarkings,
+					  const MonteCarloOptions &options)
+	: m_net(net)
+	, m_targetMarkings(targetMarkings)
+	, m_options(options)
+	, m_tokenGame(net, options.delays)
+	, m_tokens(net.getPlaces().size())
+	, m_lastChangeTime(net.getPlaces().size())
+	, m_lastChangeStep(net.getPlaces().size())
+	, m_timeIntegral(net.getPlaces().size())
+	, m_stepIntegral(net.getPlaces().size())
+	, m_reached(targetMarkings.size())
+	{
+	}
+
+	ReplicationRunner(const ReplicationRunner &) = delete;
+	ReplicationRunner(ReplicationRunner &&) = delete;
+	ReplicationRunner &operator=(const ReplicationRunner &) = delete;
+	ReplicationRunner &operator=(ReplicationRunner &&) = delete;
+
+	//!
+	//! \brief Run a replication and add its statistics.
+	//! \param seed - Seed of the replication.
+	//! \param statistics - Statistics to be added to.
+	//!
+	void run(const uint64_t seed, Statistics &statistics)
+	{
+		m_tokenGame.start(seed);
+		const CompiledNet::Marking &marking = m_tokenGame.getMarking();
+		ranges::copy(marking, m_tokens.begin());
+		ranges::fill(m_lastChangeTime, 0);
+		ranges::fill(m_lastChangeStep, 0);
+		ranges::fill(m_timeIntegral, 0);
+		ranges::fill(m_stepIntegral, 0);
+		fill(m_reached.begin(), m_reached.end(), false);
+		ranges::transform(statistics.maxTokens, marking, statistics.maxTokens.begin(),
+						  [](const size_t a, const size_t b) { return max(a, b); });
+		checkTargetMarkings(0, statistics);
+
+		size_t firings = 0;
+		while (firings < m_options.maxFirings)
+		{
+			const auto transition = m_tokenGame.fireNext(m_options.duration);
+			if (!transition.has_value())
+			{
+				break;
+			}
+			++firings;
+			++statistics.firings[*transition];
+
+			// Only the places of the fired transition can have changed.
+			const double now = m_tokenGame.getTime().count();
+			const CompiledNet::Transition &firedTransition = m_net.getTransitions()[*transition];
+			auto updatePlace = [&](const size_t place)
+			{
+				if (marking[place] != m_tokens[place])
+				{
+					integrate(place, now, firings);
+					m_tokens[place] = marking[place];
+					statistics.maxTokens[place] = max(statistics.maxTokens[place], marking[place]);
+				}
+			};
+			for (const auto *arcs : { &firedTransition.activationArcs, &firedTransition.destinationArcs })
+			{
+				for (const CompiledNet::Arc &arc : *arcs)
+				{
+					updatePlace(arc.place);
+				}
+			}
+			ranges::for_each(firedTransition.resetPlaces, updatePlace);
+			checkTargetMarkings(firings, statistics);
+		}
+
+		// A replication without scheduled firings stays in its final marking until the end of the duration.
+		double endTime = m_tokenGame.getTime().count();
+		if (firings < m_options.maxFirings && m_options.duration != SimulationTime::max())
+		{
+			endTime = m_options.duration.count();
+		}
+
+		// Each visited marking counts as one step, the initial marking included.
+		for (size_t place = 0; place < m_tokens.size(); ++place)
+		{
+			integrate(place, endTime, firings + 1);
+			statistics.occupancy[place] +=
+			endTime > 0 ? m_timeIntegral[place] / endTime : m_stepIntegral[place] / static_cast<double>(firings + 1);
+		}
+		statistics.endTime += endTime;
+	}
+
+private:
+	//!
+	//! \brief Add the tokens of a place since its last change to the integrals of the occupancy.
+	//! \param place - Index of the place.
+	//! \param time - Current virtual time.
+	//! \param step - Current step.
+	//!
+	void integrate(const size_t place, const double time, const size_t step)
+	{
+		const auto tokens = static_cast<double>(m_tokens[place]);
+		m_timeIntegral[place] += tokens * (time - m_lastChangeTime[place]);
+		m_stepIntegral[place] += tokens * static_cast<double>(step - m_lastChangeStep[place]);
+		m_lastChangeTime[place] = time;
+		m_lastChangeStep[place] = step;
+	}
+
+	//!
+	//! \brief Record the target markings reached for the first time.
+	//! \param firings - Number of firings so far.
+	//! \param statistics - Statistics to be added to.
+	//!
+	void checkTargetMarkings(const size_t firings, Statistics &statistics)
+	{
+		const CompiledNet::Marking &marking = m_tokenGame.getMarking();
+		for (size_t i = 0; i < m_targetMarkings.size(); ++i)
+		{
+			if (m_reached[i] ||
+				!ranges::all_of(m_targetMarkings[i], [&marking](const auto &placeTokens)
+								{ return marking[placeTokens.first] == placeTokens.second; }))
+			{
+				continue;
+			}
+			m_reached[i] = true;
+			++statistics.targetsReached[i];
+			statistics.timeToReach[i] += m_tokenGame.getTime().count();
+			statistics.firingsToReach[i] += firings;
+		}
+	}
+
+	const CompiledNet &m_net;
+	const vector<CompiledNet::PartialMarking> &m_targetMarkings;
+	const MonteCarloOptions &m_options;
+	TokenGame m_tokenGame;
+
+	//! Number of tokens of each place at its last change.
+	vector<size_t> m_tokens;
+
+	//! Virtual time of the last change of each place.
+	vector<double> m_lastChangeTime;
+
+	//! Step of the last change of each place.
+	vector<size_t> m_lastChangeStep;
+
+	//! Number of tokens of each place integrated over virtual time.
+	vector<double> m_timeIntegral;
+
+	//! Number of tokens of each place summed over the visited markings.
+	vector<double> m_stepIntegral;
+
+	//! Whether each target marking was reached in the current replication.
+	vector<bool> m_reached;
+};
+
+MonteCarloResult runReplications(const CompiledNet &net, const MonteCarloOptions &options)
+{
+	vector<CompiledNet::PartialMarking> targetMarkings;
+	for (const auto &targetMarking : options.targetMarkings)
+	{
+		targetMarkings.push_back(net.toPartialMarking(targetMarking));
+	}
+
+	const size_t numberOfPlaces = net.getPlaces().size();
+	const size_t numberOfTransitions = net.getTransitions().size();
+	const size_t numberOfBlocks = (options.replications + replicationsPerBlock - 1) / replicationsPerBlock;
+	vector<Statistics> blockStatistics(numberOfBlocks,
+									   Statistics(numberOfPlaces, numberOfTransitions, targetMarkings.size()));
+
+	atomic<size_t> nextBlock = 0;
+	auto work = [&]
+	{
+		ReplicationRunner runner(net, targetMarkings, options);
+		for (size_t block = nextBlock++; block < numberOfBlocks; block = nextBlock++)
+		{
+			const size_t end = min(options.replications, (block + 1) * replicationsPerBlock);
+			for (size_t replication = block * replicationsPerBlock; replication < end; ++replication)
+			{
+				runner.run(getReplicationSeed(options.seed, replication), blockStatistics[block]);
+			}
+		}
+	};
+
+	size_t numberOfThreads = options.numberOfThreads != 0 ? options.numberOfThreads : thread::hardware_concurrency();
+	numberOfThreads = clamp<size_t>(numberOfThreads, 1, max<size_t>(numberOfBlocks, 1));
+	{
+		vector<jthread> workers;
+		for (size_t i = 1; i < numberOfThreads; ++i)
+		{
+			workers.emplace_back(work);
+		}
+		work();
+	}
+
+	Statistics statistics(numberOfPlaces, numberOfTransitions, targetMarkings.size());
+	for (const Statistics &block : blockStatistics)
+	{
+		statistics.add(block);
+	}
+
+	MonteCarloResult result;
+	result.replications = options.replications;
+	if (options.replications == 0)
+	{
+		return result;
+	}
+
+	const auto replications = static_cast<double>(options.replications);
+	for (size_t i = 0; i < numberOfTransitions; ++i)
+	{
+		result.meanFiringsPerTransition[net.getTransitions()[i].name] =
+		static_cast<double>(statistics.firings[i]) / replications;
+	}
+	for (size_t i = 0; i < numberOfPlaces; ++i)
+	{
+		result.places[net.getPlaces()[i].name] =
+		PlaceStatistics{ .meanOccupancy = statistics.occupancy[i] / replications, .maxTokens = statistics.maxTokens[i] };
+	}
+	for (size_t i = 0; i < targetMarkings.size(); ++i)
+	{
+		TargetMarkingStatistics &targetMarkingStatistics = result.targetMarkings.emplace_back();
+		targetMarkingStatistics.replicationsReached = statistics.targetsReached[i];
+		if (statistics.targetsReached[i] > 0)
+		{
+			const auto reached = static_cast<double>(statistics.targetsReached[i]);
+			targetMarkingStatistics.meanTimeToReach = SimulationTime(statistics.timeToReach[i] / reached);
+			targetMarkingStatistics.meanFiringsToReach = static_cast<double>(statistics.firingsToReach[i]) / reached;
+		}
+	}
+	result.meanEndTime = SimulationTime(statistics.endTime / replications);
+	return result;
+}
+
+} // namespace
+
+MonteCarloResult runMonteCarlo(const PTN_Engine &ptnEngine, const MonteCarloOptions &options)
+{
+	const CompiledNet net(ptnEngine);
+	return runReplications(net, options);
+}
+
+MonteCarloResult runMonteCarlo(const vector<PlaceProperties> &placesProperties,
+							   const vector<TransitionProperties> &transitionsProperties,
+							   const MonteCarloOptions &options)
+{
+	const CompiledNet net(placesProperties, transitionsProperties);
+	return runReplications(net, options);
+}
+
+} // namespace ptne
@@ -0,0 +1,291 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/Reachability.h"
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include "PTN_Engine/Analysis/MarkingStore.h"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <mutex>
+#include <thread>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! Number of markings a thread takes from the frontier at once.
+constexpr size_t markingsPerBatch = 64;
+
+//!
+//! \brief Breadth first exploration of the reachable markings, one level of the frontier at a time. The threads
+//! share the frontier of the current level and each collects the new markings of the next level.
+//!
+class ReachabilityExplorer final
+{
+public:
+	ReachabilityExplorer(const CompiledNet &net, const ReachabilityOptions &options)
+	: m_net(net)
+	, m_options(options)
+	, m_store(net.getPlaces().size(), options.memoryLimit, options.maxMarkings)
+	{
+	}
+
+	ReachabilityExplorer(const ReachabilityExplorer &) = delete;
+	ReachabilityExplorer(ReachabilityExplorer &&) = delete;
+	ReachabilityExplorer &operator=(const ReachabilityExplorer &) = delete;
+	ReachabilityExplorer &operator=(ReachabilityExplorer &&) = delete;
+
+	ReachabilityResult run()
+	{
+		size_t numberOfThreads =
+		m_options.numberOfThreads != 0 ? m_options.numberOfThreads : thread::hardware_concurrency();
+		numberOfThreads = max<size_t>(numberOfThreads, 1);
+
+		vector<Worker> workers(numberOfThreads);
+		for (Worker &worker : workers)
+		{
+			worker.placeBounds.resize(m_net.getPlaces().size(), 0);
+			worker.enabledTransitions.resize(m_net.getTransitions().size(), false);
+		}
+		m_current.resize(numberOfThreads);
+		m_next.resize(numberOfThreads);
+		m_offsets.resize(numberOfThreads + 1, 0);
+
+		MarkingStore::Reference initialMarking = 0;
+		if (m_store.insert(m_net.getInitialMarking(), workers.front().writer, initialMarking) ==
+			MarkingStore::InsertStatus::FULL)
+		{
+			m_stop = true;
+		}
+		else
+		{
+			m_next.front().push_back(initialMarking);
+		}
+		nextLevel();
+
+		barrier levelCompleted(static_cast<ptrdiff_t>(numberOfThreads), LevelCompletion{ this });
+		{
+			vector<jthread> threads;
+			for (size_t i = 1; i < numberOfThreads; ++i)
+			{
+				threads.emplace_back([this, &worker = workers[i], &levelCompleted, i]
+									 { explore(i, worker, levelCompleted); });
+			}
+			explore(0, workers.front(), levelCompleted);
+		}
+
+		ReachabilityResult result;
+		result.complete = !m_stop;
+		result.numberOfMarkings = m_store.size();
+		result.deadlocks = std::move(m_deadlocks);
+		vector<size_t> placeBounds(m_net.getPlaces().size(), 0);
+		vector<bool> enabledTransitions(m_net.getTransitions().size(), false);
+		for (const Worker &worker : workers)
+		{
+			result.numberOfEdges += worker.numberOfEdges;
+			result.numberOfDeadlocks += worker.numberOfDeadlocks;
+			ranges::transform(placeBounds, worker.placeBounds, placeBounds.begin(),
+							  [](const size_t a, const size_t b) { return max(a, b); });
+			for (size_t i = 0; i < enabledTransitions.size(); ++i)
+			{
+				enabledTransitions[i] = enabledTransitions[i] || worker.enabledTransitions[i];
+			}
+		}
+		for (size_t i = 0; i < enabledTransitions.size(); ++i)
+		{
+			if (!enabledTransitions[i])
+			{
+				result.deadTransitions.push_back(m_net.getTransitions()[i].name);
+			}
+		}
+		for (size_t i = 0; i < placeBounds.size(); ++i)
+		{
+			result.placeBounds[m_net.getPlaces()[i].name] = placeBounds[i];
+		}
+		return result;
+	}
+
+private:
+	//! State and partial results of an exploring thread.
+	struct Worker
+	{
+		MarkingStore::Writer writer;
+		CompiledNet::Marking marking;
+		CompiledNet::Marking successor;
+		vector<size_t> placeBounds;
+		vector<bool> enabledTransitions;
+		size_t numberOfEdges = 0;
+		size_t numberOfDeadlocks = 0;
+	};
+
+	//! Prepares the next level once all threads completed the current one.
+	struct LevelCompletion
+	{
+		ReachabilityExplorer *explorer = nullptr;
+
+		void operator()() noexcept
+		{
+			explorer->nextLevel();
+		}
+	};
+
+	//!
+	//! \brief Make the markings found in the current level the new frontier. Runs while no thread explores.
+	//!
+	void nextLevel() noexcept
+	{
+		swap(m_current, m_next);
+		for (auto &markings : m_next)
+		{
+			markings.clear();
+		}
+		for (size_t i = 0; i < m_current.size(); ++i)
+		{
+			m_offsets[i + 1] = m_offsets[i] + m_current[i].size();
+		}
+		m_nextIndex.store(0, memory_order_relaxed);
+		m_done = m_offsets.back() == 0 || m_stop;
+	}
+
+	//!
+	//! \brief Thread function, explores the frontier level by level.
+	//! \param thread - Index of the thread.
+	//! \param worker - State of the thread.
+	//! \param levelCompleted - Synchronizes the threads at the end of each level.
+	//!
+	void explore(const size_t thread, Worker &worker, barrier<LevelCompletion> &levelCompleted)
+	{
+		while (!m_done)
+		{
+			const size_t frontierSize = m_offsets.back();
+			for (size_t begin = m_nextIndex.fetch_add(markingsPerBatch, memory_order_relaxed);
+				 begin < frontierSize && !m_stop.load(memory_order_relaxed);
+				 begin = m_nextIndex.fetch_add(markingsPerBatch, memory_order_relaxed))
+			{
+				const size_t end = min(begin + markingsPerBatch, frontierSize);
+				for (size_t index = begin; index < end; ++index)
+				{
+					const size_t segment = static_cast<size_t>(ranges::upper_bound(m_offsets, index) - m_offsets.begin()) - 1;
+					expand(m_current[segment][index - m_offsets[segment]], worker, m_next[thread]);
+				}
+			}
+			levelCompleted.arrive_and_wait();
+		}
+	}
+
+	//!
+	//! \brief Fire each enabled transition of a marking, and store the new markings.
+	//! \param reference - The marking.
+	//! \param worker - State of the thread.
+	//! \param next - Receives the new markings.
+	//!
+	void expand(const MarkingStore::Reference reference, Worker &worker, vector<MarkingStore::Reference> &next)
+	{
+		m_store.get(reference, worker.marking);
+		ranges::transform(worker.placeBounds, worker.marking, worker.placeBounds.begin(),
+						  [](const size_t a, const size_t b) { return max(a, b); });
+
+		bool isDeadlock = true;
+		for (size_t transition = 0; transition < m_net.getTransitions().size(); ++transition)
+		{
+			if (!m_net.isEnabled(transition, worker.marking))
+			{
+				continue;
+			}
+			isDeadlock = false;
+			worker.enabledTransitions[transition] = true;
+			++worker.numberOfEdges;
+
+			worker.successor = worker.marking;
+			m_net.fire(transition, worker.successor);
+			MarkingStore::Reference successor = 0;
+			const auto status = m_store.insert(worker.successor, worker.writer, successor);
+			if (status == MarkingStore::InsertStatus::INSERTED)
+			{
+				next.push_back(successor);
+			}
+			else if (status == MarkingStore::InsertStatus::FULL)
+			{
+				m_stop = true;
+				return;
+			}
+		}
+
+		if (isDeadlock)
+		{
+			++worker.numberOfDeadlocks;
+			unique_lock guard(m_deadlocksMutex);
+			if (m_deadlocks.size() < m_options.maxReportedDeadlocks)
+			{
+				m_deadlocks.push_back(m_net.toNamedMarking(worker.marking));
+			}
+		}
+	}
+
+	const CompiledNet &m_net;
+	const ReachabilityOptions &m_options;
+
+	//! The markings found so far.
+	MarkingStore m_store;
+
+	//! Markings of the current level, as found by each thread in the previous level.
+	vector<vector<MarkingStore::Reference>> m_current;
+
+	//! Markings of the next level, found by each thread.
+	vector<vector<MarkingStore::Reference>> m_next;
+
+	//! Position of the markings of each thread in the current level, followed by the size of the level.
+	vector<size_t> m_offsets;
+
+	//! Position of the next marking of the current level to be expanded.
+	atomic<size_t> m_nextIndex = 0;
+
+	//! Set when the store is full.
+	atomic<bool> m_stop = false;
+
+	//! Set when the exploration ended. Only changed while no thread explores.
+	bool m_done = false;
+
+	//! Protects m_deadlocks.
+	mutex m_deadlocksMutex;
+
+	//! Deadlock markings to be reported.
+	vector<map<string, size_t>> m_deadlocks;
+};
+
+} // namespace
+
+ReachabilityResult exploreReachability(const PTN_Engine &ptnEngine, const ReachabilityOptions &options)
+{
+	const CompiledNet net(ptnEngine);
+	return ReachabilityExplorer(net, options).run();
+}
+
+ReachabilityResult exploreReachability(const vector<PlaceProperties> &placesProperties,
+									   const vector<TransitionProperties> &transitionsProperties,
+									   const ReachabilityOptions &options)
+{
+	const CompiledNet net(placesProperties, transitionsProperties);
+	return ReachabilityExplorer(net, options).run();
+}
+
+} // namespace ptne
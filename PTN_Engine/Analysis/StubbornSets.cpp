@@ -0,0 +1,261 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/StubbornSets.h"
+#include <map>
+
+namespace ptne
+{
+using namespace std;
+
+StubbornSets::~StubbornSets() = default;
+
+StubbornSets::StubbornSets(const CompiledNet &net)
+: m_net(net)
+, m_consumers(net.getPlaces().size())
+, m_increasers(net.getPlaces().size())
+, m_decreasers(net.getPlaces().size())
+, m_inhibited(net.getPlaces().size())
+, m_resetters(net.getPlaces().size())
+, m_readers(net.getPlaces().size())
+, m_limited(net.getPlaces().size())
+, m_increasedPlaces(net.getTransitions().size())
+, m_generations(net.getTransitions().size(), 0)
+{
+	for (size_t transition = 0; transition < net.getTransitions().size(); ++transition)
+	{
+		const CompiledNet::Transition &compiledTransition = net.getTransitions()[transition];
+
+		// Effect of the firing on each place, where weights of arcs in both directions cancel out.
+		map<size_t, ptrdiff_t> effects;
+		for (const CompiledNet::Arc &arc : compiledTransition.activationArcs)
+		{
+			m_consumers[arc.place].push_back(transition);
+			effects[arc.place] -= static_cast<ptrdiff_t>(arc.weight);
+		}
+		for (const CompiledNet::Arc &arc : compiledTransition.destinationArcs)
+		{
+			effects[arc.place] += static_cast<ptrdiff_t>(arc.weight);
+		}
+		for (const size_t place : compiledTransition.inhibitorPlaces)
+		{
+			m_inhibited[place].push_back(transition);
+		}
+		for (const CompiledNet::Arc &arc : compiledTransition.readArcs)
+		{
+			m_readers[arc.place].push_back(transition);
+		}
+		for (const CompiledNet::Arc &arc : compiledTransition.tokenLimits)
+		{
+			m_limited[arc.place].push_back(transition);
+		}
+		// A reset can remove any number of tokens, and disable the transitions consuming from the place.
+		for (const size_t place : compiledTransition.resetPlaces)
+		{
+			m_resetters[place].push_back(transition);
+			m_consumers[place].push_back(transition);
+			if (!effects.contains(place) || effects[place] >= 0)
+			{
+				m_decreasers[place].push_back(transition);
+			}
+		}
+
+		for (const auto &[place, effect] : effects)
+		{
+			if (effect > 0)
+			{
+				m_increasers[place].push_back(transition);
+				m_increasedPlaces[transition].push_back(place);
+			}
+			else if (effect < 0)
+			{
+				m_decreasers[place].push_back(transition);
+			}
+		}
+	}
+}
+
+void StubbornSets::getDeadlockPreservingSet(const CompiledNet::Marking &marking, vector<size_t> &transitions)
+{
+	transitions.clear();
+	for (size_t transition = 0; transition < m_net.getTransitions().size(); ++transition)
+	{
+		if (!m_net.isEnabled(transition, marking))
+		{
+			continue;
+		}
+
+		// Each enabled transition is tried as seed, keeping the set with the fewest enabled transitions.
+		m_seeds.assign(1, transition);
+		close(marking, m_seeds, m_candidate);
+		if (transitions.empty() || m_candidate.size() < transitions.size())
+		{
+			swap(transitions, m_candidate);
+			if (transitions.size() == 1)
+			{
+				return;
+			}
+		}
+	}
+}
+
+void StubbornSets::getReachabilityPreservingSet(const CompiledNet::Marking &marking,
+												const CompiledNet::PartialMarking &target,
+												vector<size_t> &transitions)
+{
+	// Any firing sequence reaching the target contains a transition bringing an unmatched place closer to it.
+	const vector<size_t> *upSet = nullptr;
+	for (const auto &[place, numberOfTokens] : target)
+	{
+		if (marking[place] == numberOfTokens)
+		{
+			continue;
+		}
+		const vector<size_t> &candidate = marking[place] < numberOfTokens ? m_increasers[place] : m_decreasers[place];
+		if (upSet == nullptr || candidate.size() < upSet->size())
+		{
+			upSet = &candidate;
+		}
+	}
+
+	if (upSet == nullptr)
+	{
+		transitions.clear();
+		return;
+	}
+	close(marking, *upSet, transitions);
+}
+
+void StubbornSets::close(const CompiledNet::Marking &marking,
+						 const vector<size_t> &seeds,
+						 vector<size_t> &transitions)
+{
+	++m_generation;
+	m_pending.clear();
+	transitions.clear();
+	add(seeds);
+
+	while (!m_pending.empty())
+	{
+		const size_t transition = m_pending.back();
+		m_pending.pop_back();
+		const CompiledNet::Transition &compiledTransition = m_net.getTransitions()[transition];
+
+		if (m_net.isEnabled(transition, marking))
+		{
+			transitions.push_back(transition);
+			for (const CompiledNet::Arc &arc : compiledTransition.activationArcs)
+			{
+				add(m_consumers[arc.place]);
+				add(m_readers[arc.place]);
+			}
+			for (const size_t place : compiledTransition.inhibitorPlaces)
+			{
+				add(m_increasers[place]);
+			}
+			for (const CompiledNet::Arc &arc : compiledTransition.readArcs)
+			{
+				add(m_decreasers[arc.place]);
+			}
+			for (const CompiledNet::Arc &arc : compiledTransition.tokenLimits)
+			{
+				add(m_increasers[arc.place]);
+			}
+			for (const size_t place : m_increasedPlaces[transition])
+			{
+				add(m_inhibited[place]);
+				add(m_resetters[place]);
+				add(m_limited[place]);
+			}
+			for (const size_t place : compiledTransition.resetPlaces)
+			{
+				add(m_consumers[place]);
+				add(m_increasers[place]);
+				add(m_readers[place]);
+			}
+			continue;
+		}
+
+		// A transition producing more tokens than a capacity can never be enabled by other transitions.
+		if (compiledTransition.exceedsCapacities)
+		{
+			continue;
+		}
+
+		// A disabled transition needs only one of the reasons why it is disabled, the one with fewest transitions.
+		const vector<size_t> *scapegoat = nullptr;
+		auto consider = [&scapegoat](const vector<size_t> &candidate)
+		{
+			if (scapegoat == nullptr || candidate.size() < scapegoat->size())
+			{
+				scapegoat = &candidate;
+			}
+		};
+		for (const CompiledNet::Arc &arc : compiledTransition.activationArcs)
+		{
+			if (marking[arc.place] < arc.weight)
+			{
+				consider(m_increasers[arc.place]);
+			}
+		}
+		for (const size_t place : compiledTransition.inhibitorPlaces)
+		{
+			if (marking[place] > 0)
+			{
+				consider(m_decreasers[place]);
+			}
+		}
+		for (const CompiledNet::Arc &arc : compiledTransition.readArcs)
+		{
+			if (marking[arc.place] < arc.weight)
+			{
+				consider(m_increasers[arc.place]);
+			}
+		}
+		for (const CompiledNet::Arc &arc : compiledTransition.tokenLimits)
+		{
+			if (marking[arc.place] > arc.weight)
+			{
+				consider(m_decreasers[arc.place]);
+			}
+		}
+		if (scapegoat != nullptr)
+		{
+			add(*scapegoat);
+		}
+	}
+}
+
+void StubbornSets::add(const size_t transition)
+{
+	if (m_generations[transition] != m_generation)
+	{
+		m_generations[transition] = m_generation;
+		m_pending.push_back(transition);
+	}
+}
+
+void StubbornSets::add(const vector<size_t> &transitions)
+{
+	for (const size_t transition : transitions)
+	{
+		add(transition);
+	}
+}
+
+} // namespace ptne
@@ -0,0 +1,142 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Computes stubborn sets of the transitions of a net, for partial order reduction.
+//!
+//! A stubborn set of a marking is closed under the following rules. For each enabled transition in the set, the set
+//! contains the transitions consuming from or reading its activation places, the transitions increasing its inhibitor
+//! places, the transitions decreasing its read places and the transitions inhibited by the places it increases, so
+//! that it commutes with any sequence of transitions outside the set. Transitions only reading the same place do not
+//! conflict. Resetting a place counts as consuming from it and decreasing it, and does not commute with the
+//! transitions changing the place, so they are added along with the resetting ones. A destination place with a
+//! capacity limits the number of tokens it can have before the transition fires, like an inhibitor place with a
+//! threshold: the transitions increasing it are added, as are the transitions limited by the places the transition
+//! increases. For each disabled transition in the set, the set contains all the transitions that can remove one
+//! reason why it is disabled: an activation or read place with not enough tokens, or an inhibitor or limited place
+//! with too many tokens.
+//! Firing only the enabled transitions of a stubborn set preserves the deadlocks of the net if the set contains
+//! an enabled transition, and the reachability of a marking if the set contains all the transitions that can
+//! bring one of its places closer to the target.
+//!
+class StubbornSets final
+{
+public:
+	~StubbornSets();
+
+	//!
+	//! \brief StubbornSets constructor.
+	//! \param net - The net. Must outlive this object.
+	//!
+	explicit StubbornSets(const CompiledNet &net);
+
+	StubbornSets(const StubbornSets &) = delete;
+	StubbornSets(StubbornSets &&) = delete;
+	StubbornSets &operator=(const StubbornSets &) = delete;
+	StubbornSets &operator=(StubbornSets &&) = delete;
+
+	//!
+	//! \brief Get the enabled transitions of a stubborn set that preserves the deadlocks.
+	//! \param marking - The marking.
+	//! \param transitions - Receives the transitions to be fired, empty only if the marking is a deadlock.
+	//!
+	void getDeadlockPreservingSet(const CompiledNet::Marking &marking, std::vector<size_t> &transitions);
+
+	//!
+	//! \brief Get the enabled transitions of a stubborn set that preserves the reachability of a target marking.
+	//! \param marking - The marking, which does not match the target.
+	//! \param target - The number of tokens of the places of interest.
+	//! \param transitions - Receives the transitions to be fired, empty if the target is not reachable.
+	//!
+	void getReachabilityPreservingSet(const CompiledNet::Marking &marking,
+									  const CompiledNet::PartialMarking &target,
+									  std::vector<size_t> &transitions);
+
+private:
+	//!
+	//! \brief Close a set of transitions under the stubborn set rules.
+	//! \param marking - The marking.
+	//! \param seeds - Transitions the set must contain.
+	//! \param transitions - Receives the enabled transitions of the set.
+	//!
+	void close(const CompiledNet::Marking &marking, const std::vector<size_t> &seeds, std::vector<size_t> &transitions);
+
+	//!
+	//! \brief Add a transition to the set being closed, if it is not in it yet.
+	//! \param transition - The transition.
+	//!
+	void add(const size_t transition);
+
+	//!
+	//! \brief Add transitions to the set being closed.
+	//! \param transitions - The transitions.
+	//!
+	void add(const std::vector<size_t> &transitions);
+
+	//! The net.
+	const CompiledNet &m_net;
+
+	//! For each place, the transitions with an activation arc from it.
+	std::vector<std::vector<size_t>> m_consumers;
+
+	//! For each place, the transitions that increase its number of tokens.
+	std::vector<std::vector<size_t>> m_increasers;
+
+	//! For each place, the transitions that decrease its number of tokens.
+	std::vector<std::vector<size_t>> m_decreasers;
+
+	//! For each place, the transitions with an inhibitor arc from it.
+	std::vector<std::vector<size_t>> m_inhibited;
+
+	//! For each place, the transitions with a reset arc from it.
+	std::vector<std::vector<size_t>> m_resetters;
+
+	//! For each place, the transitions with a read arc from it.
+	std::vector<std::vector<size_t>> m_readers;
+
+	//! For each place with a capacity, the transitions that can only fire while it has few enough tokens.
+	std::vector<std::vector<size_t>> m_limited;
+
+	//! For each transition, the places whose number of tokens it increases.
+	std::vector<std::vector<size_t>> m_increasedPlaces;
+
+	//! Generation in which each transition was last added to a set, to avoid clearing between sets.
+	std::vector<size_t> m_generations;
+
+	//! Generation of the set being closed.
+	size_t m_generation = 0;
+
+	//! Transitions added to the set and not processed yet.
+	std::vector<size_t> m_pending;
+
+	//! Candidate set, while looking for the smallest one.
+	std::vector<size_t> m_candidate;
+
+	//! Seeds of a set.
+	std::vector<size_t> m_seeds;
+};
+
+} // namespace ptne
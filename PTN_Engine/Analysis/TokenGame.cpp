@@ -0,0 +1,128 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/TokenGame.h"
+#include "PTN_Engine/Simulator.h"
+#include <algorithm>
+#include <functional>
+
+namespace ptne
+{
+using namespace std;
+
+TokenGame::~TokenGame() = default;
+
+TokenGame::TokenGame(const CompiledNet &net, const unordered_map<string, DelayDistribution> &delays)
+: m_net(net)
+, m_scheduled(net.getTransitions().size(), false)
+, m_generations(net.getTransitions().size(), 0)
+{
+	for (const auto &transition : m_net.getTransitions())
+	{
+		const auto it = delays.find(transition.name);
+		m_delays.push_back(it != delays.end() ? it->second :
+												getDefaultDelayDistribution(transition.minimumDelay, transition.maximumDelay));
+	}
+	m_firings.reserve(m_net.getTransitions().size());
+}
+
+void TokenGame::start(const uint64_t seed)
+{
+	m_marking = m_net.getInitialMarking();
+	fill(m_scheduled.begin(), m_scheduled.end(), false);
+	m_firings.clear();
+	m_randomGenerator.seed(seed);
+	m_now = SimulationTime::zero();
+
+	for (size_t i = 0; i < m_scheduled.size(); ++i)
+	{
+		update(i);
+	}
+}
+
+optional<size_t> TokenGame::fireNext(const SimulationTime duration)
+{
+	discardOutdatedFirings();
+	if (m_firings.empty())
+	{
+		return nullopt;
+	}
+
+	if (m_firings.front().time > duration)
+	{
+		m_now = duration;
+		return nullopt;
+	}
+	ranges::pop_heap(m_firings, greater<>{});
+	const ScheduledFiring firing = m_firings.back();
+	m_firings.pop_back();
+	m_now = firing.time;
+	m_scheduled[firing.transition] = false;
+
+	m_net.fire(firing.transition, m_marking);
+	for (const size_t dependentTransition : m_net.getDependentTransitions(firing.transition))
+	{
+		update(dependentTransition);
+	}
+	return firing.transition;
+}
+
+const CompiledNet::Marking &TokenGame::getMarking() const
+{
+	return m_marking;
+}
+
+SimulationTime TokenGame::getTime() const
+{
+	return m_now;
+}
+
+bool TokenGame::isWorkRemaining() const
+{
+	return ranges::find(m_scheduled, true) != m_scheduled.end();
+}
+
+void TokenGame::update(const size_t transition)
+{
+	const bool isEnabled = m_net.isEnabled(transition, m_marking);
+	if (!isEnabled && m_scheduled[transition])
+	{
+		m_scheduled[transition] = false;
+		++m_generations[transition];
+	}
+	else if (isEnabled && !m_scheduled[transition])
+	{
+		m_scheduled[transition] = true;
+		m_firings.push_back(ScheduledFiring{ .time = m_now + sampleDelay(m_delays[transition], m_randomGenerator),
+											 .tieBreaker = m_randomGenerator(),
+											 .transition = transition,
+											 .generation = ++m_generations[transition] });
+		ranges::push_heap(m_firings, greater<>{});
+	}
+}
+
+void TokenGame::discardOutdatedFirings()
+{
+	while (!m_firings.empty() && m_firings.front().generation != m_generations[m_firings.front().transition])
+	{
+		ranges::pop_heap(m_firings, greater<>{});
+		m_firings.pop_back();
+	}
+}
+
+} // namespace ptne
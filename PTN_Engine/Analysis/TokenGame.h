@@ -0,0 +1,144 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Discrete event simulation of the token game of a net, in virtual time.
+//!
+//! Follows the same rules as the Simulator, without the additional conditions and actions, locks or allocations
+//! during the simulation. One instance can run many replications one after the other.
+//!
+class TokenGame final
+{
+public:
+	~TokenGame();
+
+	//!
+	//! \brief TokenGame constructor.
+	//! \param net - The net. Must outlive the token game.
+	//! \param delays - Firing delays by transition name. Transitions not listed use their firing window.
+	//!
+	TokenGame(const CompiledNet &net, const std::unordered_map<std::string, DelayDistribution> &delays);
+
+	TokenGame(const TokenGame &) = delete;
+	TokenGame(TokenGame &&) = delete;
+	TokenGame &operator=(const TokenGame &) = delete;
+	TokenGame &operator=(TokenGame &&) = delete;
+
+	//!
+	//! \brief Start a replication from the initial marking of the net, at virtual time zero.
+	//! \param seed - Seed of the random number generator of the replication.
+	//!
+	void start(const uint64_t seed);
+
+	//!
+	//! \brief Fire the next scheduled transition, if it is scheduled up to a given virtual time. Otherwise the
+	//! virtual time is advanced to that time, if there are scheduled firings.
+	//! \param duration - Virtual time until which transitions can fire.
+	//! \return Index of the fired transition, or nothing if no transition fired.
+	//!
+	std::optional<size_t> fireNext(const SimulationTime duration);
+
+	//!
+	//! \brief Get the current marking.
+	//! \return The current marking.
+	//!
+	const CompiledNet::Marking &getMarking() const;
+
+	//!
+	//! \brief Get the current virtual time.
+	//! \return The current virtual time.
+	//!
+	SimulationTime getTime() const;
+
+	//!
+	//! \brief Check if there are scheduled firings.
+	//! \return True if at least one transition is scheduled to fire.
+	//!
+	bool isWorkRemaining() const;
+
+private:
+	//! Firing of a transition scheduled in virtual time.
+	struct ScheduledFiring
+	{
+		SimulationTime time;
+
+		//! Random order among firings scheduled at the same time.
+		uint64_t tieBreaker = 0;
+
+		size_t transition = 0;
+
+		//! Firings scheduled before the transition was last unscheduled are outdated.
+		size_t generation = 0;
+
+		bool operator>(const ScheduledFiring &other) const
+		{
+			return time != other.time ? time > other.time : tieBreaker > other.tieBreaker;
+		}
+	};
+
+	//!
+	//! \brief Schedule or unschedule a transition according to whether it is enabled.
+	//! \param transition - Index of the transition.
+	//!
+	void update(const size_t transition);
+
+	//!
+	//! \brief Discard the outdated firings at the top of the heap.
+	//!
+	void discardOutdatedFirings();
+
+	//! The net.
+	const CompiledNet &m_net;
+
+	//! Firing delay distribution of each transition.
+	std::vector<DelayDistribution> m_delays;
+
+	//! Current marking.
+	CompiledNet::Marking m_marking;
+
+	//! Whether each transition is scheduled.
+	std::vector<bool> m_scheduled;
+
+	//! Current scheduling generation of each transition.
+	std::vector<size_t> m_generations;
+
+	//! Scheduled firings, as a heap with the earliest first. Kept as a vector to reuse its memory.
+	std::vector<ScheduledFiring> m_firings;
+
+	//! Random number generator of the delays and tie breakers.
+	std::mt19937_64 m_randomGenerator;
+
+	//! Current virtual time.
+	SimulationTime m_now = SimulationTime::zero();
+};
+
+} // namespace ptne
@@ -0,0 +1,241 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/Verification.h"
+#include "PTN_Engine/Analysis/CompiledNet.h"
+#include "PTN_Engine/Analysis/MarkingStore.h"
+#include "PTN_Engine/Analysis/StubbornSets.h"
+#include <algorithm>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//!
+//! \brief Breadth first search of a reachable marking with a property: a deadlock or a target marking.
+//!
+class MarkingSearch final
+{
+public:
+	//! Outcome of a search.
+	struct Outcome
+	{
+		bool found = false;
+		bool complete = true;
+		vector<string> firingSequence;
+		size_t numberOfMarkings = 0;
+	};
+
+	MarkingSearch(const CompiledNet &net, const VerificationOptions &options)
+	: m_net(net)
+	, m_options(options)
+	, m_stubbornSets(net)
+	{
+	}
+
+	MarkingSearch(const MarkingSearch &) = delete;
+	MarkingSearch(MarkingSearch &&) = delete;
+	MarkingSearch &operator=(const MarkingSearch &) = delete;
+	MarkingSearch &operator=(MarkingSearch &&) = delete;
+
+	//!
+	//! \brief Search a marking.
+	//! \param target - The target marking, or null to search a deadlock.
+	//! \return Whether a marking was found and how to reach it.
+	//!
+	Outcome run(const CompiledNet::PartialMarking *target)
+	{
+		Outcome outcome;
+		MarkingStore store(m_net.getPlaces().size(), m_options.memoryLimit, m_options.maxMarkings);
+		MarkingStore::Writer writer;
+
+		// The visited markings, in order of discovery, with the firing that discovered them.
+		vector<Node> nodes;
+		MarkingStore::Reference reference = 0;
+		if (store.insert(m_net.getInitialMarking(), writer, reference) == MarkingStore::InsertStatus::FULL)
+		{
+			outcome.complete = false;
+			return outcome;
+		}
+		nodes.push_back(Node{ .marking = reference });
+
+		for (size_t head = 0; head < nodes.size(); ++head)
+		{
+			store.get(nodes[head].marking, m_marking);
+			if (target != nullptr && matches(*target))
+			{
+				outcome.found = true;
+			}
+			else
+			{
+				getTransitionsToFire(target);
+				outcome.found = target == nullptr && m_transitions.empty();
+			}
+			if (outcome.found)
+			{
+				outcome.firingSequence = getFiringSequence(nodes, head);
+				break;
+			}
+
+			for (const size_t transition : m_transitions)
+			{
+				m_successor = m_marking;
+				m_net.fire(transition, m_successor);
+				const auto status = store.insert(m_successor, writer, reference);
+				if (status == MarkingStore::InsertStatus::INSERTED)
+				{
+					nodes.push_back(Node{ .marking = reference, .parent = head, .transition = transition });
+				}
+				else if (status == MarkingStore::InsertStatus::FULL)
+				{
+					// The search goes on with the stored markings, but can no longer prove the absence.
+					outcome.complete = false;
+				}
+			}
+		}
+		outcome.numberOfMarkings = store.size();
+		return outcome;
+	}
+
+private:
+	//! Visited marking.
+	struct Node
+	{
+		MarkingStore::Reference marking = 0;
+		size_t parent = 0;
+		size_t transition = 0;
+	};
+
+	//!
+	//! \brief Check if the current marking matches a target.
+	//! \param target - The target marking.
+	//! \return True if it matches.
+	//!
+	bool matches(const CompiledNet::PartialMarking &target) const
+	{
+		return ranges::all_of(target, [this](const auto &placeTokens)
+							  { return m_marking[placeTokens.first] == placeTokens.second; });
+	}
+
+	//!
+	//! \brief Get the transitions to be fired in the current marking.
+	//! \param target - The target marking, or null when searching a deadlock.
+	//!
+	void getTransitionsToFire(const CompiledNet::PartialMarking *target)
+	{
+		if (!m_options.partialOrderReduction)
+		{
+			m_transitions.clear();
+			for (size_t transition = 0; transition < m_net.getTransitions().size(); ++transition)
+			{
+				if (m_net.isEnabled(transition, m_marking))
+				{
+					m_transitions.push_back(transition);
+				}
+			}
+		}
+		else if (target == nullptr)
+		{
+			m_stubbornSets.getDeadlockPreservingSet(m_marking, m_transitions);
+		}
+		else
+		{
+			m_stubbornSets.getReachabilityPreservingSet(m_marking, *target, m_transitions);
+		}
+	}
+
+	//!
+	//! \brief Get the firing sequence from the initial marking to a visited marking.
+	//! \param nodes - The visited markings.
+	//! \param node - Index of the visited marking.
+	//! \return The names of the fired transitions, in order.
+	//!
+	vector<string> getFiringSequence(const vector<Node> &nodes, size_t node) const
+	{
+		vector<string> firingSequence;
+		for (; node != 0; node = nodes[node].parent)
+		{
+			firingSequence.push_back(m_net.getTransitions()[nodes[node].transition].name);
+		}
+		ranges::reverse(firingSequence);
+		return firingSequence;
+	}
+
+	const CompiledNet &m_net;
+	const VerificationOptions &m_options;
+	StubbornSets m_stubbornSets;
+
+	//! Marking being expanded.
+	CompiledNet::Marking m_marking;
+
+	//! Successor of the marking being expanded.
+	CompiledNet::Marking m_successor;
+
+	//! Transitions to be fired in the marking being expanded.
+	vector<size_t> m_transitions;
+};
+
+VerificationResult runChecks(const CompiledNet &net, const VerificationOptions &options)
+{
+	vector<CompiledNet::PartialMarking> targetMarkings;
+	for (const auto &targetMarking : options.targetMarkings)
+	{
+		targetMarkings.push_back(net.toPartialMarking(targetMarking));
+	}
+
+	VerificationResult result;
+	MarkingSearch search(net, options);
+	if (options.checkDeadlocks)
+	{
+		MarkingSearch::Outcome outcome = search.run(nullptr);
+		result.deadlockReachable = outcome.found;
+		result.deadlockCheckComplete = outcome.found || outcome.complete;
+		result.deadlockFiringSequence = std::move(outcome.firingSequence);
+		result.numberOfMarkings += outcome.numberOfMarkings;
+	}
+	for (const auto &targetMarking : targetMarkings)
+	{
+		MarkingSearch::Outcome outcome = search.run(&targetMarking);
+		result.targetMarkings.push_back(TargetMarkingVerdict{ .reachable = outcome.found,
+															  .complete = outcome.found || outcome.complete,
+															  .firingSequence = std::move(outcome.firingSequence) });
+		result.numberOfMarkings += outcome.numberOfMarkings;
+	}
+	return result;
+}
+
+} // namespace
+
+VerificationResult verify(const PTN_Engine &ptnEngine, const VerificationOptions &options)
+{
+	const CompiledNet net(ptnEngine);
+	return runChecks(net, options);
+}
+
+VerificationResult verify(const vector<PlaceProperties> &placesProperties,
+						  const vector<TransitionProperties> &transitionsProperties,
+						  const VerificationOptions &options)
+{
+	const CompiledNet net(placesProperties, transitionsProperties);
+	return runChecks(net, options);
+}
+
+} // namespace ptne
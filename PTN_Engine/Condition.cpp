@@ -0,0 +1,64 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/Condition.h"
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+bool callConditionFunction(void *conditionFunction)
+{
+	return (*static_cast<ConditionFunction *>(conditionFunction))();
+}
+} // namespace
+
+Condition::Condition(const ConditionFunction &condition)
+{
+	if (condition == nullptr)
+	{
+		return;
+	}
+	m_conditionFunction = make_shared<ConditionFunction>(condition);
+	m_condition = ContextCondition{ .function = callConditionFunction, .userData = m_conditionFunction.get() };
+}
+
+Condition::Condition(const ContextCondition &condition)
+: m_condition(condition)
+{
+}
+
+Condition::operator bool() const
+{
+	return m_condition.function != nullptr;
+}
+
+const ConditionFunction *Condition::getConditionFunction() const
+{
+	return m_conditionFunction.get();
+}
+
+ContextCondition Condition::getContextCondition() const
+{
+	return m_conditionFunction ? ContextCondition{} : m_condition;
+}
+
+} // namespace ptne
@@ -0,0 +1,87 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <memory>
+
+namespace ptne
+{
+
+//!
+//! \brief Additional condition of a transition, always called through a plain function pointer. A condition made
+//! from a ConditionFunction owns it and calls it through a forwarding function, so that copies of the condition
+//! share it instead of copying it.
+//!
+class Condition final
+{
+public:
+	//!
+	//! \brief Make an invalid condition, without a function.
+	//!
+	Condition() = default;
+
+	//!
+	//! \brief Make a condition from a std::function. An empty function makes an invalid condition.
+	//! \param condition - The function.
+	//!
+	Condition(const ConditionFunction &condition);
+
+	//!
+	//! \brief Make a condition from a function pointer and its user data.
+	//! \param condition - The function and its user data.
+	//!
+	Condition(const ContextCondition &condition);
+
+	//!
+	//! \brief Evaluate the condition. Requires the condition to be valid.
+	//! \return The value returned by the function.
+	//!
+	bool operator()() const
+	{
+		return m_condition.function(m_condition.userData);
+	}
+
+	//!
+	//! \brief Whether the condition has a function.
+	//!
+	explicit operator bool() const;
+
+	//!
+	//! \brief Get the std::function the condition was made from.
+	//! \return The function, or nullptr if the condition was made from a ContextCondition.
+	//!
+	const ConditionFunction *getConditionFunction() const;
+
+	//!
+	//! \brief Get the function pointer and user data the condition was made from.
+	//! \return The condition, or an empty one if the condition was made from a std::function.
+	//!
+	ContextCondition getContextCondition() const;
+
+private:
+	//! Function called to evaluate the condition.
+	ContextCondition m_condition;
+
+	//! The std::function the condition was made from, if any, passed as user data of m_condition.
+	std::shared_ptr<ConditionFunction> m_conditionFunction;
+};
+
+} // namespace ptne
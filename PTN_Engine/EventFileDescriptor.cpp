@@ -0,0 +1,86 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EventFileDescriptor.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace ptne
+{
+using namespace std;
+
+#ifdef __linux__
+
+EventFileDescriptor::EventFileDescriptor()
+: m_fileDescriptor(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+	if (m_fileDescriptor < 0)
+	{
+		throw PTN_Exception("Could not create the event file descriptor.");
+	}
+}
+
+EventFileDescriptor::~EventFileDescriptor()
+{
+	close(m_fileDescriptor);
+}
+
+void EventFileDescriptor::signal() const noexcept
+{
+	// Only fails if the counter would overflow, in which case the descriptor is already readable.
+	const uint64_t increment = 1;
+	[[maybe_unused]] const auto result = write(m_fileDescriptor, &increment, sizeof(increment));
+}
+
+void EventFileDescriptor::clear() const noexcept
+{
+	// Reading resets the counter. Fails with EAGAIN if it was not signaled, which is fine.
+	uint64_t counter = 0;
+	[[maybe_unused]] const auto result = read(m_fileDescriptor, &counter, sizeof(counter));
+}
+
+#else
+
+EventFileDescriptor::EventFileDescriptor()
+{
+	throw PTN_Exception("Event file descriptors are only supported on Linux.");
+}
+
+EventFileDescriptor::~EventFileDescriptor() = default;
+
+void EventFileDescriptor::signal() const noexcept
+{
+}
+
+void EventFileDescriptor::clear() const noexcept
+{
+}
+
+#endif
+
+int EventFileDescriptor::get() const
+{
+	return m_fileDescriptor;
+}
+
+} // namespace ptne
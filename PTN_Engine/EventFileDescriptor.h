@@ -0,0 +1,65 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace ptne
+{
+
+//!
+//! \brief RAII wrapper of a Linux eventfd, used to signal an external event loop that the Petri net has pending
+//! work. The file descriptor is readable while signaled.
+//!
+class EventFileDescriptor final
+{
+public:
+	~EventFileDescriptor();
+
+	//!
+	//! \brief Creates a non-blocking eventfd.
+	//! \throws PTN_Exception if the eventfd cannot be created or the platform does not support it.
+	//!
+	EventFileDescriptor();
+
+	EventFileDescriptor(const EventFileDescriptor &) = delete;
+	EventFileDescriptor(EventFileDescriptor &&) = delete;
+	EventFileDescriptor &operator=(const EventFileDescriptor &) = delete;
+	EventFileDescriptor &operator=(EventFileDescriptor &&) = delete;
+
+	//!
+	//! \brief Get the file descriptor to be registered in the external event loop.
+	//! \return The file descriptor.
+	//!
+	int get() const;
+
+	//!
+	//! \brief Make the file descriptor readable.
+	//!
+	void signal() const noexcept;
+
+	//!
+	//! \brief Make the file descriptor not readable.
+	//!
+	void clear() const noexcept;
+
+private:
+	//! The eventfd file descriptor.
+	int m_fileDescriptor = -1;
+};
+
+} // namespace ptne
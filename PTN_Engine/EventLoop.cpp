@@ -17,6 +17,7 @@
  */
 
 #include "PTN_Engine/EventLoop.h"
+#include "PTN_Engine/EventLoopSchedulerImp.h"
 #include "PTN_Engine/IPTN_EngineEL.h"
 #include "PTN_Engine/PTN_Exception.h"
 #include <thread>
@@ -44,7 +45,17 @@ void EventLoop::stop() noexcept
 		return;
 	}
 
-	if (m_eventLoopThread.get_stop_token().stop_possible())
+	if (m_eventFileDescriptor != nullptr)
+	{
+		m_eventLoopThreadRunning = false;
+		m_eventFileDescriptor->clear();
+	}
+	else if (m_scheduler != nullptr)
+	{
+		m_scheduler->m_imp->detach(*this);
+		m_eventLoopThreadRunning = false;
+	}
+	else if (m_eventLoopThread.get_stop_token().stop_possible())
 	{
 		m_eventLoopThread.request_stop();
 		m_barrier->arrive_and_wait();
@@ -62,6 +73,19 @@ void EventLoop::start(const bool log, ostream &o)
 		while (m_ptnEngine.executeInt(log, o))
 			;
 	}
+	else if (m_eventFileDescriptor != nullptr)
+	{
+		// The external event loop polls the net once it sees the descriptor readable.
+		m_eventLoopThreadRunning = true;
+		m_eventFileDescriptor->signal();
+	}
+	else if (m_scheduler != nullptr)
+	{
+		m_log = log;
+		m_logStream = &o;
+		m_eventLoopThreadRunning = true;
+		m_scheduler->m_imp->attach(*this);
+	}
 	else
 	{
 		m_barrier = make_unique<barrier<>>(2);
@@ -72,6 +96,16 @@ void EventLoop::start(const bool log, ostream &o)
 
 void EventLoop::notifyNewEvent()
 {
+	if (m_eventFileDescriptor != nullptr)
+	{
+		m_eventFileDescriptor->signal();
+		return;
+	}
+	if (m_scheduler != nullptr)
+	{
+		m_scheduler->m_imp->schedule(*this);
+		return;
+	}
 	unique_lock eventNotifierGuard(m_eventNotifierMutex);
 	m_eventNotifier.notify_all();
 }
@@ -89,16 +123,78 @@ EventLoop::SleepDuration EventLoop::getSleepDuration() const
 	return m_sleepDuration;
 }
 
+chrono::steady_clock::time_point EventLoop::getWakeUpTime() const
+{
+	const auto wakeUpTime = chrono::steady_clock::now() + getSleepDuration();
+	if (const auto nextFiringTime = m_ptnEngine.getNextFiringTime(); nextFiringTime.has_value())
+	{
+		return min(wakeUpTime, *nextFiringTime);
+	}
+	return wakeUpTime;
+}
+
+void EventLoop::setScheduler(const shared_ptr<EventLoopScheduler> &scheduler)
+{
+	if (isRunning())
+	{
+		throw PTN_Exception("Cannot change the event loop scheduler while the event loop is running.");
+	}
+	m_scheduler = scheduler;
+}
+
+shared_ptr<EventLoopScheduler> EventLoop::getScheduler() const
+{
+	return m_scheduler;
+}
+
+void EventLoop::setExternalLoop(const bool externalLoop)
+{
+	if (isRunning())
+	{
+		throw PTN_Exception("Cannot change to or from an external event loop while the event loop is running.");
+	}
+	if (!externalLoop)
+	{
+		m_eventFileDescriptor.reset();
+	}
+	else if (m_eventFileDescriptor == nullptr)
+	{
+		m_eventFileDescriptor = make_unique<EventFileDescriptor>();
+	}
+}
+
+int EventLoop::getEventFileDescriptor() const
+{
+	if (m_eventFileDescriptor == nullptr)
+	{
+		throw PTN_Exception("The event file descriptor is only available in the EXTERNAL_LOOP mode.");
+	}
+	return m_eventFileDescriptor->get();
+}
+
+void EventLoop::clearEvent() const noexcept
+{
+	if (m_eventFileDescriptor != nullptr)
+	{
+		m_eventFileDescriptor->clear();
+	}
+}
+
+bool EventLoop::runCycle()
+{
+	return m_ptnEngine.executeInt(m_log, *m_logStream);
+}
+
 void EventLoop::run(stop_token stopToken, const bool log, ostream &o)
 {
 	while (!stopToken.stop_requested())
 	{
 		if (!m_ptnEngine.executeInt(log, o))
 		{
-			shared_lock lock(m_sleepDurationMutex);
+			const auto wakeUpTime = getWakeUpTime();
 			unique_lock eventNotifierGuard(m_eventNotifierMutex);
-			m_eventNotifier.wait_for(eventNotifierGuard, m_sleepDuration,
-									 [this] { return m_ptnEngine.getNewInputReceived(); });
+			m_eventNotifier.wait_until(eventNotifierGuard, stopToken, wakeUpTime,
+									   [this] { return m_ptnEngine.getNewInputReceived(); });
 		}
 	}
 	m_eventLoopThreadRunning = false;
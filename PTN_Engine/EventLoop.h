@@ -18,10 +18,12 @@
 
 #pragma once
 
+#include "PTN_Engine/EventFileDescriptor.h"
 #include <atomic>
 #include <barrier>
 #include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
@@ -29,6 +31,7 @@
 namespace ptne
 {
 
+class EventLoopScheduler;
 class IPTN_EngineEL;
 class Transition;
 
@@ -88,6 +91,48 @@ public:
 	//!
 	SleepDuration getSleepDuration() const;
 
+	//!
+	//! \brief Get the time until which an idle event loop sleeps: the sleep duration from now, or the next firing
+	//! time of a timed transition if earlier.
+	//! \return The wake up time.
+	//!
+	std::chrono::steady_clock::time_point getWakeUpTime() const;
+
+	//!
+	//! \brief Set the scheduler whose threads run the event loop, instead of a dedicated thread.
+	//! \param scheduler - The scheduler to be used. nullptr sets back a dedicated thread.
+	//!
+	void setScheduler(const std::shared_ptr<EventLoopScheduler> &scheduler);
+
+	//!
+	//! \brief Get the scheduler whose threads run the event loop.
+	//! \return The scheduler, or nullptr if the event loop runs in a dedicated thread.
+	//!
+	std::shared_ptr<EventLoopScheduler> getScheduler() const;
+
+	//!
+	//! \brief Let an external event loop drive the Petri net, instead of a dedicated thread or a scheduler.
+	//! \param externalLoop - true to create the event file descriptor signaling pending work, false to release it.
+	//!
+	void setExternalLoop(const bool externalLoop);
+
+	//!
+	//! \brief Get the file descriptor that is readable while there is pending work for the external event loop.
+	//! \return The event file descriptor.
+	//!
+	int getEventFileDescriptor() const;
+
+	//!
+	//! \brief Acknowledge the pending work signaled to the external event loop, before processing it.
+	//!
+	void clearEvent() const noexcept;
+
+	//!
+	//! \brief Run one execution cycle of the Petri net. Called by the scheduler threads.
+	//! \return true if at least one transition was fired.
+	//!
+	bool runCycle();
+
 private:
 	//!
 	//! \brief Event loop function.
@@ -109,7 +154,7 @@ private:
 	std::atomic<bool> m_eventLoopThreadRunning = false;
 
 	//! Condition variable to wake up the event loop thread when some event happens.
-	std::condition_variable m_eventNotifier;
+	std::condition_variable_any m_eventNotifier;
 
 	//! Mutex protecting the event notifier condition variable m_eventNotifier.
 	mutable std::mutex m_eventNotifierMutex;
@@ -119,6 +164,18 @@ private:
 
 	//! Mutex protecting m_sleepDuration.
 	mutable std::shared_mutex m_sleepDurationMutex;
+
+	//! Scheduler running the event loop, if not run in a dedicated thread.
+	std::shared_ptr<EventLoopScheduler> m_scheduler = nullptr;
+
+	//! Signals pending work to an external event loop, if the Petri net is driven by one.
+	std::unique_ptr<EventFileDescriptor> m_eventFileDescriptor = nullptr;
+
+	//! Whether to log or not, when run by the scheduler.
+	bool m_log = false;
+
+	//! The output stream to write the log messages to, when run by the scheduler.
+	std::ostream *m_logStream = nullptr;
 };
 
 } // namespace ptne
@@ -0,0 +1,38 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EventLoopScheduler.h"
+#include "PTN_Engine/EventLoopSchedulerImp.h"
+
+namespace ptne
+{
+using namespace std;
+
+EventLoopScheduler::~EventLoopScheduler() = default;
+
+EventLoopScheduler::EventLoopScheduler(const size_t numberOfThreads)
+: m_imp(make_unique<EventLoopSchedulerImp>(numberOfThreads))
+{
+}
+
+size_t EventLoopScheduler::getNumberOfThreads() const
+{
+	return m_imp->getNumberOfThreads();
+}
+
+} // namespace ptne
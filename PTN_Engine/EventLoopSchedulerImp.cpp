@@ -0,0 +1,189 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EventLoopSchedulerImp.h"
+#include "PTN_Engine/EventLoop.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <functional>
+
+namespace ptne
+{
+using namespace std;
+
+EventLoopScheduler::EventLoopSchedulerImp::EventLoopSchedulerImp(const size_t numberOfThreads)
+{
+	if (numberOfThreads == 0)
+	{
+		throw PTN_Exception("The event loop scheduler requires at least one thread.");
+	}
+
+	for (size_t i = 0; i < numberOfThreads; ++i)
+	{
+		m_workers.emplace_back(bind_front(&EventLoopSchedulerImp::run, this));
+	}
+}
+
+//! The worker threads' destructors request them to stop and then join.
+EventLoopScheduler::EventLoopSchedulerImp::~EventLoopSchedulerImp() = default;
+
+size_t EventLoopScheduler::EventLoopSchedulerImp::getNumberOfThreads() const
+{
+	return m_workers.size();
+}
+
+void EventLoopScheduler::EventLoopSchedulerImp::attach(EventLoop &eventLoop)
+{
+	unique_lock guard(m_mutex);
+	if (m_eventLoops.contains(&eventLoop))
+	{
+		throw PTN_Exception("Event loop is already attached to the scheduler.");
+	}
+	enqueue(&eventLoop, m_eventLoops[&eventLoop]);
+}
+
+void EventLoopScheduler::EventLoopSchedulerImp::detach(EventLoop &eventLoop) noexcept
+{
+	unique_lock guard(m_mutex);
+	auto it = m_eventLoops.find(&eventLoop);
+	if (it == m_eventLoops.end())
+	{
+		return;
+	}
+
+	Entry &entry = it->second;
+	entry.detaching = true;
+	if (entry.state == State::QUEUED)
+	{
+		erase(m_readyQueue, &eventLoop);
+	}
+	m_eventLoopReleased.wait(guard,
+							 [&entry] { return entry.state != State::RUNNING && entry.state != State::RUNNING_NOTIFIED; });
+	m_eventLoops.erase(&eventLoop);
+}
+
+void EventLoopScheduler::EventLoopSchedulerImp::schedule(EventLoop &eventLoop)
+{
+	unique_lock guard(m_mutex);
+	auto it = m_eventLoops.find(&eventLoop);
+	if (it == m_eventLoops.end() || it->second.detaching)
+	{
+		return;
+	}
+
+	Entry &entry = it->second;
+	switch (entry.state)
+	{
+	case State::IDLE:
+	{
+		enqueue(&eventLoop, entry);
+		break;
+	}
+	case State::RUNNING:
+	{
+		entry.state = State::RUNNING_NOTIFIED;
+		break;
+	}
+	case State::QUEUED:
+	case State::RUNNING_NOTIFIED:
+	{
+		break;
+	}
+	}
+}
+
+void EventLoopScheduler::EventLoopSchedulerImp::enqueue(EventLoop *eventLoop, Entry &entry)
+{
+	entry.state = State::QUEUED;
+	m_readyQueue.push_back(eventLoop);
+	m_workAvailable.notify_one();
+}
+
+void EventLoopScheduler::EventLoopSchedulerImp::promoteExpiredWakeUps(const Clock::time_point now)
+{
+	while (!m_wakeUps.empty() && m_wakeUps.top().time <= now)
+	{
+		const WakeUp wakeUp = m_wakeUps.top();
+		m_wakeUps.pop();
+
+		auto it = m_eventLoops.find(wakeUp.eventLoop);
+		if (it == m_eventLoops.end())
+		{
+			continue;
+		}
+
+		// Outdated requests are discarded, only the last request of an idle event loop is valid.
+		if (Entry &entry = it->second; entry.state == State::IDLE && entry.wakeUpGeneration == wakeUp.generation)
+		{
+			enqueue(wakeUp.eventLoop, entry);
+		}
+	}
+}
+
+void EventLoopScheduler::EventLoopSchedulerImp::run(stop_token stopToken)
+{
+	unique_lock guard(m_mutex);
+	while (!stopToken.stop_requested())
+	{
+		promoteExpiredWakeUps(Clock::now());
+
+		if (m_readyQueue.empty())
+		{
+			auto workAvailable = [this] { return !m_readyQueue.empty(); };
+			if (m_wakeUps.empty())
+			{
+				m_workAvailable.wait(guard, stopToken, workAvailable);
+			}
+			else
+			{
+				m_workAvailable.wait_until(guard, stopToken, m_wakeUps.top().time, workAvailable);
+			}
+			continue;
+		}
+
+		EventLoop *eventLoop = m_readyQueue.front();
+		m_readyQueue.pop_front();
+		m_eventLoops.at(eventLoop).state = State::RUNNING;
+
+		guard.unlock();
+		const bool firedAtLeastOneTransition = eventLoop->runCycle();
+		guard.lock();
+
+		Entry &entry = m_eventLoops.at(eventLoop);
+		if (entry.detaching)
+		{
+			entry.state = State::IDLE;
+			m_eventLoopReleased.notify_all();
+		}
+		else if (firedAtLeastOneTransition || entry.state == State::RUNNING_NOTIFIED)
+		{
+			// Going to the back of the queue keeps busy nets from starving the others.
+			enqueue(eventLoop, entry);
+		}
+		else
+		{
+			entry.state = State::IDLE;
+			entry.wakeUpGeneration = ++m_nextWakeUpGeneration;
+			m_wakeUps.push(WakeUp{ .time = eventLoop->getWakeUpTime(),
+								   .eventLoop = eventLoop,
+								   .generation = entry.wakeUpGeneration });
+		}
+	}
+}
+
+} // namespace ptne
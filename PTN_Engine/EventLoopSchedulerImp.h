@@ -0,0 +1,149 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/EventLoopScheduler.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Implements the thread pool that multiplexes the event loops attached to an EventLoopScheduler.
+//!
+class EventLoopScheduler::EventLoopSchedulerImp final
+{
+public:
+	~EventLoopSchedulerImp();
+	explicit EventLoopSchedulerImp(const size_t numberOfThreads);
+	EventLoopSchedulerImp(const EventLoopSchedulerImp &) = delete;
+	EventLoopSchedulerImp(EventLoopSchedulerImp &&) = delete;
+	EventLoopSchedulerImp &operator=(const EventLoopSchedulerImp &) = delete;
+	EventLoopSchedulerImp &operator=(EventLoopSchedulerImp &&) = delete;
+
+	//!
+	//! \brief Start multiplexing an event loop. The event loop is scheduled immediately.
+	//! \param eventLoop - The event loop to be run by the pool.
+	//!
+	void attach(EventLoop &eventLoop);
+
+	//!
+	//! \brief Stop multiplexing an event loop. Blocks until the event loop is not being run by any thread.
+	//! \param eventLoop - The event loop to be removed from the pool.
+	//!
+	void detach(EventLoop &eventLoop) noexcept;
+
+	//!
+	//! \brief Get the number of threads in the pool.
+	//! \return The number of threads in the pool.
+	//!
+	size_t getNumberOfThreads() const;
+
+	//!
+	//! \brief Request an execution cycle of an attached event loop.
+	//! \param eventLoop - The event loop with pending work.
+	//!
+	void schedule(EventLoop &eventLoop);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	//! Scheduling state of an attached event loop.
+	enum class State
+	{
+		IDLE,
+		QUEUED,
+		RUNNING,
+		RUNNING_NOTIFIED
+	};
+
+	//! Book keeping of an attached event loop.
+	struct Entry
+	{
+		State state = State::IDLE;
+		bool detaching = false;
+		size_t wakeUpGeneration = 0;
+	};
+
+	//! Wake up request of an idle event loop.
+	struct WakeUp
+	{
+		Clock::time_point time;
+		EventLoop *eventLoop = nullptr;
+		size_t generation = 0;
+
+		bool operator>(const WakeUp &other) const
+		{
+			return time > other.time;
+		}
+	};
+
+	//!
+	//! \brief Put an event loop in the ready queue. Requires m_mutex to be locked.
+	//! \param eventLoop - Event loop to be queued.
+	//! \param entry - Book keeping of the event loop.
+	//!
+	void enqueue(EventLoop *eventLoop, Entry &entry);
+
+	//!
+	//! \brief Move the idle event loops whose wake up time has expired to the ready queue. Requires m_mutex to
+	//! be locked.
+	//! \param now - Current time.
+	//!
+	void promoteExpiredWakeUps(const Clock::time_point now);
+
+	//!
+	//! \brief Worker thread function.
+	//! \param stopToken - Signals the worker to terminate.
+	//!
+	void run(std::stop_token stopToken);
+
+	//! Attached event loops.
+	std::unordered_map<EventLoop *, Entry> m_eventLoops;
+
+	//! Notifies waiting detach calls that an event loop is no longer running.
+	std::condition_variable m_eventLoopReleased;
+
+	//! Protects all the scheduling data.
+	mutable std::mutex m_mutex;
+
+	//! Source of unique wake up generations, used to discard outdated wake up requests.
+	size_t m_nextWakeUpGeneration = 0;
+
+	//! Event loops ready to run an execution cycle, in order of arrival.
+	std::deque<EventLoop *> m_readyQueue;
+
+	//! Wake up requests of the idle event loops, earliest first.
+	std::priority_queue<WakeUp, std::vector<WakeUp>, std::greater<WakeUp>> m_wakeUps;
+
+	//! Wakes up the worker threads when there is work to be done.
+	std::condition_variable_any m_workAvailable;
+
+	//! Worker threads.
+	std::vector<std::jthread> m_workers;
+};
+
+} // namespace ptne
@@ -0,0 +1,65 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/ExecutionRecorder.h"
+#include "PTN_Engine/Transition.h"
+
+namespace ptne
+{
+using namespace std;
+
+ExecutionRecorder::~ExecutionRecorder() = default;
+
+ExecutionRecorder::ExecutionRecorder(vector<uint8_t> initialMarking)
+: m_initialMarking(std::move(initialMarking))
+{
+}
+
+void ExecutionRecorder::recordInput(const string &placeName)
+{
+	unique_lock guard(m_mutex);
+	m_events.emplace_back(placeName);
+}
+
+void ExecutionRecorder::recordFiring(const Transition &transition, const size_t firings)
+{
+	unique_lock guard(m_mutex);
+	m_events.insert(m_events.end(), firings, &transition);
+}
+
+ExecutionRecording ExecutionRecorder::getRecording() const
+{
+	unique_lock guard(m_mutex);
+	ExecutionRecording recording{ .initialMarking = m_initialMarking };
+	recording.events.reserve(m_events.size());
+	for (const auto &event : m_events)
+	{
+		if (const auto *placeName = get_if<string>(&event))
+		{
+			recording.events.push_back(RecordedEvent{ .type = RecordedEvent::Type::INPUT, .name = *placeName });
+		}
+		else
+		{
+			recording.events.push_back(
+			RecordedEvent{ .type = RecordedEvent::Type::FIRING, .name = get<const Transition *>(event)->getName() });
+		}
+	}
+	return recording;
+}
+
+} // namespace ptne
@@ -0,0 +1,87 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace ptne
+{
+
+class Transition;
+
+//!
+//! \brief Records the input tokens and the fired transitions of a net, in an order in which they can be replayed.
+//!
+//! An input token must be recorded before being added and a firing after the tokens are moved, so that every
+//! firing comes after the records of the tokens it consumed.
+//!
+class ExecutionRecorder final
+{
+public:
+	~ExecutionRecorder();
+
+	//!
+	//! \brief ExecutionRecorder constructor.
+	//! \param initialMarking - Snapshot of the marking when the recording starts.
+	//!
+	explicit ExecutionRecorder(std::vector<uint8_t> initialMarking);
+
+	ExecutionRecorder(const ExecutionRecorder &) = delete;
+	ExecutionRecorder(ExecutionRecorder &&) = delete;
+	ExecutionRecorder &operator=(const ExecutionRecorder &) = delete;
+	ExecutionRecorder &operator=(ExecutionRecorder &&) = delete;
+
+	//!
+	//! \brief Record a token added to an input place.
+	//! \param placeName - The name of the input place.
+	//!
+	void recordInput(const std::string &placeName);
+
+	//!
+	//! \brief Record the firing of a transition. The transition must not be destroyed before the recording is
+	//! taken.
+	//! \param transition - The fired transition.
+	//! \param firings - Number of times the transition fired, recorded as as many single firings.
+	//!
+	void recordFiring(const Transition &transition, const size_t firings = 1);
+
+	//!
+	//! \brief Get the recorded execution.
+	//! \return The initial marking and the recorded events.
+	//!
+	ExecutionRecording getRecording() const;
+
+private:
+	//! Snapshot of the marking when the recording started.
+	const std::vector<uint8_t> m_initialMarking;
+
+	//! Names of the input places and fired transitions, in order. Transition names are only looked up when the
+	//! recording is taken, to keep the firings fast.
+	std::vector<std::variant<std::string, const Transition *>> m_events;
+
+	//! Protects m_events.
+	mutable std::mutex m_mutex;
+};
+
+} // namespace ptne
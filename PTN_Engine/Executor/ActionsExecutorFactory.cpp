@@ -39,6 +39,7 @@ ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION actions
 	}
 	case PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD:
 	case PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP:
+	case PTN_Engine::ACTIONS_THREAD_OPTION::EXTERNAL_LOOP:
 	{
 		return make_unique<SingleThreadExecutor>();
 	}
@@ -37,4 +37,19 @@ void DetachedExecutor::executeAction(const ActionFunction &action, atomic<size_t
 	t.detach();
 }
 
+void DetachedExecutor::executeAction(const ContextAction &action,
+									 const ActionContext &context,
+									 atomic<size_t> &actionsInExecution,
+									 shared_ptr<const void> place)
+{
+	++actionsInExecution;
+	auto job = [&actionsInExecution, action, context, place = std::move(place)]()
+	{
+		action.function(context);
+		--actionsInExecution;
+	};
+	auto t = thread(job);
+	t.detach();
+}
+
 } // namespace ptne
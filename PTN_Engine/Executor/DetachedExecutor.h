@@ -27,6 +27,10 @@ class DetachedExecutor : public IActionsExecutor
 {
 public:
     void executeAction(const ActionFunction &action, std::atomic<size_t> &actionsInExecution) override;
+    void executeAction(const ContextAction &action,
+                       const ActionContext &context,
+                       std::atomic<size_t> &actionsInExecution,
+                       std::shared_ptr<const void> place) override;
 };
 
 } // namespace ptne
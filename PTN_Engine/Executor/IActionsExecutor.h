@@ -19,6 +19,8 @@
 #pragma once
 
 #include "PTN_Engine/PTN_Engine.h"
+#include <atomic>
+#include <memory>
 
 namespace ptne
 {
@@ -27,6 +29,17 @@ class IActionsExecutor
 public:
 	virtual ~IActionsExecutor() = default;
 	virtual void executeAction(const ActionFunction &action, std::atomic<size_t> &counter) = 0;
+	//!
+	//! \brief Execute an action receiving its context.
+	//! \param action - The action.
+	//! \param context - The context, copied by the executors running the action later.
+	//! \param counter - Counter of the actions in execution, owned by the place.
+	//! \param place - Place the context and the counter refer to, kept alive until the action has run.
+	//!
+	virtual void executeAction(const ContextAction &action,
+							   const ActionContext &context,
+							   std::atomic<size_t> &counter,
+							   std::shared_ptr<const void> place) = 0;
 };
 
 } // namespace ptne
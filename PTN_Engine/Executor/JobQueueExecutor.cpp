@@ -35,4 +35,18 @@ void JobQueueExecutor::executeAction(const ActionFunction &action, atomic<size_t
 	m_jobQueue.addJob(f);
 }
 
+void JobQueueExecutor::executeAction(const ContextAction &action,
+									 const ActionContext &context,
+									 atomic<size_t> &actionsInExecution,
+									 shared_ptr<const void> place)
+{
+	++actionsInExecution;
+	auto f = [&actionsInExecution, action, context, place = std::move(place)]()
+	{
+		action.function(context);
+		--actionsInExecution;
+	};
+	m_jobQueue.addJob(f);
+}
+
 } // namespace ptne
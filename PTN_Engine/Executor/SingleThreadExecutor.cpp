@@ -31,4 +31,14 @@ void SingleThreadExecutor::executeAction(const ActionFunction &action, atomic<si
 	--actionsInExecution;
 }
 
+void SingleThreadExecutor::executeAction(const ContextAction &action,
+										 const ActionContext &context,
+										 atomic<size_t> &actionsInExecution,
+										 shared_ptr<const void>)
+{
+	++actionsInExecution;
+	action.function(context);
+	--actionsInExecution;
+}
+
 } // namespace ptne
@@ -0,0 +1,38 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Executor/SuppressedActionsExecutor.h"
+#include <atomic>
+
+namespace ptne
+{
+
+using namespace std;
+
+void SuppressedActionsExecutor::executeAction(const ActionFunction &, atomic<size_t> &)
+{
+}
+
+void SuppressedActionsExecutor::executeAction(const ContextAction &,
+											  const ActionContext &,
+											  atomic<size_t> &,
+											  shared_ptr<const void>)
+{
+}
+
+} // namespace ptne
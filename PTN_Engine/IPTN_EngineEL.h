@@ -19,7 +19,9 @@
 #pragma once
 
 #include "PTN_Engine/PTN_Engine.h"
+#include <chrono>
 #include <iostream>
+#include <optional>
 
 namespace ptne
 {
@@ -37,6 +39,8 @@ public:
 	virtual PTN_Engine::ACTIONS_THREAD_OPTION getActionsThreadOption() const = 0;
 
 	virtual bool getNewInputReceived() const = 0;
+
+	virtual std::optional<std::chrono::steady_clock::time_point> getNextFiringTime() const = 0;
 };
 
 } // namespace ptne
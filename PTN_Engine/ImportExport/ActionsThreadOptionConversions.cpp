@@ -27,6 +27,7 @@ const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_SINGLE_THREAD
 const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_EVENT_LOOP = "EVENT_LOOP";
 const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_DETACHED = "DETACHED";
 const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_JOB_QUEUE = "JOB_QUEUE";
+const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_EXTERNAL_LOOP = "EXTERNAL_LOOP";
 
 PTN_Engine::ACTIONS_THREAD_OPTION
 ActionsThreadOptionConversions::toACTIONS_THREAD_OPTION(const string &actionsThreadOptionStr)
@@ -48,6 +49,10 @@ ActionsThreadOptionConversions::toACTIONS_THREAD_OPTION(const string &actionsThr
 	{
 		return JOB_QUEUE;
 	}
+	else if (actionsThreadOptionStr == ACTIONS_THREAD_OPTION_EXTERNAL_LOOP)
+	{
+		return EXTERNAL_LOOP;
+	}
 	else
 	{
 		throw PTN_Exception("Could not convert " + actionsThreadOptionStr + " to ACTIONS_THREAD_OPTION");
@@ -79,6 +84,10 @@ string ActionsThreadOptionConversions::toString(PTN_Engine::ACTIONS_THREAD_OPTIO
 	{
 		return ACTIONS_THREAD_OPTION_JOB_QUEUE;
 	}
+	case EXTERNAL_LOOP:
+	{
+		return ACTIONS_THREAD_OPTION_EXTERNAL_LOOP;
+	}
 	}
 }
 
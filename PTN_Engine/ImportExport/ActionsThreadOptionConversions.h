@@ -31,6 +31,7 @@ private:
 	static const std::string ACTIONS_THREAD_OPTION_EVENT_LOOP;
 	static const std::string ACTIONS_THREAD_OPTION_DETACHED;
 	static const std::string ACTIONS_THREAD_OPTION_JOB_QUEUE;
+	static const std::string ACTIONS_THREAD_OPTION_EXTERNAL_LOOP;
 };
 
 } // namespace ptne
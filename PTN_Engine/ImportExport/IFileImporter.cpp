@@ -19,11 +19,114 @@
 #include "PTN_Engine/ImportExport/IFileImporter.h"
 #include "PTN_Engine/ImportExport/ActionsThreadOptionConversions.h"
 #include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <map>
 
 namespace ptne
 {
 using namespace std;
 
+namespace
+{
+//!
+//! \brief Add the arcs listed apart from the transitions to the properties of their transitions.
+//! \param transitions - Properties of the transitions.
+//! \param arcs - Arcs listed apart.
+//!
+void mergeArcs(vector<TransitionProperties> &transitions, const vector<ArcProperties> &arcs)
+{
+	using enum ArcProperties::Type;
+	for (ArcProperties arc : arcs)
+	{
+		auto transition = ranges::find(transitions, arc.transitionName, &TransitionProperties::name);
+		if (transition == transitions.end())
+		{
+			throw PTN_Exception("The transition " + arc.transitionName +
+								" must already exist in order to link to an arc.");
+		}
+		if (arc.type == ACTIVATION || arc.type == BIDIRECTIONAL)
+		{
+			arc.type = ACTIVATION;
+			transition->activationArcs.push_back(arc);
+		}
+		if (arc.type == DESTINATION || arc.type == BIDIRECTIONAL)
+		{
+			arc.type = DESTINATION;
+			transition->destinationArcs.push_back(arc);
+		}
+		if (arc.type == INHIBITOR)
+		{
+			transition->inhibitorArcs.push_back(arc);
+		}
+		if (arc.type == RESET)
+		{
+			transition->resetArcs.push_back(arc);
+		}
+		if (arc.type == READ)
+		{
+			transition->readArcs.push_back(arc);
+		}
+	}
+}
+
+//!
+//! \brief Add to an update the arcs of a given type to be removed and added to a transition.
+//! \param transition - Name of the transition.
+//! \param arcs - Current arcs.
+//! \param newArcs - Arcs after the update.
+//! \param type - Type of the arcs.
+//! \param update - The update.
+//! \return Whether the arcs changed.
+//!
+bool diffArcs(const string &transition,
+			  const vector<ArcProperties> &arcs,
+			  const vector<ArcProperties> &newArcs,
+			  const ArcProperties::Type type,
+			  StructureUpdate &update)
+{
+	auto getWeights = [](const vector<ArcProperties> &arcsProperties)
+	{
+		map<string, size_t> weights;
+		for (const ArcProperties &arc : arcsProperties)
+		{
+			weights[arc.placeName] = arc.weight;
+		}
+		return weights;
+	};
+	const map<string, size_t> weights = getWeights(arcs);
+	const map<string, size_t> newWeights = getWeights(newArcs);
+
+	bool changed = false;
+	auto addChanges = [&](const map<string, size_t> &from, const map<string, size_t> &to, vector<ArcProperties> &changes)
+	{
+		for (const auto &[place, weight] : from)
+		{
+			if (const auto it = to.find(place); it == to.end() || it->second != weight)
+			{
+				changes.push_back(
+				ArcProperties{ .weight = weight, .placeName = place, .transitionName = transition, .type = type });
+				changed = true;
+			}
+		}
+	};
+	addChanges(weights, newWeights, update.removedArcs);
+	addChanges(newWeights, weights, update.addedArcs);
+	return changed;
+}
+
+//!
+//! \brief Whether two transitions have the same properties, other than their arcs.
+//!
+bool haveSameProperties(const TransitionProperties &transition, const TransitionProperties &other)
+{
+	return transition.additionalConditionsNames == other.additionalConditionsNames &&
+		   transition.requireNoActionsInExecution == other.requireNoActionsInExecution &&
+		   transition.minimumDelay == other.minimumDelay && transition.maximumDelay == other.maximumDelay &&
+		   transition.batchFiring == other.batchFiring;
+}
+} // namespace
+
 IFileImporter::~IFileImporter() = default;
 
 void IFileImporter::_importInt(PTN_Engine &ptnEngine) const
@@ -53,4 +156,84 @@ void IFileImporter::_importInt(PTN_Engine &ptnEngine) const
 	}
 }
 
+ReloadResult IFileImporter::_reloadInt(PTN_Engine &ptnEngine) const
+{
+	StructureUpdate update;
+	ReloadResult result;
+
+	const vector<PlaceProperties> places = ptnEngine.getPlacesProperties();
+	const vector<PlaceProperties> newPlaces = importPlaces();
+	for (const PlaceProperties &newPlace : newPlaces)
+	{
+		const auto place = ranges::find(places, newPlace.name, &PlaceProperties::name);
+		if (place == places.end())
+		{
+			update.places.push_back(newPlace);
+			result.addedPlaces.push_back(newPlace.name);
+		}
+		else if (place->input != newPlace.input || place->capacity != newPlace.capacity ||
+				 place->onEnterActionFunctionName != newPlace.onEnterActionFunctionName ||
+				 place->onExitActionFunctionName != newPlace.onExitActionFunctionName)
+		{
+			throw PTN_Exception("Cannot change the input flag, the capacity or the actions of the place " +
+								newPlace.name + " when reloading the net.");
+		}
+	}
+	for (const PlaceProperties &place : places)
+	{
+		if (ranges::find(newPlaces, place.name, &PlaceProperties::name) == newPlaces.end())
+		{
+			update.removedPlaces.push_back(place.name);
+			result.removedPlaces.push_back(place.name);
+		}
+	}
+
+	const vector<TransitionProperties> transitions = ptnEngine.getTransitionsProperties();
+	vector<TransitionProperties> newTransitions = importTransitions();
+	mergeArcs(newTransitions, importArcs());
+	for (const TransitionProperties &newTransition : newTransitions)
+	{
+		const auto transition = ranges::find(transitions, newTransition.name, &TransitionProperties::name);
+		if (transition == transitions.end())
+		{
+			update.transitions.push_back(newTransition);
+			result.addedTransitions.push_back(newTransition.name);
+		}
+		else if (!haveSameProperties(*transition, newTransition))
+		{
+			update.removedTransitions.push_back(newTransition.name);
+			update.transitions.push_back(newTransition);
+			result.changedTransitions.push_back(newTransition.name);
+		}
+		else
+		{
+			using enum ArcProperties::Type;
+			const string &name = newTransition.name;
+			bool changed = diffArcs(name, transition->activationArcs, newTransition.activationArcs, ACTIVATION, update);
+			changed |= diffArcs(name, transition->destinationArcs, newTransition.destinationArcs, DESTINATION, update);
+			changed |= diffArcs(name, transition->inhibitorArcs, newTransition.inhibitorArcs, INHIBITOR, update);
+			changed |= diffArcs(name, transition->resetArcs, newTransition.resetArcs, RESET, update);
+			changed |= diffArcs(name, transition->readArcs, newTransition.readArcs, READ, update);
+			if (changed)
+			{
+				result.changedTransitions.push_back(name);
+			}
+		}
+	}
+	for (const TransitionProperties &transition : transitions)
+	{
+		if (ranges::find(newTransitions, transition.name, &TransitionProperties::name) == newTransitions.end())
+		{
+			update.removedTransitions.push_back(transition.name);
+			result.removedTransitions.push_back(transition.name);
+		}
+	}
+
+	ptnEngine.updateStructure(update);
+
+	ranges::sort(result.removedPlaces);
+	ranges::sort(result.removedTransitions);
+	return result;
+}
+
 } // namespace ptne
@@ -55,6 +55,10 @@ void XML_FileExporter::exportPlace(const PlaceProperties &placeProperties)
 	placeNode.append_attribute("input").set_value(placeProperties.input ? true : false);
 	placeNode.append_attribute("onEnterAction").set_value(placeProperties.onEnterActionFunctionName.c_str());
 	placeNode.append_attribute("onExitAction").set_value(placeProperties.onExitActionFunctionName.c_str());
+	if (placeProperties.capacity != 0)
+	{
+		placeNode.append_attribute("capacity").set_value(placeProperties.capacity);
+	}
 }
 
 void XML_FileExporter::exportTransition(const TransitionProperties &transitionProperties)
@@ -75,6 +79,23 @@ void XML_FileExporter::exportTransition(const TransitionProperties &transitionPr
 	requireNoActionsInExecution.append_attribute("value").set_value(
 	transitionProperties.requireNoActionsInExecution ? "true" : "false");
 
+	if (transitionProperties.minimumDelay != chrono::milliseconds::zero())
+	{
+		xml_node minimumDelay = transitionNode.append_child("MinimumDelay");
+		minimumDelay.append_attribute("value").set_value(to_string(transitionProperties.minimumDelay.count()).c_str());
+	}
+
+	if (transitionProperties.maximumDelay != chrono::milliseconds::zero())
+	{
+		xml_node maximumDelay = transitionNode.append_child("MaximumDelay");
+		maximumDelay.append_attribute("value").set_value(to_string(transitionProperties.maximumDelay.count()).c_str());
+	}
+
+	if (transitionProperties.batchFiring)
+	{
+		transitionNode.append_child("BatchFiring").append_attribute("value").set_value("true");
+	}
+
 	auto exportArcs = [this](const vector<ArcProperties> &arcsProperties, const string &typeStr)
 	{
 		for (const auto &arcProperties : arcsProperties)
@@ -96,6 +117,8 @@ void XML_FileExporter::exportTransition(const TransitionProperties &transitionPr
 	exportArcs(transitionProperties.activationArcs, "Activation");
 	exportArcs(transitionProperties.destinationArcs, "Destination");
 	exportArcs(transitionProperties.inhibitorArcs, "Inhibitor");
+	exportArcs(transitionProperties.resetArcs, "Reset");
+	exportArcs(transitionProperties.readArcs, "Read");
 }
 
 void XML_FileExporter::saveFile() const
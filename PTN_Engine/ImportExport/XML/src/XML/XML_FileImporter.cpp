@@ -118,6 +118,15 @@ void XML_FileImporter::_import(const string &filePath, PTN_Engine &ptnEngine)
 	IFileImporter::_importInt(ptnEngine);
 }
 
+ReloadResult XML_FileImporter::_reload(const string &filePath, PTN_Engine &ptnEngine)
+{
+	if (const auto &result = m_document.load_file(filePath.c_str()); !result)
+	{
+		throw PTN_Exception(result.description());
+	}
+	return IFileImporter::_reloadInt(ptnEngine);
+}
+
 string XML_FileImporter::importActionsThreadOption() const
 {
 	return m_document.child("PTN-Engine").attribute("actionsThreadOption").as_string();
@@ -141,11 +150,18 @@ vector<PlaceProperties> XML_FileImporter::importPlaces() const
 			numberOfTokens = static_cast<size_t>(atol(numberOfTokensStr.c_str()));
 		}
 
+		size_t capacity = 0;
+		if (const string capacityStr = getAttributeValue(place, "capacity"); !capacityStr.empty())
+		{
+			capacity = static_cast<size_t>(atol(capacityStr.c_str()));
+		}
+
 		placeProperties.name = getAttributeValue(place, "name");
 		placeProperties.initialNumberOfTokens = numberOfTokens;
 		placeProperties.onEnterActionFunctionName = getAttributeValue(place, "onEnterAction");
 		placeProperties.onExitActionFunctionName = getAttributeValue(place, "onExitAction");
 		placeProperties.input = isInput;
+		placeProperties.capacity = capacity;
 
 		placesInfoCollection.emplace_back(placeProperties);
 	}
@@ -165,9 +181,23 @@ vector<TransitionProperties> XML_FileImporter::importTransitions() const
 		transitionProperties.activationArcs = collectArcAttributes(transition, "ActivationPlaces", ACTIVATION);
 		transitionProperties.destinationArcs = collectArcAttributes(transition, "DestinationPlaces", DESTINATION);
 		transitionProperties.inhibitorArcs = collectArcAttributes(transition, "InhibitorPlaces", INHIBITOR);
+		transitionProperties.resetArcs = collectArcAttributes(transition, "ResetPlaces", RESET);
+		transitionProperties.readArcs = collectArcAttributes(transition, "ReadPlaces", READ);
 		transitionProperties.additionalConditionsNames = activationConditions;
 		transitionProperties.requireNoActionsInExecution =
 		getNodeValue<bool>("RequireNoActionsInExecution", transition);
+		if (transition.child("MinimumDelay"))
+		{
+			transitionProperties.minimumDelay = chrono::milliseconds(getNodeValue<size_t>("MinimumDelay", transition));
+		}
+		if (transition.child("MaximumDelay"))
+		{
+			transitionProperties.maximumDelay = chrono::milliseconds(getNodeValue<size_t>("MaximumDelay", transition));
+		}
+		if (transition.child("BatchFiring"))
+		{
+			transitionProperties.batchFiring = getNodeValue<bool>("BatchFiring", transition);
+		}
 		transitionInfoCollection.emplace_back(transitionProperties);
 	}
 	return transitionInfoCollection;
@@ -201,6 +231,14 @@ vector<ArcProperties> XML_FileImporter::importArcs() const
 		{
 			arcProperties.type = INHIBITOR;
 		}
+		else if (typeStr == "Reset")
+		{
+			arcProperties.type = RESET;
+		}
+		else if (typeStr == "Read")
+		{
+			arcProperties.type = READ;
+		}
 		else
 		{
 			throw PTN_Exception("Type string not supported");
@@ -47,6 +47,14 @@ public:
 	//!
 	void _import(const std::string &filePath, PTN_Engine &ptnEngine) override;
 
+	//!
+	//! \brief _reload Loads a revised net from an xml file into a PTN_Engine object, keeping its marking.
+	//! \param filePath - file path to the xml file with the revised net.
+	//! \param ptnEngine - PTN_Engine object to be updated.
+	//! \return The places and transitions added, removed and changed.
+	//!
+	ReloadResult _reload(const std::string &filePath, PTN_Engine &ptnEngine) override;
+
 private:
 	std::string importActionsThreadOption() const override;
 
@@ -30,6 +30,28 @@ class PTN_Engine;
 struct PlaceProperties;
 struct TransitionProperties;
 
+//!
+//! \brief Changes made to a net by IFileImporter::_reload.
+//!
+struct DLL_PUBLIC ReloadResult final
+{
+	//! Places of the file that were not in the net, created with their initial tokens.
+	std::vector<std::string> addedPlaces;
+
+	//! Places of the net that are not in the file, removed with their tokens.
+	std::vector<std::string> removedPlaces;
+
+	//! Transitions of the file that were not in the net.
+	std::vector<std::string> addedTransitions;
+
+	//! Transitions of the net that are not in the file.
+	std::vector<std::string> removedTransitions;
+
+	//! Transitions whose arcs or properties changed. Transitions with other conditions or firing windows are
+	//! created again.
+	std::vector<std::string> changedTransitions;
+};
+
 //!
 //! \brief The IFileImporter class is an interface class for all PTN_Engine file importers.
 //!
@@ -45,9 +67,22 @@ public:
 	//!
 	virtual void _import(const std::string &filePath, PTN_Engine &ptnEngine) = 0;
 
+	//!
+	//! \brief Load a revised definition of a net from a file into a PTN_Engine object, keeping its marking. May be
+	//! called while the event loop is running, which is not stopped. The places with the same name keep their
+	//! tokens and must keep their input flag and actions. All changes are applied together with
+	//! PTN_Engine::updateStructure. The actions thread option of the file is not applied.
+	//! \param filePath - the file path of the revised definition.
+	//! \param ptnEngine - the PTN_Object to be updated.
+	//! \return The places and transitions added, removed and changed.
+	//!
+	virtual ReloadResult _reload(const std::string &filePath, PTN_Engine &ptnEngine) = 0;
+
 protected:
 	void _importInt(PTN_Engine &ptnEngine) const;
 
+	ReloadResult _reloadInt(PTN_Engine &ptnEngine) const;
+
 private:
 	virtual std::string importActionsThreadOption() const = 0;
 	virtual std::vector<PlaceProperties> importPlaces() const = 0;
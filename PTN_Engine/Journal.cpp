@@ -0,0 +1,445 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Journal.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include "PTN_Engine/Utilities/Varint.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! Identifies the format of the journal files, including its version.
+constexpr array<uint8_t, 5> formatTag{ 'P', 'T', 'N', 'J', 1 };
+
+//! Size of the pending records above which they are written without waiting for the commit interval.
+constexpr size_t maxBatchSize = 1 << 20;
+
+string lastError()
+{
+	return system_category().message(errno);
+}
+
+#ifdef __linux__
+
+int openFile(const string &path)
+{
+	const int fileDescriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fileDescriptor < 0)
+	{
+		throw JournalException(path, "cannot be created, " + lastError());
+	}
+	return fileDescriptor;
+}
+
+void writeFile(const string &path, const int fileDescriptor, const vector<uint8_t> &bytes)
+{
+	for (size_t position = 0; position < bytes.size();)
+	{
+		const ssize_t written = ::write(fileDescriptor, bytes.data() + position, bytes.size() - position);
+		if (written < 0 && errno != EINTR)
+		{
+			throw JournalException(path, "cannot be written, " + lastError());
+		}
+		position += static_cast<size_t>(max<ssize_t>(written, 0));
+	}
+}
+
+void syncFile(const string &path, const int fileDescriptor)
+{
+	if (fdatasync(fileDescriptor) != 0)
+	{
+		throw JournalException(path, "cannot be synchronized, " + lastError());
+	}
+}
+
+void closeFile(const int fileDescriptor) noexcept
+{
+	if (fileDescriptor >= 0)
+	{
+		close(fileDescriptor);
+	}
+}
+
+void replaceFile(const string &from, const string &to)
+{
+	if (rename(from.c_str(), to.c_str()) != 0)
+	{
+		throw JournalException(to, "cannot be replaced, " + lastError());
+	}
+
+	// The rename is only durable once the directory is synchronized.
+	const filesystem::path directory = filesystem::absolute(to).parent_path();
+	if (const int fileDescriptor = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC); fileDescriptor >= 0)
+	{
+		fsync(fileDescriptor);
+		close(fileDescriptor);
+	}
+}
+
+#else
+
+int openFile(const string &path)
+{
+	throw JournalException(path, "journals are only supported on Linux");
+}
+
+void writeFile(const string &, const int, const vector<uint8_t> &)
+{
+}
+
+void syncFile(const string &, const int)
+{
+}
+
+void closeFile(const int) noexcept
+{
+}
+
+void replaceFile(const string &, const string &)
+{
+}
+
+#endif
+
+} // namespace
+
+Journal::~Journal()
+{
+	// The writer writes the pending records before terminating.
+	m_writer.request_stop();
+	m_writer.join();
+	closeFile(m_fileDescriptor);
+}
+
+Journal::Journal(const JournalOptions &options,
+				 vector<SharedPtrPlace> places,
+				 const vector<SharedPtrTransition> &transitions)
+: m_options(options)
+, m_serializer(places, transitions)
+{
+	if (m_options.path.empty())
+	{
+		throw PTN_Exception("The path of the journal cannot be empty.");
+	}
+
+	for (size_t i = 0; i < places.size(); ++i)
+	{
+		m_placeIndices.emplace(places[i]->getName(), i);
+		m_inputPlaces.push_back(places[i]->isInputPlace());
+	}
+
+	auto getTokens = [this](const vector<Arc> &arcs)
+	{
+		vector<pair<size_t, size_t>> tokens;
+		for (const Arc &arc : arcs)
+		{
+			tokens.emplace_back(m_placeIndices.at(lockWeakPtr(arc.place)->getName()), arc.weight);
+		}
+		return tokens;
+	};
+	for (size_t i = 0; i < transitions.size(); ++i)
+	{
+		m_transitionIndices.emplace(transitions[i].get(), i);
+		m_consumedTokens.push_back(getTokens(transitions[i]->getActivationArcs()));
+		m_producedTokens.push_back(getTokens(transitions[i]->getDestinationArcs()));
+		vector<size_t> &resetPlaces = m_resetPlaces.emplace_back();
+		for (const auto &[place, _] : getTokens(transitions[i]->getResetArcs()))
+		{
+			resetPlaces.push_back(place);
+		}
+		m_readTokens.push_back(getTokens(transitions[i]->getReadArcs()));
+	}
+
+	m_writer = jthread(bind_front(&Journal::run, this));
+}
+
+size_t Journal::recover()
+{
+	size_t replayedRecords = 0;
+	if (ifstream file(m_options.path, ios::binary); file)
+	{
+		const vector<uint8_t> bytes{ istreambuf_iterator<char>(file), istreambuf_iterator<char>() };
+		if (!bytes.empty())
+		{
+			vector<size_t> tokens;
+			replayedRecords = replay(bytes, tokens);
+			m_serializer.setMarking(tokens);
+		}
+	}
+	checkpoint();
+	sync();
+	return replayedRecords;
+}
+
+void Journal::recordInput(const string &placeName, const function<void()> &increment)
+{
+	lock_guard guard(m_mutex);
+	if (auto it = m_placeIndices.find(placeName); it != m_placeIndices.end() && m_inputPlaces[it->second])
+	{
+		append(RecordType::INPUT, it->second);
+	}
+	increment();
+}
+
+void Journal::recordFiring(const Transition &transition, const size_t firings)
+{
+	lock_guard guard(m_mutex);
+	const size_t index = m_transitionIndices.at(&transition);
+	for (size_t i = 0; i < firings; ++i)
+	{
+		append(RecordType::FIRING, index);
+	}
+}
+
+bool Journal::isCheckpointDue() const
+{
+	return m_recordsSinceCheckpoint.load(memory_order_relaxed) >= m_options.checkpointInterval;
+}
+
+void Journal::checkpoint(const function<void()> &change)
+{
+	lock_guard guard(m_mutex);
+	if (change)
+	{
+		change();
+	}
+
+	// The pending records are superseded by the checkpoint, which starts a new file.
+	m_pending.clear();
+	m_pendingCheckpoint = true;
+	const vector<uint8_t> snapshot = m_serializer.snapshot();
+	append(RecordType::CHECKPOINT, snapshot.size());
+	m_pending.insert(m_pending.end(), snapshot.begin(), snapshot.end());
+	m_recordsSinceCheckpoint = 0;
+}
+
+void Journal::sync()
+{
+	unique_lock guard(m_mutex);
+	const uint64_t appendedRecords = m_appendedRecords;
+	m_commitNow = true;
+	m_commitRequested.notify_one();
+	m_committed.wait(guard, [this, appendedRecords] { return m_committedRecords >= appendedRecords; });
+	if (m_error)
+	{
+		rethrow_exception(m_error);
+	}
+}
+
+void Journal::append(const RecordType type, const size_t value)
+{
+	m_pending.push_back(static_cast<uint8_t>(type));
+	utility::writeVarint(m_pending, value);
+	++m_appendedRecords;
+	++m_recordsSinceCheckpoint;
+	if (m_pending.size() >= maxBatchSize && !m_commitNow)
+	{
+		m_commitNow = true;
+		m_commitRequested.notify_one();
+	}
+}
+
+vector<uint8_t> Journal::getHeader() const
+{
+	vector<uint8_t> header(formatTag.begin(), formatTag.end());
+	const uint64_t structureHash = m_serializer.getStructureHash();
+	for (size_t i = 0; i < sizeof(structureHash); ++i)
+	{
+		header.push_back(static_cast<uint8_t>(structureHash >> (8 * i)));
+	}
+	return header;
+}
+
+size_t Journal::replay(const vector<uint8_t> &bytes, vector<size_t> &tokens) const
+{
+	const vector<uint8_t> header = getHeader();
+	if (bytes.size() < header.size() || !equal(formatTag.begin(), formatTag.end(), bytes.begin()))
+	{
+		throw JournalException(m_options.path, "is not a journal file");
+	}
+	if (!equal(header.begin(), header.end(), bytes.begin()))
+	{
+		throw JournalException(m_options.path, "was written by a net with another structure");
+	}
+
+	auto isEnabled = [&tokens](const vector<pair<size_t, size_t>> &consumedTokens)
+	{
+		return ranges::all_of(consumedTokens,
+							  [&tokens](const auto &consumed) { return tokens[consumed.first] >= consumed.second; });
+	};
+
+	bool hasCheckpoint = false;
+	size_t replayedRecords = 0;
+	// Stops at the first record that cannot be read or applied, which is where the last write before a crash
+	// was interrupted.
+	for (size_t position = header.size(); position < bytes.size();)
+	{
+		const auto type = static_cast<RecordType>(bytes[position]);
+		size_t next = position + 1;
+		uint64_t value = 0;
+		if (!utility::readVarint(bytes, next, value))
+		{
+			break;
+		}
+
+		if (type == RecordType::CHECKPOINT && value <= bytes.size() - next)
+		{
+			try
+			{
+				tokens = m_serializer.read(vector<uint8_t>(bytes.begin() + next, bytes.begin() + next + value));
+			}
+			catch (const InvalidSnapshotException &)
+			{
+				break;
+			}
+			next += value;
+			hasCheckpoint = true;
+			replayedRecords = 0;
+		}
+		else if (type == RecordType::INPUT && hasCheckpoint && value < tokens.size() && m_inputPlaces[value])
+		{
+			++tokens[value];
+			++replayedRecords;
+		}
+		else if (type == RecordType::FIRING && hasCheckpoint && value < m_consumedTokens.size() &&
+				 isEnabled(m_consumedTokens[value]) && isEnabled(m_readTokens[value]))
+		{
+			for (const auto &[place, weight] : m_consumedTokens[value])
+			{
+				tokens[place] -= weight;
+			}
+			for (const size_t place : m_resetPlaces[value])
+			{
+				tokens[place] = 0;
+			}
+			for (const auto &[place, weight] : m_producedTokens[value])
+			{
+				tokens[place] += weight;
+			}
+			++replayedRecords;
+		}
+		else
+		{
+			break;
+		}
+		position = next;
+	}
+
+	if (!hasCheckpoint)
+	{
+		throw JournalException(m_options.path, "has no checkpoint");
+	}
+	return replayedRecords;
+}
+
+void Journal::run(stop_token stopToken)
+{
+	vector<uint8_t> batch;
+	while (true)
+	{
+		unique_lock guard(m_mutex);
+		m_commitRequested.wait_for(guard, stopToken, m_options.commitInterval, [this] { return m_commitNow; });
+		if (stopToken.stop_requested() && m_pending.empty())
+		{
+			return;
+		}
+
+		batch.swap(m_pending);
+		const bool startsWithCheckpoint = exchange(m_pendingCheckpoint, false);
+		const uint64_t appendedRecords = m_appendedRecords;
+		const bool failed = m_error != nullptr;
+		m_commitNow = false;
+		guard.unlock();
+
+		// After a failure the records are discarded, the journal can no longer be recovered.
+		exception_ptr error;
+		if (!batch.empty() && !failed)
+		{
+			try
+			{
+				write(batch, startsWithCheckpoint);
+			}
+			catch (const JournalException &)
+			{
+				error = current_exception();
+			}
+		}
+		batch.clear();
+
+		guard.lock();
+		if (error)
+		{
+			m_error = error;
+		}
+		m_committedRecords = appendedRecords;
+		guard.unlock();
+		m_committed.notify_all();
+	}
+}
+
+void Journal::write(const vector<uint8_t> &batch, const bool startsWithCheckpoint)
+{
+	if (!startsWithCheckpoint)
+	{
+		writeFile(m_options.path, m_fileDescriptor, batch);
+		if (m_options.fsyncPolicy == JournalOptions::FsyncPolicy::ON_COMMIT)
+		{
+			syncFile(m_options.path, m_fileDescriptor);
+		}
+		return;
+	}
+
+	// The new file is complete and synchronized before it replaces the journal file, so that there is always a
+	// checkpoint to recover from.
+	const string temporaryPath = m_options.path + ".tmp";
+	const int fileDescriptor = openFile(temporaryPath);
+	try
+	{
+		writeFile(temporaryPath, fileDescriptor, getHeader());
+		writeFile(temporaryPath, fileDescriptor, batch);
+		syncFile(temporaryPath, fileDescriptor);
+		replaceFile(temporaryPath, m_options.path);
+	}
+	catch (const JournalException &)
+	{
+		closeFile(fileDescriptor);
+		throw;
+	}
+	closeFile(m_fileDescriptor);
+	m_fileDescriptor = fileDescriptor;
+}
+
+} // namespace ptne
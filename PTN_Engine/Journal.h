@@ -0,0 +1,215 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/MarkingSerializer.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Write-ahead journal of the changes of the marking of a net, used to recover it after a crash.
+//!
+//! The journal file starts with a header identifying the structure of the net and a checkpoint with the whole
+//! marking, followed by one record for each input token and each fired transition. Records are appended to a
+//! buffer in memory and written in batches by a background thread (group commit). Once enough records follow a
+//! checkpoint, a new checkpoint is written to a new file, which then replaces the journal file atomically.
+//!
+//! An input token is recorded before being added and a firing after the tokens are moved, so that in the order
+//! of the records every firing comes after the records of the tokens it consumed.
+//!
+class Journal final
+{
+public:
+	~Journal();
+
+	//!
+	//! \brief Journal constructor. The file is not read or written until recover is called.
+	//! \param options - Path, fsync policy and intervals of the journal.
+	//! \param places - The places of the net, in order of their names.
+	//! \param transitions - The transitions of the net, in order of their names.
+	//!
+	Journal(const JournalOptions &options,
+			std::vector<SharedPtrPlace> places,
+			const std::vector<SharedPtrTransition> &transitions);
+
+	Journal(const Journal &) = delete;
+	Journal(Journal &&) = delete;
+	Journal &operator=(const Journal &) = delete;
+	Journal &operator=(Journal &&) = delete;
+
+	//!
+	//! \brief Restore the marking recorded in the journal file, if it exists, and start a new file with a checkpoint
+	//! of the resulting marking. Firings must be prevented while it runs.
+	//! \return The number of records replayed after the last checkpoint.
+	//!
+	size_t recover();
+
+	//!
+	//! \brief Record a token added to an input place, and add it.
+	//! \param placeName - The name of the input place.
+	//! \param increment - Adds the token. Invalid increments throw from it without being recorded.
+	//!
+	void recordInput(const std::string &placeName, const std::function<void()> &increment);
+
+	//!
+	//! \brief Record the firing of a transition, after its tokens were moved.
+	//! \param transition - The fired transition.
+	//! \param firings - Number of times the transition fired, recorded as as many single firings.
+	//!
+	void recordFiring(const Transition &transition, const size_t firings = 1);
+
+	//!
+	//! \brief Indicates if enough records were made since the last checkpoint.
+	//! \return True if a checkpoint should be made.
+	//!
+	bool isCheckpointDue() const;
+
+	//!
+	//! \brief Record the whole marking, so that the preceding records can be discarded. Firings must be prevented
+	//! while it runs.
+	//! \param change - Change of the marking, made atomically with the checkpoint.
+	//!
+	void checkpoint(const std::function<void()> &change = {});
+
+	//!
+	//! \brief Wait until all the records made so far are written. Throws JournalException if a write failed.
+	//!
+	void sync();
+
+private:
+	//! Type of the records, stored as the first byte.
+	enum class RecordType : uint8_t
+	{
+		INPUT = 1,
+		FIRING = 2,
+		CHECKPOINT = 3
+	};
+
+	//!
+	//! \brief Append a record to the pending records. Requires m_mutex to be locked.
+	//! \param type - Type of the record.
+	//! \param value - Index of the place or transition, or size of the checkpoint.
+	//!
+	void append(const RecordType type, const size_t value);
+
+	//!
+	//! \brief Get the header of the journal file.
+	//! \return The header.
+	//!
+	std::vector<uint8_t> getHeader() const;
+
+	//!
+	//! \brief Replay the records of a journal file, from its last checkpoint.
+	//! \param bytes - The content of the file.
+	//! \param tokens - Receives the number of tokens of each place, in order of the place names.
+	//! \return The number of records replayed after the last checkpoint.
+	//!
+	size_t replay(const std::vector<uint8_t> &bytes, std::vector<size_t> &tokens) const;
+
+	//!
+	//! \brief Writer thread function.
+	//! \param stopToken - Signals the writer to write the pending records and terminate.
+	//!
+	void run(std::stop_token stopToken);
+
+	//!
+	//! \brief Write a batch of records to the journal file.
+	//! \param batch - The records.
+	//! \param startsWithCheckpoint - Whether the batch starts with a checkpoint, and replaces the file.
+	//!
+	void write(const std::vector<uint8_t> &batch, const bool startsWithCheckpoint);
+
+	//! Path, fsync policy and intervals of the journal.
+	const JournalOptions m_options;
+
+	//! Serializer of the marking, for the checkpoints.
+	const MarkingSerializer m_serializer;
+
+	//! Index of each place by name.
+	std::unordered_map<std::string, size_t> m_placeIndices;
+
+	//! Whether each place is an input place.
+	std::vector<bool> m_inputPlaces;
+
+	//! Index of each transition.
+	std::unordered_map<const Transition *, size_t> m_transitionIndices;
+
+	//! Places and number of tokens taken by each transition.
+	std::vector<std::vector<std::pair<size_t, size_t>>> m_consumedTokens;
+
+	//! Places and number of tokens given by each transition.
+	std::vector<std::vector<std::pair<size_t, size_t>>> m_producedTokens;
+
+	//! Places emptied by each transition.
+	std::vector<std::vector<size_t>> m_resetPlaces;
+
+	//! Places and number of tokens read by each transition.
+	std::vector<std::vector<std::pair<size_t, size_t>>> m_readTokens;
+
+	//! Protects the pending records and the commit book keeping.
+	mutable std::mutex m_mutex;
+
+	//! Records not yet taken by the writer.
+	std::vector<uint8_t> m_pending;
+
+	//! Whether the pending records start with a checkpoint.
+	bool m_pendingCheckpoint = false;
+
+	//! Number of records since the last checkpoint.
+	std::atomic<size_t> m_recordsSinceCheckpoint = 0;
+
+	//! Number of records made.
+	uint64_t m_appendedRecords = 0;
+
+	//! Number of records written.
+	uint64_t m_committedRecords = 0;
+
+	//! Whether the pending records must be written without waiting for the commit interval.
+	bool m_commitNow = false;
+
+	//! The first failed write, if any.
+	std::exception_ptr m_error;
+
+	//! File descriptor of the journal file, only used by the writer.
+	int m_fileDescriptor = -1;
+
+	//! Wakes up the writer before the commit interval expires.
+	std::condition_variable_any m_commitRequested;
+
+	//! Notifies sync calls that records were written.
+	std::condition_variable m_committed;
+
+	//! Writes the records in the background.
+	std::jthread m_writer;
+};
+
+} // namespace ptne
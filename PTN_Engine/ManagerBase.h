@@ -44,6 +44,15 @@ protected:
 		m_items.clear();
 	}
 
+	//!
+	//! \brief Removes an item from the container, if it exists.
+	//! \param itemName - Name of the item.
+	//!
+	void erase(const std::string &itemName)
+	{
+		m_items.erase(itemName);
+	}
+
 	bool contains(const std::string &itemName) const
 	{
 		return m_items.contains(itemName);
@@ -0,0 +1,194 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/MarkingSerializer.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include "PTN_Engine/Utilities/Varint.h"
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! Identifies the format of the snapshots, including its version.
+constexpr array<uint8_t, 5> formatTag{ 'P', 'T', 'N', 'M', 1 };
+
+//!
+//! \brief 64 bit FNV-1a hash, fed incrementally.
+//!
+class StructureHash final
+{
+public:
+	void add(const string_view text)
+	{
+		for (const char c : text)
+		{
+			addByte(static_cast<uint8_t>(c));
+		}
+		// Separates consecutive names.
+		addByte(0);
+	}
+
+	void add(uint64_t value)
+	{
+		for (size_t i = 0; i < sizeof(value); ++i, value >>= 8)
+		{
+			addByte(static_cast<uint8_t>(value));
+		}
+	}
+
+	uint64_t get() const
+	{
+		return m_hash;
+	}
+
+private:
+	void addByte(const uint8_t byte)
+	{
+		m_hash = (m_hash ^ byte) * 0x100000001b3;
+	}
+
+	uint64_t m_hash = 0xcbf29ce484222325;
+};
+
+uint64_t readVarint(const vector<uint8_t> &bytes, size_t &position)
+{
+	uint64_t value = 0;
+	if (!utility::readVarint(bytes, position, value))
+	{
+		throw InvalidSnapshotException("it is truncated");
+	}
+	return value;
+}
+
+} // namespace
+
+MarkingSerializer::~MarkingSerializer() = default;
+
+MarkingSerializer::MarkingSerializer(vector<SharedPtrPlace> places, const vector<SharedPtrTransition> &transitions)
+: m_places(std::move(places))
+{
+	StructureHash hash;
+	hash.add(m_places.size());
+	for (const SharedPtrPlace &place : m_places)
+	{
+		hash.add(place->getName());
+		hash.add(place->isInputPlace() ? 1 : 0);
+		// Unbounded places add nothing, so that the markings saved before capacities existed remain valid.
+		if (place->getCapacity() != 0)
+		{
+			hash.add(place->getCapacity());
+		}
+		m_initialMarking.push_back(place->getInitialNumberOfTokens());
+	}
+	hash.add(transitions.size());
+	for (const SharedPtrTransition &transition : transitions)
+	{
+		hash.add(transition->getName());
+		for (const vector<Arc> &arcs :
+			 { transition->getActivationArcs(), transition->getDestinationArcs(), transition->getInhibitorArcs(),
+			   transition->getResetArcs(), transition->getReadArcs() })
+		{
+			hash.add(arcs.size());
+			for (const Arc &arc : arcs)
+			{
+				hash.add(lockWeakPtr(arc.place)->getName());
+				hash.add(arc.weight);
+			}
+		}
+	}
+	m_structureHash = hash.get();
+}
+
+vector<uint8_t> MarkingSerializer::snapshot() const
+{
+	vector<uint8_t> bytes(formatTag.begin(), formatTag.end());
+	bytes.reserve(formatTag.size() + sizeof(m_structureHash) + 2 * (m_places.size() + 1));
+	for (size_t i = 0; i < sizeof(m_structureHash); ++i)
+	{
+		bytes.push_back(static_cast<uint8_t>(m_structureHash >> (8 * i)));
+	}
+	utility::writeVarint(bytes, m_places.size());
+	for (const SharedPtrPlace &place : m_places)
+	{
+		utility::writeVarint(bytes, place->getNumberOfTokens());
+	}
+	return bytes;
+}
+
+void MarkingSerializer::restore(const vector<uint8_t> &snapshot) const
+{
+	setMarking(read(snapshot));
+}
+
+vector<size_t> MarkingSerializer::read(const vector<uint8_t> &snapshot) const
+{
+	if (snapshot.size() < formatTag.size() + sizeof(m_structureHash) ||
+		!equal(formatTag.begin(), formatTag.end(), snapshot.begin()))
+	{
+		throw InvalidSnapshotException("it is not a marking snapshot");
+	}
+
+	size_t position = formatTag.size();
+	uint64_t structureHash = 0;
+	for (size_t i = 0; i < sizeof(structureHash); ++i)
+	{
+		structureHash |= static_cast<uint64_t>(snapshot[position++]) << (8 * i);
+	}
+	if (structureHash != m_structureHash || readVarint(snapshot, position) != m_places.size())
+	{
+		throw InvalidSnapshotException("it was taken from a net with another structure");
+	}
+
+	vector<size_t> tokens(m_places.size());
+	for (size_t &placeTokens : tokens)
+	{
+		placeTokens = readVarint(snapshot, position);
+	}
+	if (position != snapshot.size())
+	{
+		throw InvalidSnapshotException("it has unexpected trailing data");
+	}
+	return tokens;
+}
+
+void MarkingSerializer::setMarking(const vector<size_t> &tokens) const
+{
+	for (size_t i = 0; i < m_places.size(); ++i)
+	{
+		m_places[i]->setNumberOfTokens(tokens[i]);
+	}
+}
+
+void MarkingSerializer::resetMarking() const
+{
+	setMarking(m_initialMarking);
+}
+
+uint64_t MarkingSerializer::getStructureHash() const
+{
+	return m_structureHash;
+}
+
+} // namespace ptne
@@ -0,0 +1,103 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PlacesManager.h"
+#include "PTN_Engine/TransitionsManager.h"
+#include <cstdint>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Converts the marking of a net to and from a compact binary snapshot.
+//!
+//! The snapshot starts with a format tag and a hash of the structure of the net: the names of the places and
+//! transitions, the input places and the arcs with their weights. It is followed by the number of places and
+//! the number of tokens of each place, in order of the place names, as variable length integers. A snapshot can
+//! only be restored in a net with the same structure.
+//!
+class MarkingSerializer final
+{
+public:
+	~MarkingSerializer();
+
+	//!
+	//! \brief MarkingSerializer constructor.
+	//! \param places - The places of the net, in order of their names.
+	//! \param transitions - The transitions of the net, in order of their names.
+	//!
+	MarkingSerializer(std::vector<SharedPtrPlace> places, const std::vector<SharedPtrTransition> &transitions);
+
+	MarkingSerializer(const MarkingSerializer &) = delete;
+	MarkingSerializer(MarkingSerializer &&) = delete;
+	MarkingSerializer &operator=(const MarkingSerializer &) = delete;
+	MarkingSerializer &operator=(MarkingSerializer &&) = delete;
+
+	//!
+	//! \brief Take a snapshot of the current marking. Firings must be prevented while it is taken.
+	//! \return The snapshot.
+	//!
+	std::vector<uint8_t> snapshot() const;
+
+	//!
+	//! \brief Restore a marking. The snapshot is validated before any place is changed. Throws
+	//! InvalidSnapshotException if it is malformed or was taken from a net with another structure.
+	//! \param snapshot - The snapshot.
+	//!
+	void restore(const std::vector<uint8_t> &snapshot) const;
+
+	//!
+	//! \brief Read the marking of a snapshot, without changing the places. Throws InvalidSnapshotException if the
+	//! snapshot is malformed or was taken from a net with another structure.
+	//! \param snapshot - The snapshot.
+	//! \return The number of tokens of each place, in order of the place names.
+	//!
+	std::vector<size_t> read(const std::vector<uint8_t> &snapshot) const;
+
+	//!
+	//! \brief Set the number of tokens of every place.
+	//! \param tokens - The number of tokens of each place, in order of the place names.
+	//!
+	void setMarking(const std::vector<size_t> &tokens) const;
+
+	//!
+	//! \brief Set the number of tokens of every place back to the number it was created with.
+	//!
+	void resetMarking() const;
+
+	//!
+	//! \brief Get the hash of the structure of the net.
+	//! \return The hash.
+	//!
+	uint64_t getStructureHash() const;
+
+private:
+	//! The places of the net, in order of their names.
+	const std::vector<SharedPtrPlace> m_places;
+
+	//! Hash of the structure of the net.
+	uint64_t m_structureHash = 0;
+
+	//! The initial number of tokens of each place, in order of the place names.
+	std::vector<size_t> m_initialMarking;
+};
+
+} // namespace ptne
@@ -0,0 +1,129 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/MaximalStep.h"
+#include "PTN_Engine/Place.h"
+#include "PTN_Engine/Transition.h"
+#include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include <algorithm>
+#include <utility>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! Use of a place by a single transition.
+struct Demand
+{
+	size_t consumed = 0;
+	size_t read = 0;
+	size_t produced = 0;
+	bool inhibits = false;
+	bool resets = false;
+};
+
+} // namespace
+
+MaximalStep::~MaximalStep() = default;
+
+MaximalStep::MaximalStep() = default;
+
+bool MaximalStep::add(const SharedPtrTransition &transition)
+{
+	const TransitionArcs arcs = transition->getArcs();
+
+	vector<pair<SharedPtrPlace, Demand>> demands;
+	auto demandOf = [&demands](const Arc &arc) -> Demand &
+	{
+		SharedPtrPlace place = lockWeakPtr(arc.place);
+		auto it = ranges::find(demands, place, &pair<SharedPtrPlace, Demand>::first);
+		if (it == demands.end())
+		{
+			it = demands.emplace(demands.end(), std::move(place), Demand{});
+		}
+		return it->second;
+	};
+	for (const Arc &arc : arcs.activationArcs)
+	{
+		demandOf(arc).consumed = arc.weight;
+	}
+	for (const Arc &arc : arcs.readArcs)
+	{
+		demandOf(arc).read = arc.weight;
+	}
+	for (const Arc &arc : arcs.destinationArcs)
+	{
+		demandOf(arc).produced = arc.weight;
+	}
+	for (const Arc &arc : arcs.inhibitorArcs)
+	{
+		demandOf(arc).inhibits = true;
+	}
+	for (const Arc &arc : arcs.resetArcs)
+	{
+		demandOf(arc).resets = true;
+	}
+
+	vector<pair<const Place *, PlaceUsage>> usages;
+	usages.reserve(demands.size());
+	for (const auto &[place, demand] : demands)
+	{
+		const auto it = m_usages.find(place.get());
+		const bool isUsed = it != m_usages.end();
+		PlaceUsage usage = isUsed ? it->second : PlaceUsage{ .tokens = place->getNumberOfTokens() };
+
+		const bool readConflict = usage.consumed + demand.consumed + max(usage.read, demand.read) > usage.tokens;
+		const bool inhibitorConflict = (demand.inhibits && usage.produced) || (demand.produced != 0 && usage.inhibits);
+		const bool resetConflict = isUsed && (demand.resets || usage.reset);
+
+		// In the worst order, the transitions adding tokens to the place fire before the ones taking them.
+		usage.growth += demand.produced > demand.consumed ? demand.produced - demand.consumed : 0;
+		const size_t capacity = place->getCapacity();
+		const bool capacityConflict = capacity != 0 && usage.tokens + usage.growth > capacity;
+
+		if (readConflict || inhibitorConflict || resetConflict || capacityConflict)
+		{
+			return false;
+		}
+
+		usage.consumed += demand.consumed;
+		usage.read = max(usage.read, demand.read);
+		usage.produced |= demand.produced != 0;
+		usage.inhibits |= demand.inhibits;
+		usage.reset |= demand.resets;
+		usages.emplace_back(place.get(), usage);
+	}
+
+	for (const auto &[place, usage] : usages)
+	{
+		m_usages[place] = usage;
+	}
+	m_transitions.push_back(transition);
+	return true;
+}
+
+const vector<SharedPtrTransition> &MaximalStep::getTransitions() const
+{
+	return m_transitions;
+}
+
+} // namespace ptne
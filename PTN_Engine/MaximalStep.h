@@ -0,0 +1,96 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ptne
+{
+
+class Place;
+class Transition;
+
+using SharedPtrTransition = std::shared_ptr<Transition>;
+
+//!
+//! \brief Builds a maximal step: a set of enabled transitions that can all fire from the same marking, one after
+//! the other in any order.
+//!
+//! Transitions are offered in turn and added unless they conflict with the transitions already in the step. A
+//! transition conflicts with the step if together they take more tokens from a place than it has, or than it needs
+//! to keep for the read arcs, if one gives tokens to an inhibitor place of the other, if one resets a place the
+//! other uses, or if together they could exceed the capacity of a place. Once every enabled transition was
+//! offered, each transition left out conflicts with the step, which is therefore maximal.
+//! The number of tokens of each place is taken when the place is first used, so the marking must not change
+//! while the step is built.
+//!
+class MaximalStep final
+{
+public:
+	~MaximalStep();
+	MaximalStep();
+	MaximalStep(const MaximalStep &) = delete;
+	MaximalStep(MaximalStep &&) = delete;
+	MaximalStep &operator=(const MaximalStep &) = delete;
+	MaximalStep &operator=(MaximalStep &&) = delete;
+
+	//!
+	//! \brief Add a transition to the step, unless it conflicts with the step.
+	//! \param transition - An enabled transition.
+	//! \return True if the transition was added.
+	//!
+	bool add(const SharedPtrTransition &transition);
+
+	//!
+	//! \brief Get the transitions of the step.
+	//! \return The transitions, in the order they were added.
+	//!
+	const std::vector<SharedPtrTransition> &getTransitions() const;
+
+private:
+	//! Use of a place by the transitions of the step.
+	struct PlaceUsage
+	{
+		//! Number of tokens of the place before the step.
+		size_t tokens = 0;
+		//! Tokens taken by the transitions of the step.
+		size_t consumed = 0;
+		//! Largest weight of the read arcs of the step.
+		size_t read = 0;
+		//! Tokens given by the transitions of the step, beyond the ones each of them takes from the place.
+		size_t growth = 0;
+		//! Whether a transition of the step gives tokens to the place.
+		bool produced = false;
+		//! Whether a transition of the step has an inhibitor arc from the place.
+		bool inhibits = false;
+		//! Whether a transition of the step resets the place.
+		bool reset = false;
+	};
+
+	//! Use of the places by the transitions of the step.
+	std::unordered_map<const Place *, PlaceUsage> m_usages;
+
+	//! Transitions of the step.
+	std::vector<SharedPtrTransition> m_transitions;
+};
+
+} // namespace ptne
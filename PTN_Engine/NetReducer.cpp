@@ -0,0 +1,376 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/NetReducer.h"
+#include <algorithm>
+#include <map>
+#include <ranges>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//!
+//! \brief Get the arcs of a transition as place names and weights, in order of the place names.
+//! \param arcs - The arcs.
+//! \return The sorted place names and weights.
+//!
+vector<pair<string, size_t>> getSortedArcs(const vector<ArcProperties> &arcs)
+{
+	vector<pair<string, size_t>> sortedArcs;
+	ranges::transform(arcs, back_inserter(sortedArcs),
+					  [](const ArcProperties &arc) { return pair{ arc.placeName, arc.weight }; });
+	ranges::sort(sortedArcs);
+	return sortedArcs;
+}
+
+//!
+//! \brief Add an arc to a list of arcs, adding up the weights if the place is already in it.
+//! \param arcs - The list of arcs.
+//! \param arc - The arc.
+//!
+void mergeArc(vector<ArcProperties> &arcs, const ArcProperties &arc)
+{
+	const auto it = ranges::find(arcs, arc.placeName, &ArcProperties::placeName);
+	if (it != arcs.end())
+	{
+		it->weight += arc.weight;
+	}
+	else
+	{
+		arcs.push_back(arc);
+	}
+}
+
+} // namespace
+
+NetReducer::~NetReducer() = default;
+
+NetReducer::NetReducer(vector<PlaceProperties> placesProperties, vector<TransitionProperties> transitionsProperties)
+: m_places(std::move(placesProperties))
+, m_transitions(std::move(transitionsProperties))
+, m_removedPlaces(m_places.size(), false)
+, m_removedTransitions(m_transitions.size(), false)
+{
+	ranges::sort(m_places, {}, &PlaceProperties::name);
+	ranges::sort(m_transitions, {}, &TransitionProperties::name);
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		m_placeIndices[m_places[place].name] = place;
+	}
+}
+
+NetReductionResult NetReducer::reduce()
+{
+	// Each pass applies the rules to the nodes not changed by previous rules in the same pass, so that long chains
+	// are halved in each pass instead of shortened by one node.
+	bool changed = true;
+	while (changed)
+	{
+		index();
+		changed = removeIdleTransitions();
+		changed = fuseSerialChains() || changed;
+		changed = removeSelfLoopPlaces() || changed;
+		changed = removeSinkPlaces() || changed;
+		changed = removeDuplicatePlaces() || changed;
+	}
+
+	NetReductionResult result;
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		if (m_removedPlaces[place])
+		{
+			result.removedPlaces.push_back(m_places[place].name);
+		}
+	}
+	for (size_t transition = 0; transition < m_transitions.size(); ++transition)
+	{
+		if (m_removedTransitions[transition])
+		{
+			result.removedTransitions.push_back(m_transitions[transition].name);
+		}
+	}
+	return result;
+}
+
+vector<TransitionProperties> NetReducer::getTransitionsProperties() const
+{
+	vector<TransitionProperties> transitionsProperties;
+	for (size_t transition = 0; transition < m_transitions.size(); ++transition)
+	{
+		if (!m_removedTransitions[transition])
+		{
+			transitionsProperties.push_back(m_transitions[transition]);
+		}
+	}
+	return transitionsProperties;
+}
+
+void NetReducer::index()
+{
+	m_incidences.assign(m_places.size(), Incidence{});
+	for (size_t transition = 0; transition < m_transitions.size(); ++transition)
+	{
+		if (m_removedTransitions[transition])
+		{
+			continue;
+		}
+		const TransitionProperties &transitionProperties = m_transitions[transition];
+		for (const ArcProperties &arc : transitionProperties.activationArcs)
+		{
+			m_incidences[m_placeIndices.at(arc.placeName)].consumers.emplace_back(transition, arc.weight);
+		}
+		for (const ArcProperties &arc : transitionProperties.destinationArcs)
+		{
+			m_incidences[m_placeIndices.at(arc.placeName)].producers.emplace_back(transition, arc.weight);
+		}
+		for (const ArcProperties &arc : transitionProperties.inhibitorArcs)
+		{
+			m_incidences[m_placeIndices.at(arc.placeName)].tested = true;
+		}
+		for (const ArcProperties &arc : transitionProperties.readArcs)
+		{
+			m_incidences[m_placeIndices.at(arc.placeName)].tested = true;
+		}
+		for (const ArcProperties &arc : transitionProperties.resetArcs)
+		{
+			m_incidences[m_placeIndices.at(arc.placeName)].tested = true;
+		}
+	}
+	m_changedPlaces.assign(m_places.size(), false);
+	m_changedTransitions.assign(m_transitions.size(), false);
+}
+
+bool NetReducer::removeIdleTransitions()
+{
+	bool changed = false;
+	for (size_t transition = 0; transition < m_transitions.size(); ++transition)
+	{
+		const TransitionProperties &transitionProperties = m_transitions[transition];
+		if (m_removedTransitions[transition] || m_changedTransitions[transition] || isTransitionObservable(transition) ||
+			transitionProperties.activationArcs.empty() ||
+			getSortedArcs(transitionProperties.activationArcs) != getSortedArcs(transitionProperties.destinationArcs))
+		{
+			continue;
+		}
+
+		const bool isRemovable =
+		ranges::none_of(transitionProperties.activationArcs,
+						[this](const ArcProperties &arc)
+						{
+							const size_t place = m_placeIndices.at(arc.placeName);
+							return isObservable(place) || m_changedPlaces[place];
+						});
+		if (!isRemovable)
+		{
+			continue;
+		}
+
+		for (const ArcProperties &arc : transitionProperties.activationArcs)
+		{
+			m_changedPlaces[m_placeIndices.at(arc.placeName)] = true;
+		}
+		m_removedTransitions[transition] = true;
+		changed = true;
+	}
+	return changed;
+}
+
+bool NetReducer::fuseSerialChains()
+{
+	bool changed = false;
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		const Incidence &incidence = m_incidences[place];
+		if (m_removedPlaces[place] || isObservable(place) || incidence.tested ||
+			m_places[place].initialNumberOfTokens != 0 || incidence.producers.size() != 1 ||
+			incidence.consumers.size() != 1 || !isUnchanged(place))
+		{
+			continue;
+		}
+
+		const auto [producer, producedWeight] = incidence.producers.front();
+		const auto [consumer, consumedWeight] = incidence.consumers.front();
+		if (producer == consumer || producedWeight != consumedWeight || isTransitionObservable(consumer) ||
+			m_transitions[consumer].activationArcs.size() != 1)
+		{
+			continue;
+		}
+
+		// The consumer fires right after each firing of the producer, so the producer takes over its destinations.
+		TransitionProperties &producerProperties = m_transitions[producer];
+		vector<ArcProperties> destinationArcs;
+		for (const ArcProperties &arc : producerProperties.destinationArcs)
+		{
+			if (arc.placeName != m_places[place].name)
+			{
+				mergeArc(destinationArcs, arc);
+				continue;
+			}
+			for (ArcProperties consumerArc : m_transitions[consumer].destinationArcs)
+			{
+				consumerArc.transitionName = producerProperties.name;
+				mergeArc(destinationArcs, consumerArc);
+				m_changedPlaces[m_placeIndices.at(consumerArc.placeName)] = true;
+			}
+		}
+		producerProperties.destinationArcs = std::move(destinationArcs);
+
+		m_removedPlaces[place] = true;
+		m_changedPlaces[place] = true;
+		m_removedTransitions[consumer] = true;
+		m_changedTransitions[consumer] = true;
+		m_changedTransitions[producer] = true;
+		changed = true;
+	}
+	return changed;
+}
+
+bool NetReducer::removeSelfLoopPlaces()
+{
+	bool changed = false;
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		const Incidence &incidence = m_incidences[place];
+		if (m_removedPlaces[place] || isObservable(place) || incidence.tested || incidence.consumers.empty() ||
+			!isUnchanged(place))
+		{
+			continue;
+		}
+
+		vector<Connection> producers = incidence.producers;
+		vector<Connection> consumers = incidence.consumers;
+		ranges::sort(producers);
+		ranges::sort(consumers);
+		const size_t maxWeight = ranges::max(consumers | views::values);
+		if (producers == consumers && m_places[place].initialNumberOfTokens >= maxWeight)
+		{
+			removePlace(place);
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+bool NetReducer::removeSinkPlaces()
+{
+	bool changed = false;
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		const Incidence &incidence = m_incidences[place];
+		if (!m_removedPlaces[place] && !isObservable(place) && !incidence.tested && incidence.consumers.empty() &&
+			isUnchanged(place))
+		{
+			removePlace(place);
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+bool NetReducer::removeDuplicatePlaces()
+{
+	map<pair<vector<Connection>, vector<Connection>>, vector<size_t>> placesByConnections;
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		const Incidence &incidence = m_incidences[place];
+		if (m_removedPlaces[place] || isObservable(place) || incidence.tested || incidence.consumers.empty() ||
+			!isUnchanged(place))
+		{
+			continue;
+		}
+		vector<Connection> producers = incidence.producers;
+		vector<Connection> consumers = incidence.consumers;
+		ranges::sort(producers);
+		ranges::sort(consumers);
+		placesByConnections[{ std::move(producers), std::move(consumers) }].push_back(place);
+	}
+
+	bool changed = false;
+	for (const auto &[_, places] : placesByConnections)
+	{
+		const size_t keptPlace = *ranges::min_element(
+		places, {}, [this](const size_t place) { return m_places[place].initialNumberOfTokens; });
+		for (const size_t place : places)
+		{
+			if (place != keptPlace)
+			{
+				removePlace(place);
+				changed = true;
+			}
+		}
+	}
+	return changed;
+}
+
+void NetReducer::removePlace(const size_t place)
+{
+	const string &name = m_places[place].name;
+	const Incidence &incidence = m_incidences[place];
+	for (const auto &[transition, _] : incidence.producers)
+	{
+		erase_if(m_transitions[transition].destinationArcs,
+				 [&name](const ArcProperties &arc) { return arc.placeName == name; });
+		m_changedTransitions[transition] = true;
+	}
+	for (const auto &[transition, _] : incidence.consumers)
+	{
+		erase_if(m_transitions[transition].activationArcs,
+				 [&name](const ArcProperties &arc) { return arc.placeName == name; });
+		m_changedTransitions[transition] = true;
+	}
+	m_removedPlaces[place] = true;
+	m_changedPlaces[place] = true;
+}
+
+bool NetReducer::isUnchanged(const size_t place) const
+{
+	const Incidence &incidence = m_incidences[place];
+	auto isTransitionUnchanged = [this](const Connection &connection)
+	{ return !m_changedTransitions[connection.first]; };
+	return !m_changedPlaces[place] && ranges::all_of(incidence.producers, isTransitionUnchanged) &&
+		   ranges::all_of(incidence.consumers, isTransitionUnchanged);
+}
+
+bool NetReducer::isObservable(const size_t place) const
+{
+	const PlaceProperties &placeProperties = m_places[place];
+	return placeProperties.input || placeProperties.capacity != 0 || placeProperties.onEnterAction != nullptr ||
+		   placeProperties.onExitAction != nullptr || placeProperties.onEnterContextAction.function != nullptr ||
+		   placeProperties.onExitContextAction.function != nullptr ||
+		   !placeProperties.onEnterActionFunctionName.empty() || !placeProperties.onExitActionFunctionName.empty();
+}
+
+bool NetReducer::isTransitionObservable(const size_t transition) const
+{
+	const TransitionProperties &transitionProperties = m_transitions[transition];
+	return !transitionProperties.additionalConditions.empty() ||
+		   !transitionProperties.additionalContextConditions.empty() ||
+		   !transitionProperties.additionalConditionsNames.empty() || !transitionProperties.inhibitorArcs.empty() ||
+		   !transitionProperties.resetArcs.empty() || !transitionProperties.readArcs.empty() ||
+		   transitionProperties.requireNoActionsInExecution ||
+		   transitionProperties.minimumDelay != chrono::milliseconds::zero() ||
+		   transitionProperties.maximumDelay != chrono::milliseconds::zero() ||
+		   ranges::any_of(transitionProperties.destinationArcs, [this](const ArcProperties &arc)
+						  { return m_places[m_placeIndices.at(arc.placeName)].capacity != 0; });
+}
+
+} // namespace ptne
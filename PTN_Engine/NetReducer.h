@@ -0,0 +1,180 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Simplifies the structure of a net, described by its properties, without changing its observable
+//! behavior.
+//!
+//! Places with actions, places with a capacity and input places are observable, as are transitions with additional
+//! conditions, inhibitor, reset or read arcs, destination places with a capacity, firing windows or requiring no
+//! actions in execution. The other places and transitions are reduced by these rules, applied until none applies:
+//! - a transition whose activation arcs are the same as its destination arcs, only connected to places without
+//! actions, is removed, since firing it changes nothing;
+//! - an empty place with a single producing and a single consuming transition, where the consuming transition has
+//! no other activation arcs, is fused with the consuming transition into the producing transition;
+//! - a place only connected to transitions that give back the tokens they take, with enough tokens for all of
+//! them, is removed, since it never restricts a firing;
+//! - a place without consuming transitions is removed, since its tokens are never used;
+//! - a place with the same producing and consuming transitions, with the same weights, as another place with
+//! fewer or as many tokens is removed, since the other place restricts the same firings first.
+//!
+class NetReducer final
+{
+public:
+	~NetReducer();
+
+	//!
+	//! \brief NetReducer constructor.
+	//! \param placesProperties - The places of the net, with their current number of tokens.
+	//! \param transitionsProperties - The transitions of the net.
+	//!
+	NetReducer(std::vector<PlaceProperties> placesProperties, std::vector<TransitionProperties> transitionsProperties);
+
+	NetReducer(const NetReducer &) = delete;
+	NetReducer(NetReducer &&) = delete;
+	NetReducer &operator=(const NetReducer &) = delete;
+	NetReducer &operator=(NetReducer &&) = delete;
+
+	//!
+	//! \brief Apply the reduction rules until none applies.
+	//! \return The names of the removed places and transitions.
+	//!
+	NetReductionResult reduce();
+
+	//!
+	//! \brief Get the transitions that were not removed, with their arcs after the reduction.
+	//! \return The remaining transitions, in order of their names.
+	//!
+	std::vector<TransitionProperties> getTransitionsProperties() const;
+
+private:
+	//! Arc between a place and a transition, as transition index and weight.
+	using Connection = std::pair<size_t, size_t>;
+
+	//! Connections of a place.
+	struct Incidence
+	{
+		//! Transitions adding tokens to the place.
+		std::vector<Connection> producers;
+
+		//! Transitions taking tokens from the place.
+		std::vector<Connection> consumers;
+
+		//! Whether a transition has an inhibitor, reset or read arc from the place.
+		bool tested = false;
+	};
+
+	//!
+	//! \brief Rebuild the connections of the places, and clear the marks of the changed nodes.
+	//!
+	void index();
+
+	//!
+	//! \brief Remove the transitions that give back the tokens they take.
+	//! \return True if a transition was removed.
+	//!
+	bool removeIdleTransitions();
+
+	//!
+	//! \brief Fuse the chains of a producing transition, a place and a consuming transition.
+	//! \return True if a chain was fused.
+	//!
+	bool fuseSerialChains();
+
+	//!
+	//! \brief Remove the places whose tokens are always given back.
+	//! \return True if a place was removed.
+	//!
+	bool removeSelfLoopPlaces();
+
+	//!
+	//! \brief Remove the places whose tokens are never consumed.
+	//! \return True if a place was removed.
+	//!
+	bool removeSinkPlaces();
+
+	//!
+	//! \brief Remove the places that duplicate another place.
+	//! \return True if a place was removed.
+	//!
+	bool removeDuplicatePlaces();
+
+	//!
+	//! \brief Remove a place and its arcs.
+	//! \param place - Index of the place.
+	//!
+	void removePlace(const size_t place);
+
+	//!
+	//! \brief Check whether a place, its connections and their transitions were not changed since the last index.
+	//! \param place - Index of the place.
+	//! \return True if they were not changed.
+	//!
+	bool isUnchanged(const size_t place) const;
+
+	//!
+	//! \brief Check whether a place is observable.
+	//! \param place - Index of the place.
+	//! \return True if the place has actions, a capacity or is an input place.
+	//!
+	bool isObservable(const size_t place) const;
+
+	//!
+	//! \brief Check whether a transition is observable.
+	//! \param transition - Index of the transition.
+	//! \return True if the transition cannot be removed or fused.
+	//!
+	bool isTransitionObservable(const size_t transition) const;
+
+	//! The places, in order of their names.
+	std::vector<PlaceProperties> m_places;
+
+	//! The transitions, in order of their names.
+	std::vector<TransitionProperties> m_transitions;
+
+	//! Index of each place by name.
+	std::unordered_map<std::string, size_t> m_placeIndices;
+
+	//! Connections of each place, as of the last index.
+	std::vector<Incidence> m_incidences;
+
+	//! Whether each place was removed.
+	std::vector<bool> m_removedPlaces;
+
+	//! Whether each transition was removed.
+	std::vector<bool> m_removedTransitions;
+
+	//! Whether each place was changed since the last index.
+	std::vector<bool> m_changedPlaces;
+
+	//! Whether each transition was changed since the last index.
+	std::vector<bool> m_changedTransitions;
+};
+
+} // namespace ptne
@@ -40,6 +40,106 @@ PTN_Engine::EventLoopSleepDuration PTN_Engine::getEventLoopSleepDuration() const
 	return m_impProxy->getEventLoopSleepDuration();
 }
 
+void PTN_Engine::setEventLoopScheduler(const shared_ptr<EventLoopScheduler> &scheduler)
+{
+	m_impProxy->setEventLoopScheduler(scheduler);
+}
+
+shared_ptr<EventLoopScheduler> PTN_Engine::getEventLoopScheduler() const
+{
+	return m_impProxy->getEventLoopScheduler();
+}
+
+int PTN_Engine::getEventFileDescriptor() const
+{
+	return m_impProxy->getEventFileDescriptor();
+}
+
+size_t PTN_Engine::poll(const size_t maxSteps)
+{
+	return m_impProxy->poll(maxSteps);
+}
+
+SimulationResult PTN_Engine::simulate(const SimulationOptions &options)
+{
+	return m_impProxy->simulate(options);
+}
+
+StepResult PTN_Engine::step(const size_t maxFirings)
+{
+	return m_impProxy->step(maxFirings);
+}
+
+StepResult PTN_Engine::runFor(const chrono::nanoseconds duration)
+{
+	return m_impProxy->runFor(duration);
+}
+
+bool PTN_Engine::fireTransition(const string &transition)
+{
+	return m_impProxy->fireTransition(transition);
+}
+
+NetReductionResult PTN_Engine::reduceNet()
+{
+	return m_impProxy->reduceNet();
+}
+
+vector<uint8_t> PTN_Engine::snapshotMarking() const
+{
+	return m_impProxy->snapshotMarking();
+}
+
+void PTN_Engine::resetMarking()
+{
+	m_impProxy->resetMarking();
+}
+
+uint64_t PTN_Engine::getMarkingHash() const
+{
+	return m_impProxy->getMarkingHash();
+}
+
+void PTN_Engine::restoreMarking(const vector<uint8_t> &snapshot)
+{
+	m_impProxy->restoreMarking(snapshot);
+}
+
+size_t PTN_Engine::openJournal(const JournalOptions &options)
+{
+	return m_impProxy->openJournal(options);
+}
+
+void PTN_Engine::closeJournal()
+{
+	m_impProxy->closeJournal();
+}
+
+void PTN_Engine::syncJournal() const
+{
+	m_impProxy->syncJournal();
+}
+
+void PTN_Engine::startRecording()
+{
+	m_impProxy->startRecording();
+}
+
+ExecutionRecording PTN_Engine::stopRecording()
+{
+	return m_impProxy->stopRecording();
+}
+
+void PTN_Engine::replay(const ExecutionRecording &recording, const bool executeActions)
+{
+	m_impProxy->replay(recording, executeActions);
+}
+
+void PTN_Engine::setRandomSeed(const uint64_t seed)
+{
+	m_impProxy->setRandomSeed(seed);
+}
+
 void PTN_Engine::addArc(const ArcProperties &arcProperties)
 {
 	m_impProxy->addArc(arcProperties);
@@ -50,6 +150,11 @@ void PTN_Engine::removeArc(const ArcProperties &arcProperties)
 	m_impProxy->removeArc(arcProperties);
 }
 
+void PTN_Engine::updateStructure(const StructureUpdate &update)
+{
+	m_impProxy->updateStructure(update);
+}
+
 void PTN_Engine::clearNet()
 {
 	m_impProxy->clearNet();
@@ -80,11 +185,21 @@ void PTN_Engine::registerAction(const string &name, const ActionFunction &action
 	m_impProxy->registerAction(name, action);
 }
 
+void PTN_Engine::registerAction(const string &name, const ContextAction &action) const
+{
+	m_impProxy->registerAction(name, action);
+}
+
 void PTN_Engine::registerCondition(const string &name, const ConditionFunction &condition) const
 {
 	m_impProxy->registerCondition(name, condition);
 }
 
+void PTN_Engine::registerCondition(const string &name, const ContextCondition &condition) const
+{
+	m_impProxy->registerCondition(name, condition);
+}
+
 void PTN_Engine::execute(const bool log, ostream &o)
 {
 	m_impProxy->execute(log, o);
@@ -100,6 +215,18 @@ void PTN_Engine::incrementInputPlace(const string &place)
 	m_impProxy->incrementInputPlace(place);
 }
 
+bool PTN_Engine::incrementInputPlace(const string &place,
+									 const FULL_PLACE_POLICY policy,
+									 const chrono::milliseconds timeout)
+{
+	return m_impProxy->incrementInputPlace(place, policy, timeout);
+}
+
+bool PTN_Engine::tryIncrementInputPlace(const string &place)
+{
+	return m_impProxy->incrementInputPlace(place, FULL_PLACE_POLICY::DROP, chrono::milliseconds::zero());
+}
+
 void PTN_Engine::printState(ostream &o) const
 {
 	m_impProxy->printState(o);
@@ -115,6 +242,16 @@ PTN_Engine::ACTIONS_THREAD_OPTION PTN_Engine::getActionsThreadOption() const
 	return m_impProxy->getActionsThreadOption();
 }
 
+void PTN_Engine::setFiringSemantics(const FIRING_SEMANTICS firingSemantics)
+{
+	m_impProxy->setFiringSemantics(firingSemantics);
+}
+
+PTN_Engine::FIRING_SEMANTICS PTN_Engine::getFiringSemantics() const
+{
+	return m_impProxy->getFiringSemantics();
+}
+
 bool PTN_Engine::isEventLoopRunning() const
 {
 	return m_impProxy->isEventLoopRunning();
@@ -20,19 +20,85 @@
 
 #include "PTN_Engine/PTN_EngineImp.h"
 #include "PTN_Engine/Executor/ActionsExecutorFactory.h"
+#include "PTN_Engine/Executor/SuppressedActionsExecutor.h"
+#include "PTN_Engine/ExecutionRecorder.h"
+#include "PTN_Engine/MaximalStep.h"
+#include "PTN_Engine/NetReducer.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Simulator.h"
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
 #include <algorithm>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace ptne
 {
 using namespace std;
 using enum PTN_Engine::ACTIONS_THREAD_OPTION;
 
+namespace
+{
+//! Set while the event loop of this thread fires a transition, to detect calls from the actions.
+thread_local bool isFiringThread = false;
+
+//! Flags the current thread as firing a transition while in scope.
+class FiringThreadScope final
+{
+public:
+	FiringThreadScope()
+	{
+		isFiringThread = true;
+	}
+
+	~FiringThreadScope()
+	{
+		isFiringThread = false;
+	}
+
+	FiringThreadScope(const FiringThreadScope &) = delete;
+	FiringThreadScope(FiringThreadScope &&) = delete;
+	FiringThreadScope &operator=(const FiringThreadScope &) = delete;
+	FiringThreadScope &operator=(FiringThreadScope &&) = delete;
+};
+
+//! Suppresses the actions of the places while in scope, restoring the actions executor even if an exception is
+//! thrown.
+class ActionsSuppressor final
+{
+public:
+	ActionsSuppressor(PlacesManager &places, shared_ptr<IActionsExecutor> &actionsExecutor)
+	: m_places(places)
+	, m_actionsExecutor(actionsExecutor)
+	{
+		m_places.setActionsExecutor(m_suppressedActionsExecutor);
+	}
+
+	~ActionsSuppressor()
+	{
+		m_places.setActionsExecutor(m_actionsExecutor);
+	}
+
+	ActionsSuppressor(const ActionsSuppressor &) = delete;
+	ActionsSuppressor(ActionsSuppressor &&) = delete;
+	ActionsSuppressor &operator=(const ActionsSuppressor &) = delete;
+	ActionsSuppressor &operator=(ActionsSuppressor &&) = delete;
+
+private:
+	PlacesManager &m_places;
+	shared_ptr<IActionsExecutor> &m_actionsExecutor;
+	// The places only keep a weak pointer to the executor.
+	shared_ptr<IActionsExecutor> m_suppressedActionsExecutor = make_shared<SuppressedActionsExecutor>();
+};
+} // namespace
+
 PTN_EngineImp::PTN_EngineImp(PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption)
 : m_actionsThreadOption(actionsThreadOption)
 , m_actionsExecutor(ActionsExecutorFactory::createExecutor(actionsThreadOption))
 , m_eventLoop(*this)
 {
+	m_eventLoop.setExternalLoop(actionsThreadOption == EXTERNAL_LOOP);
 }
 
 PTN_EngineImp::~PTN_EngineImp()
@@ -42,7 +108,15 @@ PTN_EngineImp::~PTN_EngineImp()
 
 void PTN_EngineImp::clearInputPlaces()
 {
-	m_places.clearInputPlaces();
+	if (m_journal)
+	{
+		unique_lock firingGuard(m_firingMutex);
+		m_journal->checkpoint([this] { m_places.clearInputPlaces(); });
+	}
+	else
+	{
+		m_places.clearInputPlaces();
+	}
 	m_newInputReceived = false;
 }
 
@@ -52,36 +126,51 @@ void PTN_EngineImp::clearNet()
 	{
 		throw PTN_Exception("Cannot clear net while the event loop is running.");
 	}
+	unique_lock structureUpdateGuard(m_structureUpdateMutex);
+	throwIfStructureIsLocked();
 	m_transitions.clear();
 	m_places.clear();
+	resetMarkingSerializer();
 }
 
 void PTN_EngineImp::createTransition(const TransitionProperties &transitionProperties)
 {
-	createTransition(transitionProperties.name, transitionProperties.activationArcs,
-					 transitionProperties.destinationArcs, transitionProperties.inhibitorArcs,
-					 !transitionProperties.additionalConditionsNames.empty() ?
-					 m_conditions.getItems(transitionProperties.additionalConditionsNames) :
-					 createAnonymousConditions(transitionProperties.additionalConditions),
-					 transitionProperties.requireNoActionsInExecution);
-}
-
-void PTN_EngineImp::createPlace(PlaceProperties placeProperties)
-{
-	ActionFunction onEnterAction = placeProperties.onEnterAction;
-	if (!placeProperties.onEnterActionFunctionName.empty())
+	throwIfStructureIsLocked();
+	// if a transition with this name already exists in the net, throw an exception
+	if (m_transitions.contains(transitionProperties.name))
 	{
-		placeProperties.onEnterAction = m_actions.getItem(placeProperties.onEnterActionFunctionName);
+		throw PTN_Exception("Cannot create transition that already exists. Name: " + transitionProperties.name);
 	}
 
-	ActionFunction onExitAction = placeProperties.onExitAction;
-	if (!placeProperties.onExitActionFunctionName.empty())
 	{
-		placeProperties.onExitAction = m_actions.getItem(placeProperties.onExitActionFunctionName);
+		// Excludes the publication of structural updates, from the lookup of the linked places until the transition
+		// is inserted, so that they cannot be removed meanwhile. Actions called by a firing already hold the lock.
+		shared_lock firingGuard(m_firingMutex, defer_lock);
+		if (!isFiringThread)
+		{
+			firingGuard.lock();
+		}
+		SharedPtrTransition transition =
+		makeTransition(transitionProperties, [this](const string &place) { return m_places.getPlace(place); });
+		m_transitions.insert(transition);
 	}
+	resetMarkingSerializer();
+}
 
-	auto place = make_shared<Place>(placeProperties, m_actionsExecutor);
-	m_places.insert(place);
+void PTN_EngineImp::createPlace(PlaceProperties placeProperties)
+{
+	throwIfStructureIsLocked();
+	SharedPtrPlace place = makePlace(std::move(placeProperties));
+	{
+		// Excludes the publication of structural updates. Actions called by a firing already hold the lock.
+		shared_lock firingGuard(m_firingMutex, defer_lock);
+		if (!isFiringThread)
+		{
+			firingGuard.lock();
+		}
+		m_places.insert(place);
+	}
+	resetMarkingSerializer();
 }
 
 bool PTN_EngineImp::isEventLoopRunning() const
@@ -96,14 +185,40 @@ void PTN_EngineImp::stop() noexcept
 
 void PTN_EngineImp::registerAction(const string &name, const ActionFunction &action)
 {
+	if (m_contextActions.contains(name))
+	{
+		throw RepeatedFunctionException(name);
+	}
 	m_actions.addItem(name, action);
 }
 
+void PTN_EngineImp::registerAction(const string &name, const ContextAction &action)
+{
+	if (action.function == nullptr)
+	{
+		throw PTN_Exception("Context action function must be specified.");
+	}
+	if (m_actions.contains(name))
+	{
+		throw RepeatedFunctionException(name);
+	}
+	m_contextActions.addItem(name, action);
+}
+
 void PTN_EngineImp::registerCondition(const string &name, const ConditionFunction &condition)
 {
 	m_conditions.addItem(name, condition);
 }
 
+void PTN_EngineImp::registerCondition(const string &name, const ContextCondition &condition)
+{
+	if (condition.function == nullptr)
+	{
+		throw PTN_Exception("Context condition function must be specified.");
+	}
+	m_conditions.addItem(name, condition);
+}
+
 size_t PTN_EngineImp::getNumberOfTokens(const string &place) const
 {
 	return m_places.getNumberOfTokens(place);
@@ -111,9 +226,69 @@ size_t PTN_EngineImp::getNumberOfTokens(const string &place) const
 
 void PTN_EngineImp::incrementInputPlace(const string &place)
 {
-	m_places.incrementInputPlace(place);
+	incrementInputPlace(place, PTN_Engine::FULL_PLACE_POLICY::THROW, chrono::milliseconds::zero());
+}
+
+bool PTN_EngineImp::incrementInputPlace(const string &place,
+										const PTN_Engine::FULL_PLACE_POLICY policy,
+										const chrono::milliseconds timeout)
+{
+	using enum PTN_Engine::FULL_PLACE_POLICY;
+	const auto deadline = chrono::steady_clock::now() + timeout;
+	while (!addInputToken(place))
+	{
+		if (policy == THROW)
+		{
+			throw PlaceCapacityException(place);
+		}
+		if (policy == DROP)
+		{
+			return false;
+		}
+		if (isFiringThread)
+		{
+			throw PTN_Exception("Cannot wait for room in the place " + place + " while firing a transition.");
+		}
+		if (!m_places.getPlace(place)->waitForRoom(deadline))
+		{
+			return false;
+		}
+	}
 	m_newInputReceived = true;
 	m_eventLoop.notifyNewEvent();
+	return true;
+}
+
+bool PTN_EngineImp::addInputToken(const string &place)
+{
+	// Excludes the start and the end of a recording. For places with a capacity it also excludes the firings,
+	// which check the room in their destination places before moving the tokens. Actions called by a firing
+	// already hold the lock.
+	throwIfNotInputPlace(place);
+	const bool hasCapacity = m_places.getPlace(place)->getCapacity() != 0;
+	shared_lock sharedFiringGuard(m_firingMutex, defer_lock);
+	unique_lock uniqueFiringGuard(m_firingMutex, defer_lock);
+	if (!isFiringThread)
+	{
+		hasCapacity ? uniqueFiringGuard.lock() : sharedFiringGuard.lock();
+	}
+	if (hasCapacity && !m_places.getPlace(place)->hasRoomFor(1))
+	{
+		return false;
+	}
+	if (m_recorder)
+	{
+		m_recorder->recordInput(place);
+	}
+	if (m_journal)
+	{
+		m_journal->recordInput(place, [this, &place] { m_places.incrementInputPlace(place); });
+	}
+	else
+	{
+		m_places.incrementInputPlace(place);
+	}
+	return true;
 }
 
 void PTN_EngineImp::setActionsThreadOption(const PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption)
@@ -130,6 +305,7 @@ void PTN_EngineImp::setActionsThreadOption(const PTN_Engine::ACTIONS_THREAD_OPTI
 		return;
 	}
 
+	m_eventLoop.setExternalLoop(actionsThreadOption == EXTERNAL_LOOP);
 	m_actionsExecutor = ActionsExecutorFactory::createExecutor(actionsThreadOption);
 	m_actionsThreadOption = actionsThreadOption;
 
@@ -142,6 +318,20 @@ PTN_Engine::ACTIONS_THREAD_OPTION PTN_EngineImp::getActionsThreadOption() const
 	return m_actionsThreadOption;
 }
 
+void PTN_EngineImp::setFiringSemantics(const PTN_Engine::FIRING_SEMANTICS firingSemantics)
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot change the firing semantics while the event loop is running.");
+	}
+	m_firingSemantics = firingSemantics;
+}
+
+PTN_Engine::FIRING_SEMANTICS PTN_EngineImp::getFiringSemantics() const
+{
+	return m_firingSemantics;
+}
+
 void PTN_EngineImp::printState(ostream &o) const
 {
 	m_places.printState(o);
@@ -162,26 +352,510 @@ bool PTN_EngineImp::executeInt(const bool log, ostream &o)
 		printState(o);
 	}
 
+	if (getFiringSemantics() == PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP)
+	{
+		return fireMaximalStep() != 0;
+	}
+
 	for (const auto &transition : enabledTransitions())
 	{
-		if (auto enabledTransition = lockWeakPtr(transition))
+		if (auto enabledTransition = transition.lock())
 		{
-			firedAtLeastOneTransition |= enabledTransition->execute();
+			firedAtLeastOneTransition |= fire(*enabledTransition, true, true, numeric_limits<size_t>::max()) != 0;
 		}
 	}
 	return firedAtLeastOneTransition;
 }
 
+size_t PTN_EngineImp::poll(const size_t maxSteps)
+{
+	if (getActionsThreadOption() != EXTERNAL_LOOP)
+	{
+		throw PTN_Exception("Poll is only available in the EXTERNAL_LOOP mode.");
+	}
+	if (!isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot poll the net before calling execute.");
+	}
+
+	// Cleared before processing, so that events arriving in the meantime are not lost.
+	m_eventLoop.clearEvent();
+	const StepResult result = fireEnabledTransitions(maxSteps);
+	if (result.workRemaining)
+	{
+		m_eventLoop.notifyNewEvent();
+	}
+	return result.firedTransitions;
+}
+
+StepResult PTN_EngineImp::step(const size_t maxFirings)
+{
+	throwIfEventLoopIsRunning();
+	return fireEnabledTransitions(maxFirings);
+}
+
+StepResult PTN_EngineImp::runFor(const chrono::nanoseconds duration)
+{
+	throwIfEventLoopIsRunning();
+	return fireEnabledTransitions(numeric_limits<size_t>::max(), chrono::steady_clock::now() + duration);
+}
+
+bool PTN_EngineImp::fireTransition(const string &transition)
+{
+	throwIfEventLoopIsRunning();
+	if (!m_transitions.contains(transition))
+	{
+		throw InvalidNameException(transition);
+	}
+	return fire(*m_transitions.getTransition(transition), false) != 0;
+}
+
+NetReductionResult PTN_EngineImp::reduceNet()
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot reduce the net while the event loop is running.");
+	}
+	unique_lock structureUpdateGuard(m_structureUpdateMutex);
+	throwIfStructureIsLocked();
+
+	const vector<TransitionProperties> transitionsProperties = getTransitionsProperties();
+	NetReducer reducer(getPlacesProperties(), transitionsProperties);
+	NetReductionResult result = reducer.reduce();
+
+	for (const string &transition : result.removedTransitions)
+	{
+		m_transitions.erase(transition);
+	}
+	for (const TransitionProperties &reducedProperties : reducer.getTransitionsProperties())
+	{
+		const auto &properties =
+		*ranges::find(transitionsProperties, reducedProperties.name, &TransitionProperties::name);
+		const SharedPtrTransition transition = m_transitions.getTransition(reducedProperties.name);
+		replaceArcs(*transition, properties.activationArcs, reducedProperties.activationArcs,
+					ArcProperties::Type::ACTIVATION);
+		replaceArcs(*transition, properties.destinationArcs, reducedProperties.destinationArcs,
+					ArcProperties::Type::DESTINATION);
+	}
+	for (const string &place : result.removedPlaces)
+	{
+		m_places.erase(place);
+	}
+	resetMarkingSerializer();
+	return result;
+}
+
+vector<uint8_t> PTN_EngineImp::snapshotMarking() const
+{
+	if (isFiringThread)
+	{
+		throw PTN_Exception("Cannot take a snapshot of the marking while firing a transition.");
+	}
+	const shared_ptr<const MarkingSerializer> serializer = getMarkingSerializer();
+	unique_lock firingGuard(m_firingMutex);
+	return serializer->snapshot();
+}
+
+uint64_t PTN_EngineImp::getMarkingHash() const
+{
+	// The places update the hash atomically, so firings need not be excluded, only restores and structural
+	// updates. Actions and conditions called by a firing already hold the lock.
+	shared_lock firingGuard(m_firingMutex, defer_lock);
+	if (!isFiringThread)
+	{
+		firingGuard.lock();
+	}
+	return m_places.getMarkingHash();
+}
+
+void PTN_EngineImp::restoreMarking(const vector<uint8_t> &snapshot)
+{
+	if (isFiringThread)
+	{
+		throw PTN_Exception("Cannot restore the marking while firing a transition.");
+	}
+	const shared_ptr<const MarkingSerializer> serializer = getMarkingSerializer();
+	{
+		unique_lock firingGuard(m_firingMutex);
+		serializer->restore(snapshot);
+		if (m_journal)
+		{
+			m_journal->checkpoint();
+		}
+	}
+	// The restored marking may enable transitions.
+	setNewInputReceived(true);
+	m_eventLoop.notifyNewEvent();
+}
+
+void PTN_EngineImp::resetMarking()
+{
+	if (isFiringThread)
+	{
+		throw PTN_Exception("Cannot reset the marking while firing a transition.");
+	}
+	const shared_ptr<const MarkingSerializer> serializer = getMarkingSerializer();
+	{
+		unique_lock firingGuard(m_firingMutex);
+		serializer->resetMarking();
+		if (m_journal)
+		{
+			m_journal->checkpoint();
+		}
+	}
+	// The initial marking may enable transitions.
+	setNewInputReceived(true);
+	m_eventLoop.notifyNewEvent();
+}
+
+size_t PTN_EngineImp::openJournal(const JournalOptions &options)
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot open the journal while the event loop is running.");
+	}
+	if (m_journal)
+	{
+		throw PTN_Exception("The journal is already open.");
+	}
+
+	unique_lock firingGuard(m_firingMutex);
+	auto journal = make_unique<Journal>(options, m_places.getPlaces(), m_transitions.getTransitions());
+	const size_t replayedRecords = journal->recover();
+	m_journal = std::move(journal);
+	setNewInputReceived(true);
+	return replayedRecords;
+}
+
+void PTN_EngineImp::closeJournal()
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot close the journal while the event loop is running.");
+	}
+
+	unique_ptr<Journal> journal;
+	{
+		unique_lock firingGuard(m_firingMutex);
+		journal = std::move(m_journal);
+	}
+	if (journal)
+	{
+		journal->sync();
+	}
+}
+
+void PTN_EngineImp::syncJournal() const
+{
+	if (!m_journal)
+	{
+		throw PTN_Exception("The journal is not open.");
+	}
+	m_journal->sync();
+}
+
+void PTN_EngineImp::startRecording()
+{
+	if (isFiringThread)
+	{
+		throw PTN_Exception("Cannot start recording while firing a transition.");
+	}
+	const shared_ptr<const MarkingSerializer> serializer = getMarkingSerializer();
+	unique_lock firingGuard(m_firingMutex);
+	if (m_recorder)
+	{
+		throw PTN_Exception("The execution is already being recorded.");
+	}
+	m_recorder = make_unique<ExecutionRecorder>(serializer->snapshot());
+	m_isRecording = true;
+}
+
+ExecutionRecording PTN_EngineImp::stopRecording()
+{
+	if (isFiringThread)
+	{
+		throw PTN_Exception("Cannot stop recording while firing a transition.");
+	}
+	unique_ptr<ExecutionRecorder> recorder;
+	{
+		unique_lock firingGuard(m_firingMutex);
+		if (!m_recorder)
+		{
+			throw PTN_Exception("The execution is not being recorded.");
+		}
+		recorder = std::move(m_recorder);
+		m_isRecording = false;
+	}
+	return recorder->getRecording();
+}
+
+void PTN_EngineImp::replay(const ExecutionRecording &recording, const bool executeActions)
+{
+	throwIfEventLoopIsRunning();
+
+	// The names are resolved before changing the marking, firings then only cost a pointer access.
+	vector<SharedPtrTransition> transitions;
+	transitions.reserve(recording.events.size());
+	for (const RecordedEvent &event : recording.events)
+	{
+		if (event.type == RecordedEvent::Type::FIRING)
+		{
+			if (!m_transitions.contains(event.name))
+			{
+				throw InvalidNameException(event.name);
+			}
+			transitions.push_back(m_transitions.getTransition(event.name));
+		}
+		else
+		{
+			throwIfNotInputPlace(event.name);
+			transitions.push_back(nullptr);
+		}
+	}
+	restoreMarking(recording.initialMarking);
+
+	optional<ActionsSuppressor> actionsSuppressor;
+	if (!executeActions)
+	{
+		actionsSuppressor.emplace(m_places, m_actionsExecutor);
+	}
+	for (size_t i = 0; i < recording.events.size(); ++i)
+	{
+		if (!transitions[i])
+		{
+			incrementInputPlace(recording.events[i].name);
+		}
+		else if (!fire(*transitions[i], false, false))
+		{
+			throw ReplayDivergenceException(i, recording.events[i].name);
+		}
+	}
+}
+
+void PTN_EngineImp::setRandomSeed(const uint64_t seed)
+{
+	m_transitions.setRandomSeed(seed);
+}
+
+SimulationResult PTN_EngineImp::simulate(const SimulationOptions &options)
+{
+	throwIfEventLoopIsRunning();
+	if (m_isRecording)
+	{
+		throw PTN_Exception("Cannot simulate the net while the execution is being recorded.");
+	}
+
+	// The simulation fires transitions on its own, the journal records the resulting marking.
+	struct JournalCheckpointer
+	{
+		~JournalCheckpointer()
+		{
+			if (journal)
+			{
+				unique_lock firingGuard(firingMutex);
+				journal->checkpoint();
+			}
+		}
+		Journal *journal;
+		shared_mutex &firingMutex;
+	} journalCheckpointer{ m_journal.get(), m_firingMutex };
+
+	Simulator simulator(m_transitions.getTransitions(), options);
+	if (options.executeActions)
+	{
+		return simulator.run();
+	}
+
+	ActionsSuppressor actionsSuppressor(m_places, m_actionsExecutor);
+	return simulator.run();
+}
+
+StepResult PTN_EngineImp::fireEnabledTransitions(const size_t maxFirings, const chrono::steady_clock::time_point deadline)
+{
+	setNewInputReceived(false);
+
+	StepResult result;
+	bool firedInCycle = true;
+	bool budgetSpent = maxFirings == 0 || chrono::steady_clock::now() >= deadline;
+	const bool isMaximalStep = getFiringSemantics() == PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP;
+	while (firedInCycle && !budgetSpent)
+	{
+		firedInCycle = false;
+		if (isMaximalStep)
+		{
+			const size_t firings = fireMaximalStep();
+			result.firedTransitions += firings;
+			firedInCycle = firings != 0;
+			budgetSpent = result.firedTransitions >= maxFirings || chrono::steady_clock::now() >= deadline;
+			continue;
+		}
+		for (const auto &transition : enabledTransitions())
+		{
+			auto enabledTransition = transition.lock();
+			if (const size_t firings =
+				enabledTransition ? fire(*enabledTransition, true, true, maxFirings - result.firedTransitions) : 0;
+				firings != 0)
+			{
+				result.firedTransitions += firings;
+				firedInCycle = true;
+				budgetSpent = result.firedTransitions == maxFirings || chrono::steady_clock::now() >= deadline;
+				if (budgetSpent)
+				{
+					break;
+				}
+			}
+		}
+	}
+	result.workRemaining = firedInCycle && !enabledTransitions().empty();
+	return result;
+}
+
+size_t PTN_EngineImp::fire(Transition &transition,
+						   const bool checkFiringWindow,
+						   const bool checkConditions,
+						   const size_t maxFirings)
+{
+	size_t firings = 0;
+	{
+		shared_lock firingGuard(m_firingMutex);
+		FiringThreadScope firingThreadScope;
+		firings = fireInternal(transition, checkFiringWindow, checkConditions, maxFirings);
+	}
+
+	if (firings != 0)
+	{
+		checkpointIfDue();
+	}
+	return firings;
+}
+
+size_t PTN_EngineImp::fireInternal(Transition &transition,
+								   const bool checkFiringWindow,
+								   const bool checkConditions,
+								   const size_t maxFirings)
+{
+	const size_t firings = transition.execute(checkFiringWindow, checkConditions, maxFirings);
+	if (firings == 0)
+	{
+		return 0;
+	}
+	if (m_recorder)
+	{
+		m_recorder->recordFiring(transition, firings);
+	}
+	if (m_journal)
+	{
+		m_journal->recordFiring(transition, firings);
+	}
+	return firings;
+}
+
+size_t PTN_EngineImp::fireMaximalStep()
+{
+	size_t firedTransitions = 0;
+	{
+		// Held exclusively so that the marking the step was chosen from only changes by the firings of the step.
+		unique_lock firingGuard(m_firingMutex);
+		FiringThreadScope firingThreadScope;
+
+		// The additional conditions are evaluated before the step is chosen, so that a transition that cannot fire
+		// does not take tokens that a conflicting transition could use.
+		MaximalStep step;
+		for (const auto &transition : enabledTransitions())
+		{
+			if (auto enabledTransition = transition.lock(); enabledTransition && enabledTransition->canFire())
+			{
+				step.add(enabledTransition);
+			}
+		}
+
+		// The conditions are evaluated again as each transition fires, in case the actions of the previous firings
+		// of the step changed them.
+		for (const auto &transition : step.getTransitions())
+		{
+			firedTransitions += fireInternal(*transition, true, true, 1);
+		}
+	}
+
+	if (firedTransitions != 0)
+	{
+		checkpointIfDue();
+	}
+	return firedTransitions;
+}
+
+void PTN_EngineImp::checkpointIfDue()
+{
+	if (m_journal && m_journal->isCheckpointDue())
+	{
+		unique_lock firingGuard(m_firingMutex);
+		m_journal->checkpoint();
+	}
+}
+
+void PTN_EngineImp::throwIfStructureIsLocked() const
+{
+	if (m_journal)
+	{
+		throw PTN_Exception("Cannot change the structure of the net while the journal is open.");
+	}
+	if (m_isRecording)
+	{
+		throw PTN_Exception("Cannot change the structure of the net while the execution is being recorded.");
+	}
+}
+
+void PTN_EngineImp::throwIfNotInputPlace(const string &place) const
+{
+	if (!m_places.contains(place))
+	{
+		throw InvalidNameException(place);
+	}
+	if (!m_places.getPlace(place)->isInputPlace())
+	{
+		throw NotInputPlaceException(place);
+	}
+}
+
+void PTN_EngineImp::throwIfEventLoopIsRunning() const
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot step the net while the event loop is running.");
+	}
+}
+
 bool PTN_EngineImp::getNewInputReceived() const
 {
 	return m_newInputReceived;
 }
 
+optional<chrono::steady_clock::time_point> PTN_EngineImp::getNextFiringTime() const
+{
+	return m_transitions.getNextFiringTime();
+}
+
 void PTN_EngineImp::setNewInputReceived(const bool newInputReceived)
 {
 	m_newInputReceived = newInputReceived;
 }
 
+shared_ptr<const MarkingSerializer> PTN_EngineImp::getMarkingSerializer() const
+{
+	lock_guard guard(m_markingSerializerMutex);
+	if (!m_markingSerializer)
+	{
+		m_markingSerializer = make_shared<MarkingSerializer>(m_places.getPlaces(), m_transitions.getTransitions());
+	}
+	return m_markingSerializer;
+}
+
+void PTN_EngineImp::resetMarkingSerializer() const
+{
+	lock_guard guard(m_markingSerializerMutex);
+	m_markingSerializer.reset();
+}
+
 vector<weak_ptr<Transition>> PTN_EngineImp::enabledTransitions() const
 {
 	return m_transitions.collectEnabledTransitionsRandomly();
@@ -197,52 +871,215 @@ PTN_Engine::EventLoopSleepDuration PTN_EngineImp::getEventLoopSleepDuration() co
 	return m_eventLoop.getSleepDuration();
 }
 
-void PTN_EngineImp::addArc(const ArcProperties &arcProperties) const
+void PTN_EngineImp::setEventLoopScheduler(const shared_ptr<EventLoopScheduler> &scheduler)
 {
-	if (isEventLoopRunning())
+	m_eventLoop.setScheduler(scheduler);
+}
+
+shared_ptr<EventLoopScheduler> PTN_EngineImp::getEventLoopScheduler() const
+{
+	return m_eventLoop.getScheduler();
+}
+
+int PTN_EngineImp::getEventFileDescriptor() const
+{
+	return m_eventLoop.getEventFileDescriptor();
+}
+
+void PTN_EngineImp::addArc(const ArcProperties &arcProperties)
+{
+	updateStructure(StructureUpdate{ .addedArcs = { arcProperties } });
+}
+
+void PTN_EngineImp::removeArc(const ArcProperties &arcProperties)
+{
+	updateStructure(StructureUpdate{ .removedArcs = { arcProperties } });
+}
+
+void PTN_EngineImp::updateStructure(const StructureUpdate &update)
+{
+	if (isFiringThread)
+	{
+		throw PTN_Exception("Cannot update the structure of the net while firing a transition.");
+	}
+	unique_lock structureUpdateGuard(m_structureUpdateMutex);
+	throwIfStructureIsLocked();
+
+	// The new version of the structure is built aside, while the transitions keep firing.
+	unordered_map<string, SharedPtrTransition> removedTransitions;
+	for (const string &name : update.removedTransitions)
 	{
-		throw PTN_Exception("Cannot add arc while the event loop is running.");
+		if (!m_transitions.contains(name) || removedTransitions.contains(name))
+		{
+			throw InvalidNameException(name);
+		}
+		removedTransitions.emplace(name, m_transitions.getTransition(name));
 	}
 
-	if (!m_places.contains(arcProperties.placeName))
+	unordered_set<string> removedPlaces;
+	for (const string &name : update.removedPlaces)
 	{
-		throw PTN_Exception("The place " + arcProperties.placeName +
-							" must already exist in order to link to an arc.");
+		if (!m_places.contains(name) || !removedPlaces.insert(name).second)
+		{
+			throw InvalidNameException(name);
+		}
 	}
-	auto spPlace = m_places.getPlace(arcProperties.placeName);
 
-	if (!m_transitions.contains(arcProperties.transitionName))
+	unordered_map<string, SharedPtrPlace> newPlaces;
+	for (const PlaceProperties &placeProperties : update.places)
 	{
-		throw PTN_Exception("The transition " + arcProperties.transitionName +
-							" must already exist in order to link to an arc.");
+		if (m_places.contains(placeProperties.name) || newPlaces.contains(placeProperties.name))
+		{
+			throw RepeatedPlaceException(placeProperties.name);
+		}
+		newPlaces.emplace(placeProperties.name, makePlace(placeProperties));
 	}
 
-	auto spTransition = m_transitions.getTransition(arcProperties.transitionName);
-	spTransition->addArc(spPlace, arcProperties.type, arcProperties.weight);
-}
+	auto findPlace = [this, &newPlaces](const string &name) -> SharedPtrPlace
+	{
+		if (const auto it = newPlaces.find(name); it != newPlaces.end())
+		{
+			return it->second;
+		}
+		return m_places.getPlace(name);
+	};
+	auto getPlace = [&findPlace, &removedPlaces](const string &name)
+	{
+		if (removedPlaces.contains(name))
+		{
+			throw PTN_Exception("Cannot link to the place " + name + ", which is removed.");
+		}
+		return findPlace(name);
+	};
 
-void PTN_EngineImp::removeArc(const ArcProperties &arcProperties) const
-{
-	if (isEventLoopRunning())
+	unordered_map<string, SharedPtrTransition> newTransitions;
+	for (const TransitionProperties &transitionProperties : update.transitions)
 	{
-		throw PTN_Exception("Cannot remove arc while the event loop is running.");
+		const string &name = transitionProperties.name;
+		if ((m_transitions.contains(name) && !removedTransitions.contains(name)) || newTransitions.contains(name))
+		{
+			throw PTN_Exception("Cannot create transition that already exists. Name: " + name);
+		}
+		newTransitions.emplace(name, makeTransition(transitionProperties, getPlace));
 	}
 
-	if (!m_places.contains(arcProperties.placeName))
+	// The arcs of each transition are edited in a copy.
+	unordered_map<SharedPtrTransition, TransitionArcs> newArcs;
+	auto editArcs = [&](const ArcProperties &arcProperties, const string &operation, const auto &edit)
+	{
+		if (!newPlaces.contains(arcProperties.placeName) && !m_places.contains(arcProperties.placeName))
+		{
+			throw PTN_Exception("The place " + arcProperties.placeName + " must already exist in order to " +
+								operation + " an arc.");
+		}
+		const string &transitionName = arcProperties.transitionName;
+		SharedPtrTransition transition;
+		if (const auto it = newTransitions.find(transitionName); it != newTransitions.end())
+		{
+			transition = it->second;
+		}
+		else if (m_transitions.contains(transitionName) && !removedTransitions.contains(transitionName))
+		{
+			transition = m_transitions.getTransition(transitionName);
+		}
+		else
+		{
+			throw PTN_Exception("The transition " + transitionName + " must already exist in order to " + operation +
+								" an arc.");
+		}
+		auto it = newArcs.find(transition);
+		if (it == newArcs.end())
+		{
+			it = newArcs.emplace(transition, transition->getArcs()).first;
+		}
+		edit(it->second);
+	};
+	for (const ArcProperties &arcProperties : update.removedArcs)
 	{
-		throw PTN_Exception("The place " + arcProperties.placeName +
-							" must already exist in order to unlink an arc.");
+		editArcs(arcProperties, "unlink", [&](TransitionArcs &arcs)
+				 { arcs.removeArc(findPlace(arcProperties.placeName), arcProperties.type); });
+	}
+	for (const ArcProperties &arcProperties : update.addedArcs)
+	{
+		editArcs(arcProperties, "link to", [&](TransitionArcs &arcs)
+				 { arcs.addArc(getPlace(arcProperties.placeName), arcProperties.type, arcProperties.weight); });
 	}
-	auto spPlace = m_places.getPlace(arcProperties.placeName);
 
-	if (!m_transitions.contains(arcProperties.transitionName))
+	// Published between two firings. Each transition only exchanges its arcs with the new ones, and the removed
+	// transitions are retired, since a firing may still hold them.
 	{
-		throw PTN_Exception("The transition " + arcProperties.transitionName +
-							" must already exist in order to unlink an arc.");
+		unique_lock firingGuard(m_firingMutex);
+		for (const auto &[name, _] : newPlaces)
+		{
+			if (m_places.contains(name))
+			{
+				throw RepeatedPlaceException(name);
+			}
+		}
+		for (const auto &[name, _] : newTransitions)
+		{
+			if (m_transitions.contains(name) && !removedTransitions.contains(name))
+			{
+				throw PTN_Exception("Cannot create transition that already exists. Name: " + name);
+			}
+		}
+		// Checked here, since transitions created while the update was built may link the removed places.
+		if (!removedPlaces.empty())
+		{
+			for (const SharedPtrTransition &transition : m_transitions.getTransitions())
+			{
+				if (removedTransitions.contains(transition->getName()))
+				{
+					continue;
+				}
+				const auto it = newArcs.find(transition);
+				const TransitionArcs arcs = it != newArcs.end() ? it->second : transition->getArcs();
+				for (const vector<Arc> *arcsOfType : { &arcs.activationArcs, &arcs.destinationArcs, &arcs.inhibitorArcs,
+														&arcs.resetArcs, &arcs.readArcs })
+				{
+					for (const Arc &arc : *arcsOfType)
+					{
+						if (const string place = lockWeakPtr(arc.place)->getName(); removedPlaces.contains(place))
+						{
+							throw PTN_Exception("Cannot remove the place " + place +
+												", which is linked to the transition " + transition->getName() + ".");
+						}
+					}
+				}
+			}
+		}
+		for (auto &[transition, arcs] : newArcs)
+		{
+			transition->swapArcs(arcs);
+		}
+		for (const auto &[name, transition] : removedTransitions)
+		{
+			transition->retire();
+			m_transitions.erase(name);
+		}
+		for (const string &name : removedPlaces)
+		{
+			m_places.erase(name);
+		}
+		for (const auto &[_, place] : newPlaces)
+		{
+			m_places.insert(place);
+		}
+		for (const auto &[_, transition] : newTransitions)
+		{
+			m_transitions.insert(transition);
+		}
 	}
+	// The previous arcs, now in newArcs, and the removed transitions are released here, once no firing can be
+	// using them.
 
-	auto spTransition = m_transitions.getTransition(arcProperties.transitionName);
-	spTransition->removeArc(spPlace, arcProperties.type);
+	resetMarkingSerializer();
+	if (isEventLoopRunning())
+	{
+		// The update may have enabled transitions.
+		m_newInputReceived = true;
+		m_eventLoop.notifyNewEvent();
+	}
 }
 
 vector<PlaceProperties> PTN_EngineImp::getPlacesProperties() const
@@ -257,41 +1094,90 @@ vector<TransitionProperties> PTN_EngineImp::getTransitionsProperties() const
 
 // Private
 
-void PTN_EngineImp::createTransition(const string &name,
-                                     const vector<ArcProperties> &activationArcs,
-                                     const vector<ArcProperties> &destinationArcs,
-                                     const vector<ArcProperties> &inhibitorArcs,
-                                     const vector<pair<string, ConditionFunction>> &additionalConditions,
-                                     const bool requireNoActionsInExecution)
+SharedPtrPlace PTN_EngineImp::makePlace(PlaceProperties placeProperties) const
 {
-	// if a transition with this name already exists in the net, throw an exception
-	if (m_transitions.contains(name))
+	if (const string &name = placeProperties.onEnterActionFunctionName; m_contextActions.contains(name))
 	{
-		throw PTN_Exception("Cannot create transition that already exists. Name: " + name);
+		placeProperties.onEnterContextAction = m_contextActions.getItem(name);
+	}
+	else if (!name.empty())
+	{
+		placeProperties.onEnterAction = m_actions.getItem(name);
 	}
 
-	auto getArcsFromArcsProperties = [this](const vector<ArcProperties> &arcProperties)
+	if (const string &name = placeProperties.onExitActionFunctionName; m_contextActions.contains(name))
+	{
+		placeProperties.onExitContextAction = m_contextActions.getItem(name);
+	}
+	else if (!name.empty())
+	{
+		placeProperties.onExitAction = m_actions.getItem(name);
+	}
+
+	return make_shared<Place>(placeProperties, m_actionsExecutor);
+}
+
+SharedPtrTransition
+PTN_EngineImp::makeTransition(const TransitionProperties &transitionProperties,
+							  const function<SharedPtrPlace(const string &)> &getPlace) const
+{
+	auto getArcsFromArcsProperties = [&getPlace](const vector<ArcProperties> &arcProperties)
 	{
 		vector<Arc> arcs;
 		for (const auto &arcProperty : arcProperties)
 		{
-			arcs.emplace_back(m_places.getPlace(arcProperty.placeName), arcProperty.weight);
+			arcs.emplace_back(getPlace(arcProperty.placeName), arcProperty.weight);
 		}
 		return arcs;
 	};
 
-	m_transitions.insert(make_shared<Transition>(name, getArcsFromArcsProperties(activationArcs),
-												 getArcsFromArcsProperties(destinationArcs),
-												 getArcsFromArcsProperties(inhibitorArcs), additionalConditions,
-												 requireNoActionsInExecution));
+	return make_shared<Transition>(transitionProperties.name,
+								   getArcsFromArcsProperties(transitionProperties.activationArcs),
+								   getArcsFromArcsProperties(transitionProperties.destinationArcs),
+								   getArcsFromArcsProperties(transitionProperties.inhibitorArcs),
+								   !transitionProperties.additionalConditionsNames.empty() ?
+								   m_conditions.getItems(transitionProperties.additionalConditionsNames) :
+								   createAnonymousConditions(transitionProperties.additionalConditions,
+															 transitionProperties.additionalContextConditions),
+								   transitionProperties.requireNoActionsInExecution, transitionProperties.minimumDelay,
+								   transitionProperties.maximumDelay,
+								   getArcsFromArcsProperties(transitionProperties.resetArcs),
+								   getArcsFromArcsProperties(transitionProperties.readArcs),
+								   transitionProperties.batchFiring);
+}
+
+void PTN_EngineImp::replaceArcs(Transition &transition,
+								const vector<ArcProperties> &arcs,
+								const vector<ArcProperties> &newArcs,
+								const ArcProperties::Type type) const
+{
+	auto isSameArc = [](const ArcProperties &arc, const ArcProperties &newArc)
+	{ return arc.placeName == newArc.placeName && arc.weight == newArc.weight; };
+	if (ranges::equal(arcs, newArcs, isSameArc))
+	{
+		return;
+	}
+
+	// Arcs are removed and added back in the new order, which is the order in which the actions are triggered.
+	for (const ArcProperties &arc : arcs)
+	{
+		transition.removeArc(m_places.getPlace(arc.placeName), type);
+	}
+	for (const ArcProperties &arc : newArcs)
+	{
+		transition.addArc(m_places.getPlace(arc.placeName), type, arc.weight);
+	}
 }
 
-vector<pair<string, ConditionFunction>>
-PTN_EngineImp::createAnonymousConditions(const vector<ConditionFunction> &conditions) const
+vector<pair<string, Condition>>
+PTN_EngineImp::createAnonymousConditions(const vector<ConditionFunction> &conditions,
+										 const vector<ContextCondition> &contextConditions) const
 {
-	vector<pair<string, ConditionFunction>> anonymousConditionsVector;
+	vector<pair<string, Condition>> anonymousConditionsVector;
 	ranges::transform(conditions, back_inserter(anonymousConditionsVector),
-					  [](const auto &condition) { return pair<string, ConditionFunction>("", condition); });
+					  [](const auto &condition) { return pair<string, Condition>("", condition); });
+	ranges::transform(contextConditions, back_inserter(anonymousConditionsVector),
+					  [](const auto &condition) { return pair<string, Condition>("", condition); });
 	return anonymousConditionsVector;
 }
 
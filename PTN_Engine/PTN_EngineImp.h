@@ -20,14 +20,21 @@
 
 #pragma once
 
+#include "PTN_Engine/Condition.h"
 #include "PTN_Engine/EventLoop.h"
+#include "PTN_Engine/ExecutionRecorder.h"
 #include "PTN_Engine/IPTN_EngineEL.h"
+#include "PTN_Engine/Journal.h"
 #include "PTN_Engine/ManagedContainer.h"
+#include "PTN_Engine/MarkingSerializer.h"
 #include "PTN_Engine/PTN_Engine.h"
 #include "PTN_Engine/Place.h"
 #include "PTN_Engine/PlacesManager.h"
 #include "PTN_Engine/TransitionsManager.h"
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
 #include <shared_mutex>
 
 namespace ptne
@@ -63,13 +70,24 @@ public:
 	//!
 	bool getNewInputReceived() const override;
 
-	void addArc(const ArcProperties &arcProperties) const;
+	//!
+	//! \brief Get the earliest time at which a timed transition waiting for its minimum delay can fire.
+	//! \return The earliest firing time, or nothing if no timed transition is waiting.
+	//!
+	std::optional<std::chrono::steady_clock::time_point> getNextFiringTime() const override;
+
+	void addArc(const ArcProperties &arcProperties);
 
 	//!
 	//! Clear the token counter from all input places.
 	//!
 	void clearInputPlaces();
 
+	//!
+	//! \brief Write the pending records of the journal and close it.
+	//!
+	void closeJournal();
+
 	void clearNet();
 
 	void createPlace(PlaceProperties placeProperties);
@@ -95,6 +113,24 @@ public:
 	//!
 	PTN_Engine::EventLoopSleepDuration getEventLoopSleepDuration() const;
 
+	//!
+	//! \brief Get how the enabled transitions are fired.
+	//! \return The firing semantics.
+	//!
+	PTN_Engine::FIRING_SEMANTICS getFiringSemantics() const;
+
+	//!
+	//! \brief Gets the scheduler running the event loop.
+	//! \return The scheduler, or nullptr if the event loop runs in a dedicated thread.
+	//!
+	std::shared_ptr<EventLoopScheduler> getEventLoopScheduler() const;
+
+	//!
+	//! \brief Get the event file descriptor signaling pending work to an external event loop.
+	//! \return The event file descriptor.
+	//!
+	int getEventFileDescriptor() const;
+
 	//!
 	//! Return the number of tokens in a given place.
 	//! \param place The name of the place to get the number of tokens from.
@@ -107,13 +143,38 @@ public:
 	std::vector<TransitionProperties> getTransitionsProperties() const;
 
 	//!
-	//! Add a token in an input place.
+	//! Add a token in an input place. Throws PlaceCapacityException if the place is at its capacity.
 	//! \param place Name of the place to be incremented.
 	//!
 	void incrementInputPlace(const std::string &place);
 
+	//!
+	//! \brief Add a token in an input place, applying a policy if the place is at its capacity.
+	//! \param place - Name of the place to be incremented.
+	//! \param policy - What to do if the place is full.
+	//! \param timeout - Maximum time to wait for room with the BLOCK policy.
+	//! \return Whether the token was added.
+	//!
+	bool incrementInputPlace(const std::string &place,
+							 const PTN_Engine::FULL_PLACE_POLICY policy,
+							 const std::chrono::milliseconds timeout);
+
 	bool isEventLoopRunning() const;
 
+	//!
+	//! \brief Start recording the changes of the marking in a journal, after recovering the marking it records.
+	//! \param options - Path, fsync policy and intervals of the journal.
+	//! \return The number of records replayed after the last checkpoint.
+	//!
+	size_t openJournal(const JournalOptions &options);
+
+	//!
+	//! \brief Process the pending work of the net, when driven by an external event loop.
+	//! \param maxSteps - Maximum number of transitions to be fired.
+	//! \return The number of fired transitions.
+	//!
+	size_t poll(const size_t maxSteps);
+
 	//!
 	//! Print the petri net places and number of tokens.
 	//! \param o Output stream.
@@ -127,6 +188,13 @@ public:
 	//!
 	void registerAction(const std::string &name, const ActionFunction &action);
 
+	//!
+	//! Register an action receiving the context of the call.
+	//! \param name The name of the action.
+	//! \param action The function to be called, with its user data.
+	//!
+	void registerAction(const std::string &name, const ContextAction &action);
+
 	//!
 	//! Register a condition
 	//! \param name The name of the condition
@@ -134,17 +202,128 @@ public:
 	//!
 	void registerCondition(const std::string &name, const ConditionFunction &condition);
 
-	void removeArc(const ArcProperties &arcProperties) const;
+	//!
+	//! Register a condition made of a function pointer and a user pointer.
+	//! \param name The name of the condition
+	//! \param condition The function to be called, with its user data.
+	//!
+	void registerCondition(const std::string &name, const ContextCondition &condition);
+
+	void removeArc(const ArcProperties &arcProperties);
+
+	//!
+	//! \brief Build the places, transitions and arcs of an update and publish them together, between two firings.
+	//! \param update - The changes to the structure of the net.
+	//!
+	void updateStructure(const StructureUpdate &update);
+
+	//!
+	//! \brief Re-execute a recorded execution in the calling thread.
+	//! \param recording - The recorded execution.
+	//! \param executeActions - Whether the actions of the places are executed.
+	//!
+	void replay(const ExecutionRecording &recording, const bool executeActions);
+
+	//!
+	//! \brief Run the net in the calling thread until no transition is enabled or a time budget is spent.
+	//! \param duration - Time budget.
+	//! \return The number of fired transitions and whether there is remaining work.
+	//!
+	StepResult runFor(const std::chrono::nanoseconds duration);
+
+	//!
+	//! \brief Fire a given transition in the calling thread, if it is enabled and its additional conditions hold.
+	//! \param transition - The name of the transition.
+	//! \return True if the transition was fired.
+	//!
+	bool fireTransition(const std::string &transition);
+
+	//!
+	//! \brief Fuse and remove the places and transitions without observable effects.
+	//! \return The names of the removed places and transitions.
+	//!
+	NetReductionResult reduceNet();
+
+	//!
+	//! \brief Restore a marking taken with snapshotMarking. Waits for the transition being fired, if any.
+	//! \param snapshot - The snapshot.
+	//!
+	void restoreMarking(const std::vector<uint8_t> &snapshot);
+
+	//!
+	//! \brief Set every place back to its initial number of tokens. Waits for the transition being fired, if any.
+	//!
+	void resetMarking();
+
+	//!
+	//! \brief Take a snapshot of the marking. Waits for the transition being fired, if any.
+	//! \return The snapshot.
+	//!
+	std::vector<uint8_t> snapshotMarking() const;
+
+	//!
+	//! \brief Get the hash of the marking, without waiting for the transition being fired, if any.
+	//! \return The hash of the marking.
+	//!
+	uint64_t getMarkingHash() const;
+
+	//!
+	//! \brief Seed the generator that orders the enabled transitions.
+	//! \param seed - The seed.
+	//!
+	void setRandomSeed(const uint64_t seed);
+
+	//!
+	//! \brief Start recording the input tokens and the fired transitions.
+	//!
+	void startRecording();
+
+	//!
+	//! \brief Stop recording.
+	//! \return The recorded execution.
+	//!
+	ExecutionRecording stopRecording();
 
 	//! Specify the thread where the actions should be run.
 	void setActionsThreadOption(const PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption);
 
+	//!
+	//! \brief Set the scheduler whose threads run the event loop.
+	//! \param scheduler - Scheduler shared with other engines. nullptr sets back a dedicated thread.
+	//!
+	void setEventLoopScheduler(const std::shared_ptr<EventLoopScheduler> &scheduler);
+
 	//!
 	//! \brief Set the sleep duration of the event loop.
 	//! \param sleepDuration - Time the event loop takes until it checks for new inputs.
 	//!
 	void setEventLoopSleepDuration(const PTN_Engine::EventLoopSleepDuration sleepDuration);
 
+	//!
+	//! \brief Set how the enabled transitions are fired. Throws PTN_Exception if the event loop is running.
+	//! \param firingSemantics - The firing semantics.
+	//!
+	void setFiringSemantics(const PTN_Engine::FIRING_SEMANTICS firingSemantics);
+
+	//!
+	//! \brief Simulate the net in virtual time, in the calling thread.
+	//! \param options - Configuration of the simulation.
+	//! \return Statistics of the simulation.
+	//!
+	SimulationResult simulate(const SimulationOptions &options);
+
+	//!
+	//! \brief Wait until the records of the journal made so far are written.
+	//!
+	void syncJournal() const;
+
+	//!
+	//! \brief Run the net in the calling thread until no transition is enabled or a number of transitions were fired.
+	//! \param maxFirings - Maximum number of transitions to be fired.
+	//! \return The number of fired transitions and whether there is remaining work.
+	//!
+	StepResult step(const size_t maxFirings);
+
 	//!
 	//! \brief Stop the execution of the petri net.
 	//!
@@ -159,30 +338,117 @@ private:
 	//!
 	bool executeInt(const bool log = false, std::ostream &o = std::cout) override;
 
+	//!
+	//! \brief Fire the enabled transitions until no transition is enabled, a maximum number of firings is reached or
+	//! a deadline expires. With the maximal step semantics, the budget is checked between steps, so the last step is
+	//! fired as a whole even if it exceeds the maximum number of firings.
+	//! \param maxFirings - Maximum number of transitions to be fired.
+	//! \param deadline - Time after which no more transitions are fired.
+	//! \return The number of fired transitions and whether there are still enabled transitions.
+	//!
+	StepResult fireEnabledTransitions(const size_t maxFirings,
+									  const std::chrono::steady_clock::time_point deadline =
+									  std::chrono::steady_clock::time_point::max());
+
+	//!
+	//! \brief Fire a transition, recording it in the journal if it is open.
+	//! \param transition - The transition.
+	//! \param checkFiringWindow - Whether the firing window of the transition is checked.
+	//! \param checkConditions - Whether the additional conditions and the actions in execution are checked.
+	//! \param maxFirings - Maximum number of firings of a batch firing transition.
+	//! \return The number of times the transition fired.
+	//!
+	size_t fire(Transition &transition,
+				const bool checkFiringWindow = true,
+				const bool checkConditions = true,
+				const size_t maxFirings = 1);
+
+	//!
+	//! \brief Fire a transition, recording it in the journal if it is open. Requires m_firingMutex to be locked.
+	//! \param transition - The transition.
+	//! \param checkFiringWindow - Whether the firing window of the transition is checked.
+	//! \param checkConditions - Whether the additional conditions and the actions in execution are checked.
+	//! \param maxFirings - Maximum number of firings of a batch firing transition.
+	//! \return The number of times the transition fired.
+	//!
+	size_t fireInternal(Transition &transition,
+						const bool checkFiringWindow,
+						const bool checkConditions,
+						const size_t maxFirings);
+
+	//!
+	//! \brief Fire a maximal set of enabled transitions that do not conflict with each other. No other firing, nor
+	//! copy of the marking, takes place while the step is fired.
+	//! \return The number of fired transitions.
+	//!
+	size_t fireMaximalStep();
+
+	//!
+	//! \brief Write a checkpoint of the journal, if it is open and a checkpoint is due.
+	//!
+	void checkpointIfDue();
+
+	//!
+	//! \brief Throw if the event loop is running, since the net cannot be stepped concurrently with it.
+	//!
+	void throwIfEventLoopIsRunning() const;
+
+	//!
+	//! \brief Throw if the journal is open or the execution is being recorded, since they record the marking of a
+	//! net with a fixed structure.
+	//!
+	void throwIfStructureIsLocked() const;
+
+	//!
+	//! \brief Throw if a place does not exist or is not an input place.
+	//! \param place - The name of the place.
+	//!
+	void throwIfNotInputPlace(const std::string &place) const;
+
+	//!
+	//! \brief Add a token in an input place, recording it, if the place has room for it.
+	//! \param place - Name of the place to be incremented.
+	//! \return Whether the token was added.
+	//!
+	bool addInputToken(const std::string &place);
+
+	//!
+	//! \brief Replace the arcs of a given type of a transition, if they changed.
+	//! \param transition - The transition.
+	//! \param arcs - The current arcs.
+	//! \param newArcs - The new arcs.
+	//! \param type - The type of the arcs.
+	//!
+	void replaceArcs(Transition &transition,
+					 const std::vector<ArcProperties> &arcs,
+					 const std::vector<ArcProperties> &newArcs,
+					 const ArcProperties::Type type) const;
+
 	//!
 	//! \brief createAnonymousConditions - Create activation conditions without proiding a name.
 	//! \param conditions
+	//! \param contextConditions - Conditions made of a function pointer and a user pointer.
 	//! \return
 	//!
-	std::vector<std::pair<std::string, ConditionFunction>>
-	createAnonymousConditions(const std::vector<ConditionFunction> &conditions) const;
+	std::vector<std::pair<std::string, Condition>>
+	createAnonymousConditions(const std::vector<ConditionFunction> &conditions,
+							  const std::vector<ContextCondition> &contextConditions) const;
+
+	//!
+	//! \brief Create a place, without adding it to the net.
+	//! \param placeProperties - Properties of the place. The actions are looked up by name if named.
+	//! \return The new place.
+	//!
+	SharedPtrPlace makePlace(PlaceProperties placeProperties) const;
 
 	//!
-	//! \brief Create a new transition in the petri net.
-	//! \param name - name of the transition
-	//! \param activationArcs
-	//! \param destinationArcs
-	//! \param inhibitorArcs
-	//! \param additionalConditions - boolean functions that provide additional conditions, necessary to fire a
-	//! transition. \param requireNoActionsInExecution - flag that determines if the on enter actions of each
-	//! activation place, must have finished before fireing the transition.
+	//! \brief Create a transition, without adding it to the net.
+	//! \param transitionProperties - Properties of the transition. The conditions are looked up by name if named.
+	//! \param getPlace - Gets the places linked by the arcs of the transition.
+	//! \return The new transition.
 	//!
-	void createTransition(const std::string &name,
-						  const std::vector<ArcProperties> &activationArcs,
-						  const std::vector<ArcProperties> &destinationArcs,
-						  const std::vector<ArcProperties> &inhibitorArcs,
-						  const std::vector<std::pair<std::string, ConditionFunction>> &additionalConditions,
-						  const bool requireNoActionsInExecution);
+	SharedPtrTransition makeTransition(const TransitionProperties &transitionProperties,
+									   const std::function<SharedPtrPlace(const std::string &)> &getPlace) const;
 
 	//!
 	//! \brief Flags or clears flag of new tokens in input places.
@@ -190,9 +456,23 @@ private:
 	//!
 	void setNewInputReceived(const bool newInputReceived);
 
+	//!
+	//! \brief Get the serializer of the marking, creating it if the structure of the net changed.
+	//! \return The serializer of the marking.
+	//!
+	std::shared_ptr<const MarkingSerializer> getMarkingSerializer() const;
+
+	//!
+	//! \brief Discard the serializer of the marking, after a change in the structure of the net.
+	//!
+	void resetMarkingSerializer() const;
+
 	//! Container with all the actions available to this Petri net.
 	ManagedContainer<ActionFunction> m_actions;
 
+	//! Container with the actions receiving a context, sharing their names with m_actions.
+	ManagedContainer<ContextAction> m_contextActions;
+
 	//! Executes the actions associated to each place, when tokens enter or exit them.z
 	std::shared_ptr<IActionsExecutor> m_actionsExecutor;
 
@@ -202,15 +482,41 @@ private:
 	//! Mutex to synchronize m_actionsThreadOption.
 	mutable std::shared_mutex m_actionsThreadOptionMutex;
 
+	//! How the enabled transitions are fired.
+	std::atomic<PTN_Engine::FIRING_SEMANTICS> m_firingSemantics = PTN_Engine::FIRING_SEMANTICS::INTERLEAVING;
+
 	//! Conditions that can be used by the Petri net.
-	ManagedContainer<ConditionFunction> m_conditions;
+	ManagedContainer<Condition> m_conditions;
 
 	//! Loop that processes events and executes the Petri net.
 	EventLoop m_eventLoop;
 
+	//! Held shared by the event loop while it fires a transition and exclusively while the marking is
+	//! copied or restored, so that no firing is seen half done.
+	mutable std::shared_mutex m_firingMutex;
+
+	//! Serializer of the marking, created on demand.
+	mutable std::shared_ptr<const MarkingSerializer> m_markingSerializer;
+
+	//! Mutex to synchronize m_markingSerializer.
+	mutable std::mutex m_markingSerializerMutex;
+
+	//! Journal recording the changes of the marking, if open. Only set while the event loop is stopped, with
+	//! m_firingMutex locked.
+	std::unique_ptr<Journal> m_journal;
+
+	//! Recorder of the execution, if recording. Set with m_firingMutex locked.
+	std::unique_ptr<ExecutionRecorder> m_recorder;
+
+	//! Whether the execution is being recorded.
+	std::atomic<bool> m_isRecording = false;
+
 	//! Flag reporting a new input event.
 	std::atomic<bool> m_newInputReceived = false;
 
+	//! Serializes the structural updates, which are not synchronized by the proxy.
+	std::mutex m_structureUpdateMutex;
+
 	PlacesManager m_places;
 
 	TransitionsManager m_transitions;
@@ -47,18 +47,140 @@ PTN_Engine::EventLoopSleepDuration PTN_Engine::PTN_EngineImpProxy::getEventLoopS
 	return m_ptnEngineImp.getEventLoopSleepDuration();
 }
 
-void PTN_Engine::PTN_EngineImpProxy::addArc(const ArcProperties &arcProperties)
+void PTN_Engine::PTN_EngineImpProxy::setEventLoopScheduler(const shared_ptr<EventLoopScheduler> &scheduler)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setEventLoopScheduler(scheduler);
+}
+
+shared_ptr<EventLoopScheduler> PTN_Engine::PTN_EngineImpProxy::getEventLoopScheduler() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getEventLoopScheduler();
+}
+
+int PTN_Engine::PTN_EngineImpProxy::getEventFileDescriptor() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getEventFileDescriptor();
+}
+
+size_t PTN_Engine::PTN_EngineImpProxy::poll(const size_t maxSteps)
 {
 	unique_lock guard(m_mutex);
+	return m_ptnEngineImp.poll(maxSteps);
+}
+
+SimulationResult PTN_Engine::PTN_EngineImpProxy::simulate(const SimulationOptions &options)
+{
+	unique_lock guard(m_mutex);
+	return m_ptnEngineImp.simulate(options);
+}
+
+StepResult PTN_Engine::PTN_EngineImpProxy::step(const size_t maxFirings)
+{
+	unique_lock guard(m_mutex);
+	return m_ptnEngineImp.step(maxFirings);
+}
+
+StepResult PTN_Engine::PTN_EngineImpProxy::runFor(const chrono::nanoseconds duration)
+{
+	unique_lock guard(m_mutex);
+	return m_ptnEngineImp.runFor(duration);
+}
+
+bool PTN_Engine::PTN_EngineImpProxy::fireTransition(const string &transition)
+{
+	unique_lock guard(m_mutex);
+	return m_ptnEngineImp.fireTransition(transition);
+}
+
+NetReductionResult PTN_Engine::PTN_EngineImpProxy::reduceNet()
+{
+	unique_lock guard(m_mutex);
+	return m_ptnEngineImp.reduceNet();
+}
+
+// The marking snapshots wait for the transition being fired, whose actions may call the engine. Holding m_mutex
+// while waiting could deadlock, the implementation synchronizes them on its own.
+void PTN_Engine::PTN_EngineImpProxy::restoreMarking(const vector<uint8_t> &snapshot)
+{
+	m_ptnEngineImp.restoreMarking(snapshot);
+}
+
+vector<uint8_t> PTN_Engine::PTN_EngineImpProxy::snapshotMarking() const
+{
+	return m_ptnEngineImp.snapshotMarking();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::resetMarking()
+{
+	m_ptnEngineImp.resetMarking();
+}
+
+uint64_t PTN_Engine::PTN_EngineImpProxy::getMarkingHash() const
+{
+	return m_ptnEngineImp.getMarkingHash();
+}
+
+size_t PTN_Engine::PTN_EngineImpProxy::openJournal(const JournalOptions &options)
+{
+	unique_lock guard(m_mutex);
+	return m_ptnEngineImp.openJournal(options);
+}
+
+void PTN_Engine::PTN_EngineImpProxy::closeJournal()
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.closeJournal();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::syncJournal() const
+{
+	shared_lock guard(m_mutex);
+	m_ptnEngineImp.syncJournal();
+}
+
+// Like the marking snapshots, the recordings wait for the transition being fired.
+void PTN_Engine::PTN_EngineImpProxy::startRecording()
+{
+	m_ptnEngineImp.startRecording();
+}
+
+ExecutionRecording PTN_Engine::PTN_EngineImpProxy::stopRecording()
+{
+	return m_ptnEngineImp.stopRecording();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::replay(const ExecutionRecording &recording, const bool executeActions)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.replay(recording, executeActions);
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setRandomSeed(const uint64_t seed)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setRandomSeed(seed);
+}
+
+// Structural updates wait for the transition being fired, whose actions may call the proxy, so they do not lock
+// m_mutex. The implementation serializes them.
+void PTN_Engine::PTN_EngineImpProxy::addArc(const ArcProperties &arcProperties)
+{
 	m_ptnEngineImp.addArc(arcProperties);
 }
 
 void PTN_Engine::PTN_EngineImpProxy::removeArc(const ArcProperties &arcProperties)
 {
-	unique_lock guard(m_mutex);
 	m_ptnEngineImp.removeArc(arcProperties);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::updateStructure(const StructureUpdate &update)
+{
+	m_ptnEngineImp.updateStructure(update);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::clearNet()
 {
 	unique_lock guard(m_mutex);
@@ -95,12 +217,24 @@ void PTN_Engine::PTN_EngineImpProxy::registerAction(const string &name, const Ac
 	m_ptnEngineImp.registerAction(name, action);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::registerAction(const string &name, const ContextAction &action)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.registerAction(name, action);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::registerCondition(const string &name, const ConditionFunction &condition)
 {
 	unique_lock guard(m_mutex);
 	m_ptnEngineImp.registerCondition(name, condition);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::registerCondition(const string &name, const ContextCondition &condition)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.registerCondition(name, condition);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::execute(const bool log, ostream &o)
 {
 	unique_lock guard(m_mutex);
@@ -121,10 +255,18 @@ size_t PTN_Engine::PTN_EngineImpProxy::getNumberOfTokens(const string &place) co
 
 void PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(const string &place)
 {
-	unique_lock guard(m_mutex);
+	// Not locked, since adding to a place with a capacity waits for the firing, whose actions may call the engine.
 	m_ptnEngineImp.incrementInputPlace(place);
 }
 
+bool PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(const string &place,
+														 const FULL_PLACE_POLICY policy,
+														 const chrono::milliseconds timeout)
+{
+	// Not locked, since blocking waits for firings whose actions may call the engine.
+	return m_ptnEngineImp.incrementInputPlace(place, policy, timeout);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::printState(ostream &o) const
 {
 	shared_lock guard(m_mutex);
@@ -149,4 +291,16 @@ PTN_Engine::ACTIONS_THREAD_OPTION PTN_Engine::PTN_EngineImpProxy::getActionsThre
 	return m_ptnEngineImp.getActionsThreadOption();
 }
 
+void PTN_Engine::PTN_EngineImpProxy::setFiringSemantics(const FIRING_SEMANTICS firingSemantics)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setFiringSemantics(firingSemantics);
+}
+
+PTN_Engine::FIRING_SEMANTICS PTN_Engine::PTN_EngineImpProxy::getFiringSemantics() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getFiringSemantics();
+}
+
 } // namespace ptne
@@ -53,8 +53,13 @@ public:
 
 	ACTIONS_THREAD_OPTION getActionsThreadOption() const;
 
+	FIRING_SEMANTICS getFiringSemantics() const;
+
 	EventLoopSleepDuration getEventLoopSleepDuration() const;
 
+	std::shared_ptr<EventLoopScheduler> getEventLoopScheduler() const;
+
+	int getEventFileDescriptor() const;
 	size_t getNumberOfTokens(const std::string &place) const;
 
 	std::vector<PlaceProperties> getPlacesProperties() const;
@@ -63,20 +68,64 @@ public:
 
 	void incrementInputPlace(const std::string &place);
 
+	bool incrementInputPlace(const std::string &place,
+							 const FULL_PLACE_POLICY policy,
+							 const std::chrono::milliseconds timeout);
+
 	bool isEventLoopRunning() const;
 
+	size_t poll(const size_t maxSteps);
 	void printState(std::ostream &o) const;
 
 	void registerAction(const std::string &name, const ActionFunction &action);
 
+	void registerAction(const std::string &name, const ContextAction &action);
+
 	void registerCondition(const std::string &name, const ConditionFunction &condition);
 
+	void registerCondition(const std::string &name, const ContextCondition &condition);
+
+	NetReductionResult reduceNet();
+
+	void restoreMarking(const std::vector<uint8_t> &snapshot);
+
+	std::vector<uint8_t> snapshotMarking() const;
+
+	void resetMarking();
+
+	uint64_t getMarkingHash() const;
+
+	size_t openJournal(const JournalOptions &options);
+
+	void closeJournal();
+
+	void syncJournal() const;
+
+	void startRecording();
+
+	ExecutionRecording stopRecording();
+
+	void replay(const ExecutionRecording &recording, const bool executeActions);
+
+	void setRandomSeed(const uint64_t seed);
+
 	void removeArc(const ArcProperties &arcProperties);
 
+	void updateStructure(const StructureUpdate &update);
+
+	StepResult runFor(const std::chrono::nanoseconds duration);
+	bool fireTransition(const std::string &transition);
+
 	void setActionsThreadOption(const ACTIONS_THREAD_OPTION actionsThreadOption);
 
+	void setEventLoopScheduler(const std::shared_ptr<EventLoopScheduler> &scheduler);
+
 	void setEventLoopSleepDuration(const EventLoopSleepDuration sleepDuration);
 
+	void setFiringSemantics(const FIRING_SEMANTICS firingSemantics);
+
+	SimulationResult simulate(const SimulationOptions &options);
+	StepResult step(const size_t maxFirings);
 	void stop();
 
 private:
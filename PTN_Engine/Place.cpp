@@ -21,6 +21,7 @@
 #include "PTN_Engine/PTN_EngineImp.h"
 #include "PTN_Engine/PTN_Exception.h"
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include <cstddef>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -33,24 +34,48 @@ using namespace std;
 Place::~Place() = default;
 
 Place::Place(const PlaceProperties &placeProperties, const shared_ptr<IActionsExecutor> &executor)
-: m_name(placeProperties.name)
-, m_onEnterActionName(placeProperties.onEnterActionFunctionName)
+: m_isInputPlace(placeProperties.input)
+, m_name(placeProperties.name)
+, m_numberOfTokens(placeProperties.initialNumberOfTokens)
+, m_initialNumberOfTokens(placeProperties.initialNumberOfTokens)
+, m_capacity(placeProperties.capacity)
 , m_onEnterAction(placeProperties.onEnterAction)
-, m_onExitActionName(placeProperties.onExitActionFunctionName)
+, m_onEnterContextAction(placeProperties.onEnterContextAction)
+, m_onEnterActionName(placeProperties.onEnterActionFunctionName)
 , m_onExitAction(placeProperties.onExitAction)
-, m_numberOfTokens(placeProperties.initialNumberOfTokens)
-, m_isInputPlace(placeProperties.input)
+, m_onExitContextAction(placeProperties.onExitContextAction)
+, m_onExitActionName(placeProperties.onExitActionFunctionName)
 , m_actionsExecutor(executor)
 {
-	if (!m_onEnterActionName.empty() && m_onEnterAction == nullptr)
+	const bool hasOnEnterContextAction = m_onEnterContextAction.function != nullptr;
+	if (!m_onEnterActionName.empty() && m_onEnterAction == nullptr && !hasOnEnterContextAction)
 	{
 		throw PTN_Exception("On enter action function must be specified.");
 	}
 
-	if (!m_onExitActionName.empty() && m_onExitAction == nullptr)
+	const bool hasOnExitContextAction = m_onExitContextAction.function != nullptr;
+	if (!m_onExitActionName.empty() && m_onExitAction == nullptr && !hasOnExitContextAction)
 	{
 		throw PTN_Exception("On exit action function must be specified.");
 	}
+
+	if ((m_onEnterAction != nullptr && hasOnEnterContextAction) ||
+		(m_onExitAction != nullptr && hasOnExitContextAction))
+	{
+		throw PTN_Exception("A place cannot have both an action and a context action for the same event.");
+	}
+
+	if (m_capacity != 0 && m_numberOfTokens > m_capacity)
+	{
+		throw PlaceCapacityException(m_name);
+	}
+
+	// FNV-1a.
+	m_hashKey = 0xcbf29ce484222325;
+	for (const char c : m_name)
+	{
+		m_hashKey = (m_hashKey ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+	}
 }
 
 string Place::getName() const
@@ -58,11 +83,11 @@ string Place::getName() const
 	return m_name;
 }
 
-void Place::enterPlace(const size_t tokens)
+void Place::enterPlace(const size_t tokens, const size_t firings)
 {
 	unique_lock guard(m_mutex);
 	increaseNumberOfTokens(tokens);
-	if (m_onEnterAction == nullptr)
+	if (m_onEnterAction == nullptr && m_onEnterContextAction.function == nullptr)
 	{
 		return;
 	}
@@ -73,18 +98,71 @@ void Place::enterPlace(const size_t tokens)
 		// is thrown.
 		this_thread::sleep_for(100ms);
 	}
-	lockWeakPtr(m_actionsExecutor)->executeAction(m_onEnterAction, m_onEnterActionsInExecution);
+	executeActions(m_onEnterAction,
+				   m_onEnterContextAction,
+				   m_onEnterActionsInExecution,
+				   static_cast<ptrdiff_t>(tokens),
+				   firings);
 }
 
-void Place::exitPlace(const size_t tokens)
+void Place::exitPlace(const size_t tokens, const size_t firings)
 {
 	unique_lock guard(m_mutex);
 	decreaseNumberOfTokens(tokens);
-	if (m_onExitAction == nullptr)
+	executeActions(m_onExitAction,
+				   m_onExitContextAction,
+				   m_onExitActionsInExecution,
+				   -static_cast<ptrdiff_t>(tokens),
+				   firings);
+}
+
+void Place::resetPlace()
+{
+	unique_lock guard(m_mutex);
+	if (m_numberOfTokens == 0)
 	{
 		return;
 	}
-	lockWeakPtr(m_actionsExecutor)->executeAction(m_onExitAction, m_onExitActionsInExecution);
+	const auto tokens = static_cast<ptrdiff_t>(m_numberOfTokens);
+	updateNumberOfTokens(0);
+	executeActions(m_onExitAction, m_onExitContextAction, m_onExitActionsInExecution, -tokens, 1);
+}
+
+void Place::executeActions(const ActionFunction &action,
+						   const ContextAction &contextAction,
+						   atomic<size_t> &actionsInExecution,
+						   const ptrdiff_t tokenDelta,
+						   const size_t firings) const
+{
+	if (action == nullptr && contextAction.function == nullptr)
+	{
+		return;
+	}
+	const auto actionsExecutor = lockWeakPtr(m_actionsExecutor);
+	if (action != nullptr)
+	{
+		for (size_t i = 0; i < firings; ++i)
+		{
+			actionsExecutor->executeAction(action, actionsInExecution);
+		}
+		return;
+	}
+
+	// Each firing of a batch is told about its own share of the tokens, as if the firings had been made one by one.
+	// Actions run later keep the place alive, since the context refers to its name. Places not owned by a
+	// shared_ptr, e.g. in tests, are not kept alive.
+	const shared_ptr<const void> place = weak_from_this().lock();
+	const ptrdiff_t firingDelta = tokenDelta / static_cast<ptrdiff_t>(firings);
+	ActionContext context{ .placeHandle = this,
+						   .placeName = m_name,
+						   .tokenDelta = firingDelta,
+						   .numberOfTokens = m_numberOfTokens - static_cast<size_t>(tokenDelta),
+						   .userData = contextAction.userData };
+	for (size_t i = 0; i < firings; ++i)
+	{
+		context.numberOfTokens += static_cast<size_t>(firingDelta);
+		actionsExecutor->executeAction(contextAction, context, actionsInExecution, place);
+	}
 }
 
 void Place::increaseNumberOfTokens(const size_t tokens)
@@ -99,29 +177,71 @@ void Place::increaseNumberOfTokens(const size_t tokens)
 		throw OverflowException(tokens);
 	}
 
-	m_numberOfTokens += tokens;
+	updateNumberOfTokens(m_numberOfTokens + tokens);
 }
 
 void Place::decreaseNumberOfTokens(const size_t tokens)
 {
+	if (tokens == 0)
+	{
+		throw NullTokensException();
+	}
+
 	if (m_numberOfTokens < tokens)
 	{
 		throw NotEnoughTokensException();
 	}
-	if (tokens == 0) // reset
+
+	updateNumberOfTokens(m_numberOfTokens - tokens);
+}
+
+void Place::setNumberOfTokens(const size_t tokens)
+{
+	unique_lock guard(m_mutex);
+	updateNumberOfTokens(tokens);
+}
+
+void Place::setMarkingHash(shared_ptr<atomic<uint64_t>> markingHash)
+{
+	unique_lock guard(m_mutex);
+	const uint64_t contribution = getHashContribution(m_numberOfTokens);
+	if (m_markingHash)
 	{
-		m_numberOfTokens = 0;
+		*m_markingHash ^= contribution;
 	}
-	else
+	m_markingHash = std::move(markingHash);
+	if (m_markingHash)
 	{
-		m_numberOfTokens -= tokens;
+		*m_markingHash ^= contribution;
 	}
 }
 
-void Place::setNumberOfTokens(const size_t tokens)
+void Place::updateNumberOfTokens(const size_t tokens)
 {
-	unique_lock guard(m_mutex);
+	// Places change the hash concurrently, which is fine since xor is commutative.
+	if (m_markingHash)
+	{
+		*m_markingHash ^= getHashContribution(m_numberOfTokens) ^ getHashContribution(tokens);
+	}
+	const bool tokensLeft = tokens < m_numberOfTokens;
 	m_numberOfTokens = tokens;
+	if (m_capacity != 0 && tokensLeft)
+	{
+		m_roomAvailable.notify_all();
+	}
+}
+
+uint64_t Place::getHashContribution(const size_t tokens) const
+{
+	if (tokens == 0)
+	{
+		return 0;
+	}
+	// splitmix64 finalizer, so that each number of tokens gives an unrelated value.
+	uint64_t value = m_hashKey + tokens * 0x9e3779b97f4a7c15;
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+	return value ^ (value >> 31);
 }
 
 size_t Place::getNumberOfTokens() const
@@ -130,6 +250,33 @@ size_t Place::getNumberOfTokens() const
 	return m_numberOfTokens;
 }
 
+size_t Place::getInitialNumberOfTokens() const
+{
+	return m_initialNumberOfTokens;
+}
+
+size_t Place::getCapacity() const
+{
+	return m_capacity;
+}
+
+bool Place::hasRoomFor(const size_t tokens) const
+{
+	shared_lock guard(m_mutex);
+	return hasRoomForInternal(tokens);
+}
+
+bool Place::hasRoomForInternal(const size_t tokens) const
+{
+	return m_capacity == 0 || (m_numberOfTokens <= m_capacity && tokens <= m_capacity - m_numberOfTokens);
+}
+
+bool Place::waitForRoom(const chrono::steady_clock::time_point deadline)
+{
+	unique_lock guard(m_mutex);
+	return m_roomAvailable.wait_until(guard, deadline, [this] { return hasRoomForInternal(1); });
+}
+
 bool Place::isInputPlace() const
 {
 	shared_lock guard(m_mutex);
@@ -167,7 +314,10 @@ PlaceProperties Place::placeProperties() const
 	placeProperties.initialNumberOfTokens = m_numberOfTokens;
 	placeProperties.onEnterAction = m_onEnterAction;
 	placeProperties.onExitAction = m_onExitAction;
+	placeProperties.onEnterContextAction = m_onEnterContextAction;
+	placeProperties.onExitContextAction = m_onExitContextAction;
 	placeProperties.input = m_isInputPlace;
+	placeProperties.capacity = m_capacity;
 	return placeProperties;
 }
 
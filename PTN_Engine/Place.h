@@ -20,7 +20,11 @@
 
 #include "PTN_Engine/PTN_Engine.h"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <shared_mutex>
 
 namespace ptne
@@ -33,7 +37,7 @@ class IActionsExecutor;
 //!
 //! \brief Implements a place of a Petri net.
 //!
-class Place final
+class Place final : public std::enable_shared_from_this<Place>
 {
 public:
 	using ActionFunction = std::function<void(void)>;
@@ -54,14 +58,21 @@ public:
 	//!
 	//! \brief Increase number of tokens and call on enter action.
 	//! \param tokens - number of tokens to increase.
+	//! \param firings - number of firings bringing the tokens, each calling the on enter action once.
 	//!
-	void enterPlace(const size_t tokens = 1);
+	void enterPlace(const size_t tokens = 1, const size_t firings = 1);
 
 	//!
 	//! \brief Decrease number of tokens and call on exit action.
 	//! \param tokens - number of tokens to decrease.
+	//! \param firings - number of firings taking the tokens, each calling the on exit action once.
 	//!
-	void exitPlace(const size_t tokens = 1);
+	void exitPlace(const size_t tokens = 1, const size_t firings = 1);
+
+	//!
+	//! \brief Remove all the tokens, in constant time, and call the on exit action once if there were any.
+	//!
+	void resetPlace();
 
 	//!
 	//! \brief getName
@@ -75,6 +86,32 @@ public:
 	//!
 	size_t getNumberOfTokens() const;
 
+	//!
+	//! \brief Get the number of tokens the place was created with.
+	//! \return The initial number of tokens.
+	//!
+	size_t getInitialNumberOfTokens() const;
+
+	//!
+	//! \brief Get the maximum number of tokens the place can hold.
+	//! \return The capacity, zero if the place is unbounded.
+	//!
+	size_t getCapacity() const;
+
+	//!
+	//! \brief Whether tokens can be added to the place without exceeding its capacity.
+	//! \param tokens - Number of tokens to be added.
+	//! \return true if the place is unbounded or has room for the tokens.
+	//!
+	bool hasRoomFor(const size_t tokens) const;
+
+	//!
+	//! \brief Wait until the place has room for a token.
+	//! \param deadline - Time after which to stop waiting.
+	//! \return true if the place has room, false if the deadline expired.
+	//!
+	bool waitForRoom(const std::chrono::steady_clock::time_point deadline);
+
 	//!
 	//! \brief getOnEnterActionName
 	//! \return The label name of the on enter action.
@@ -118,6 +155,13 @@ public:
 	//!
 	void setNumberOfTokens(const size_t tokens);
 
+	//!
+	//! \brief Set the hash of the marking of the net the place belongs to, moving the contribution of the place
+	//! from the previous hash to the new one.
+	//! \param markingHash - The hash of the marking of the net, or nullptr when the place is removed from it.
+	//!
+	void setMarkingHash(std::shared_ptr<std::atomic<uint64_t>> markingHash);
+
 private:
 	//!
 	//! Decrease number of tokens in the place.
@@ -131,6 +175,40 @@ private:
 	//!
 	void increaseNumberOfTokens(const size_t tokens = 1);
 
+	//!
+	//! \brief Change the number of tokens, updating the hash of the marking. Requires m_mutex to be locked.
+	//! \param tokens - The new number of tokens.
+	//!
+	void updateNumberOfTokens(const size_t tokens);
+
+	//!
+	//! \brief Get the contribution of the place to the hash of the marking.
+	//! \param tokens - Number of tokens in the place.
+	//! \return Zero for an empty place, a pseudo random value of the name and the tokens otherwise.
+	//!
+	uint64_t getHashContribution(const size_t tokens) const;
+
+	//!
+	//! \brief Call an action once per firing. Requires m_mutex to be locked, after the number of tokens changed.
+	//! \param action - The action, if any.
+	//! \param contextAction - The action receiving a context, if any.
+	//! \param actionsInExecution - Counter of the actions being executed.
+	//! \param tokenDelta - Change of the number of tokens in all the firings.
+	//! \param firings - Number of firings.
+	//!
+	void executeActions(const ActionFunction &action,
+						const ContextAction &contextAction,
+						std::atomic<size_t> &actionsInExecution,
+						const std::ptrdiff_t tokenDelta,
+						const size_t firings) const;
+
+	//!
+	//! \brief Whether tokens can be added without exceeding the capacity. Requires m_mutex to be locked.
+	//! \param tokens - Number of tokens to be added.
+	//! \return true if the place is unbounded or has room for the tokens.
+	//!
+	bool hasRoomForInternal(const size_t tokens) const;
+
 	//! Flag to block triggering on enter actions.
 	std::atomic<bool> m_blockStartingOnEnterActions = false;
 
@@ -146,9 +224,27 @@ private:
 	//! Number of tokens in the place.
 	size_t m_numberOfTokens = 0;
 
+	//! Number of tokens the place was created with.
+	const size_t m_initialNumberOfTokens = 0;
+
+	//! Maximum number of tokens the place can hold. Zero means unbounded.
+	const size_t m_capacity = 0;
+
+	//! Notifies the producers waiting for room when tokens leave a place with a capacity.
+	std::condition_variable_any m_roomAvailable;
+
+	//! Key of the place in the hash of the marking, derived from its name so that it is the same in all replicas.
+	uint64_t m_hashKey = 0;
+
+	//! Hash of the marking of the net, shared by its places.
+	std::shared_ptr<std::atomic<uint64_t>> m_markingHash;
+
 	//! Function to be called when a token enters the place.
 	const ActionFunction m_onEnterAction = nullptr;
 
+	//! Function to be called with its context when a token enters the place.
+	const ContextAction m_onEnterContextAction;
+
 	//! A label for the on enter action.
 	std::string m_onEnterActionName;
 
@@ -158,6 +254,9 @@ private:
 	//! Function to be called when a token leaves the place.
 	const ActionFunction m_onExitAction = nullptr;
 
+	//! Function to be called with its context when a token leaves the place.
+	const ContextAction m_onExitContextAction;
+
 	//! A label for the on exite action.
 	std::string m_onExitActionName;
 
@@ -20,6 +20,7 @@
 #include "PTN_Engine/PTN_Exception.h"
 #include "PTN_Engine/Utilities/DetectRepeated.h"
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include <algorithm>
 #include <mutex>
 
 namespace ptne
@@ -39,19 +40,40 @@ void PlacesManager::insert(const shared_ptr<Place> &spPlace)
 {
 	unique_lock itemsGuard(m_itemsMutex);
 	ManagerBase<Place>::insert(spPlace);
+	spPlace->setMarkingHash(m_markingHash);
 	if (spPlace->isInputPlace())
 	{
 		m_inputPlaces.push_back(spPlace);
 	}
 }
 
+void PlacesManager::erase(const string &placeName)
+{
+	unique_lock itemsGuard(m_itemsMutex);
+	if (m_items.contains(placeName))
+	{
+		m_items.at(placeName)->setMarkingHash(nullptr);
+	}
+	ManagerBase<Place>::erase(placeName);
+	erase_if(m_inputPlaces, [](const WeakPtrPlace &place) { return place.expired(); });
+}
+
 void PlacesManager::clear()
 {
 	unique_lock itemsGuard(m_itemsMutex);
+	for (const auto &[_, place] : m_items)
+	{
+		place->setMarkingHash(nullptr);
+	}
 	ManagerBase<Place>::clear();
 	m_inputPlaces.clear();
 }
 
+uint64_t PlacesManager::getMarkingHash() const
+{
+	return m_markingHash->load();
+}
+
 shared_ptr<Place> PlacesManager::getPlace(const string &placeName) const
 {
 	shared_lock itemsGuard(m_itemsMutex);
@@ -141,4 +163,16 @@ vector<WeakPtrPlace> PlacesManager::getPlaces(const vector<string> &placesNames)
 	}
 	return placesVector;
 }
+
+vector<SharedPtrPlace> PlacesManager::getPlaces() const
+{
+	shared_lock placesGuard(m_itemsMutex);
+	vector<SharedPtrPlace> places;
+	for (const auto &[_, place] : m_items)
+	{
+		places.push_back(place);
+	}
+	ranges::sort(places, {}, [](const auto &place) { return place->getName(); });
+	return places;
+}
 } // namespace ptne
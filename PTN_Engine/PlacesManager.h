@@ -52,8 +52,21 @@ public:
 	//!
 	void clearInputPlaces() const;
 
+	//!
+	//! \brief Get the hash of the current marking, updated on every change of the number of tokens. Places with the
+	//! same names and number of tokens give the same hash.
+	//! \return The hash of the marking.
+	//!
+	uint64_t getMarkingHash() const;
+
 	bool contains(const std::string &itemName) const;
 
+	//!
+	//! \brief Removes a place. Transitions must no longer have arcs to it.
+	//! \param placeName - Name of the place.
+	//!
+	void erase(const std::string &placeName);
+
 	//!
 	//! \brief Gets the number of tokens in a given place.
 	//! \param place - identifier of a place.
@@ -65,6 +78,12 @@ public:
 
 	std::vector<WeakPtrPlace> getPlaces(const std::vector<std::string> &placesNames) const;
 
+	//!
+	//! \brief Get all places.
+	//! \return The places, in order of their names.
+	//!
+	std::vector<SharedPtrPlace> getPlaces() const;
+
 	std::vector<PlaceProperties> getPlacesProperties() const;
 
 	//!
@@ -97,6 +116,9 @@ private:
 	//! \brief Vector with the input places.
 	//!
 	std::vector<WeakPtrPlace> m_inputPlaces;
+
+	//! Hash of the marking, shared with the places.
+	const std::shared_ptr<std::atomic<uint64_t>> m_markingHash = std::make_shared<std::atomic<uint64_t>>(0);
 };
 
 } // namespace ptne
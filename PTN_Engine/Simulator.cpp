@@ -0,0 +1,225 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Simulator.h"
+#include "PTN_Engine/Place.h"
+#include "PTN_Engine/Transition.h"
+#include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace ptne
+{
+using namespace std;
+
+DelayDistribution getDefaultDelayDistribution(const chrono::milliseconds minimumDelay,
+											  const chrono::milliseconds maximumDelay)
+{
+	if (maximumDelay == chrono::milliseconds::zero())
+	{
+		return DelayDistribution{ .type = DelayDistribution::Type::DETERMINISTIC, .minimum = minimumDelay };
+	}
+	return DelayDistribution{ .type = DelayDistribution::Type::UNIFORM, .minimum = minimumDelay, .maximum = maximumDelay };
+}
+
+SimulationTime sampleDelay(const DelayDistribution &delayDistribution, mt19937_64 &randomGenerator)
+{
+	switch (delayDistribution.type)
+	{
+	default:
+	case DelayDistribution::Type::DETERMINISTIC:
+	{
+		return delayDistribution.minimum;
+	}
+	case DelayDistribution::Type::UNIFORM:
+	{
+		return SimulationTime(uniform_real_distribution<double>(delayDistribution.minimum.count(),
+																 delayDistribution.maximum.count())(randomGenerator));
+	}
+	case DelayDistribution::Type::EXPONENTIAL:
+	{
+		if (delayDistribution.mean <= SimulationTime::zero())
+		{
+			return SimulationTime::zero();
+		}
+		return SimulationTime(exponential_distribution<double>(1.0 / delayDistribution.mean.count())(randomGenerator));
+	}
+	}
+}
+
+Simulator::~Simulator() = default;
+
+Simulator::Simulator(const vector<shared_ptr<Transition>> &transitions, const SimulationOptions &options)
+: m_transitions(transitions)
+, m_dependentTransitions(transitions.size())
+, m_states(transitions.size(), State::IDLE)
+, m_generations(transitions.size(), 0)
+, m_randomGenerator(options.seed)
+, m_options(options)
+{
+	for (const auto &transition : m_transitions)
+	{
+		const auto it = options.delays.find(transition->getName());
+		if (it != options.delays.end())
+		{
+			m_delays.push_back(it->second);
+		}
+		else
+		{
+			const TransitionProperties transitionProperties = transition->getTransitionProperties();
+			m_delays.push_back(
+			getDefaultDelayDistribution(transitionProperties.minimumDelay, transitionProperties.maximumDelay));
+		}
+	}
+
+	// The enabling of a transition only depends on the places of its activation, inhibitor and read arcs, and on
+	// its destination places with a capacity.
+	unordered_map<const Place *, vector<size_t>> transitionsByInputPlace;
+	for (size_t i = 0; i < m_transitions.size(); ++i)
+	{
+		for (const auto &arcs : { m_transitions[i]->getActivationArcs(), m_transitions[i]->getInhibitorArcs(),
+								  m_transitions[i]->getReadArcs() })
+		{
+			for (const Arc &arc : arcs)
+			{
+				transitionsByInputPlace[lockWeakPtr(arc.place).get()].push_back(i);
+			}
+		}
+		for (const Arc &arc : m_transitions[i]->getDestinationArcs())
+		{
+			if (const SharedPtrPlace spPlace = lockWeakPtr(arc.place); spPlace->getCapacity() != 0)
+			{
+				transitionsByInputPlace[spPlace.get()].push_back(i);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < m_transitions.size(); ++i)
+	{
+		vector<size_t> &dependentTransitions = m_dependentTransitions[i];
+		for (const auto &arcs : { m_transitions[i]->getActivationArcs(), m_transitions[i]->getDestinationArcs(),
+								  m_transitions[i]->getResetArcs() })
+		{
+			for (const Arc &arc : arcs)
+			{
+				const auto it = transitionsByInputPlace.find(lockWeakPtr(arc.place).get());
+				if (it != transitionsByInputPlace.end())
+				{
+					ranges::copy(it->second, back_inserter(dependentTransitions));
+				}
+			}
+		}
+		dependentTransitions.push_back(i);
+		ranges::sort(dependentTransitions);
+		const auto [first, last] = ranges::unique(dependentTransitions);
+		dependentTransitions.erase(first, last);
+	}
+}
+
+SimulationResult Simulator::run()
+{
+	vector<size_t> firingsPerTransition(m_transitions.size(), 0);
+	SimulationResult result;
+
+	for (size_t i = 0; i < m_transitions.size(); ++i)
+	{
+		update(i);
+	}
+
+	while (result.firedTransitions < m_options.maxFirings)
+	{
+		while (!m_firings.empty() && m_firings.top().generation != m_generations[m_firings.top().transition])
+		{
+			m_firings.pop();
+		}
+		if (m_firings.empty())
+		{
+			break;
+		}
+
+		const ScheduledFiring firing = m_firings.top();
+		if (firing.time > m_options.duration)
+		{
+			m_now = m_options.duration;
+			break;
+		}
+		m_firings.pop();
+		m_now = firing.time;
+		m_states[firing.transition] = State::IDLE;
+
+		if (!m_transitions[firing.transition]->execute(false))
+		{
+			m_states[firing.transition] = State::BLOCKED;
+			m_blockedTransitions.push_back(firing.transition);
+			continue;
+		}
+
+		++result.firedTransitions;
+		++firingsPerTransition[firing.transition];
+
+		// The firing may have changed what the additional conditions of the blocked transitions depend on.
+		for (const size_t blockedTransition : exchange(m_blockedTransitions, {}))
+		{
+			if (m_states[blockedTransition] == State::BLOCKED)
+			{
+				schedule(blockedTransition, m_now);
+			}
+		}
+		for (const size_t dependentTransition : m_dependentTransitions[firing.transition])
+		{
+			update(dependentTransition);
+		}
+	}
+
+	for (size_t i = 0; i < m_transitions.size(); ++i)
+	{
+		if (firingsPerTransition[i] > 0)
+		{
+			result.firingsPerTransition[m_transitions[i]->getName()] = firingsPerTransition[i];
+		}
+	}
+	result.endTime = m_now;
+	result.workRemaining = ranges::any_of(m_states, [](const State state) { return state == State::SCHEDULED; });
+	return result;
+}
+
+void Simulator::schedule(const size_t transition, const SimulationTime time)
+{
+	m_states[transition] = State::SCHEDULED;
+	m_firings.push(ScheduledFiring{ .time = time,
+									.tieBreaker = m_randomGenerator(),
+									.transition = transition,
+									.generation = ++m_generations[transition] });
+}
+
+void Simulator::update(const size_t transition)
+{
+	const bool isEnabled = m_transitions[transition]->isEnabled();
+	if (!isEnabled && m_states[transition] != State::IDLE)
+	{
+		m_states[transition] = State::IDLE;
+		++m_generations[transition];
+	}
+	else if (isEnabled && m_states[transition] == State::IDLE)
+	{
+		schedule(transition, m_now + sampleDelay(m_delays[transition], m_randomGenerator));
+	}
+}
+
+} // namespace ptne
@@ -0,0 +1,155 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace ptne
+{
+
+class Transition;
+
+//!
+//! \brief Get the firing delay distribution implied by the firing window of a transition: a deterministic minimum
+//! delay if the transition has no deadline, a uniform distribution over the window otherwise.
+//! \param minimumDelay - Time the transition must remain enabled before it can fire.
+//! \param maximumDelay - Deadline of the firing, zero if there is none.
+//! \return The delay distribution.
+//!
+DelayDistribution getDefaultDelayDistribution(const std::chrono::milliseconds minimumDelay,
+											  const std::chrono::milliseconds maximumDelay);
+
+//!
+//! \brief Sample a firing delay.
+//! \param delayDistribution - The distribution of the delay.
+//! \param randomGenerator - Source of randomness.
+//! \return The firing delay.
+//!
+SimulationTime sampleDelay(const DelayDistribution &delayDistribution, std::mt19937_64 &randomGenerator);
+
+//!
+//! \brief Discrete event simulator of a Petri net in virtual time.
+//!
+//! Each transition is scheduled to fire after a delay sampled from its distribution, once it becomes enabled by
+//! the tokens in its places, and unscheduled if it is disabled before. Enabled transitions keep their scheduled
+//! time when other transitions fire. After each firing only the transitions sharing places with the fired one are
+//! evaluated again. Transitions whose additional conditions do not hold at their firing time are retried after
+//! the next firing.
+//!
+class Simulator final
+{
+public:
+	~Simulator();
+
+	//!
+	//! \brief Simulator constructor.
+	//! \param transitions - The transitions of the net.
+	//! \param options - Configuration of the simulation.
+	//!
+	Simulator(const std::vector<std::shared_ptr<Transition>> &transitions, const SimulationOptions &options);
+
+	Simulator(const Simulator &) = delete;
+	Simulator(Simulator &&) = delete;
+	Simulator &operator=(const Simulator &) = delete;
+	Simulator &operator=(Simulator &&) = delete;
+
+	//!
+	//! \brief Run the simulation.
+	//! \return Statistics of the simulation.
+	//!
+	SimulationResult run();
+
+private:
+	//! Scheduling state of a transition.
+	enum class State
+	{
+		IDLE,
+		SCHEDULED,
+		BLOCKED
+	};
+
+	//! Firing of a transition scheduled in virtual time.
+	struct ScheduledFiring
+	{
+		SimulationTime time;
+
+		//! Random order among firings scheduled at the same time.
+		uint64_t tieBreaker = 0;
+
+		size_t transition = 0;
+
+		//! Firings scheduled before the transition was last unscheduled are outdated.
+		size_t generation = 0;
+
+		bool operator>(const ScheduledFiring &other) const
+		{
+			return time != other.time ? time > other.time : tieBreaker > other.tieBreaker;
+		}
+	};
+
+	//!
+	//! \brief Schedule a transition.
+	//! \param transition - Index of the transition.
+	//! \param time - Virtual time of the firing.
+	//!
+	void schedule(const size_t transition, const SimulationTime time);
+
+	//!
+	//! \brief Schedule or unschedule a transition according to whether it is enabled.
+	//! \param transition - Index of the transition.
+	//!
+	void update(const size_t transition);
+
+	//! The transitions of the net.
+	std::vector<std::shared_ptr<Transition>> m_transitions;
+
+	//! Firing delay distribution of each transition.
+	std::vector<DelayDistribution> m_delays;
+
+	//! For each transition, the transitions whose enabling may change when it fires.
+	std::vector<std::vector<size_t>> m_dependentTransitions;
+
+	//! Scheduling state of each transition.
+	std::vector<State> m_states;
+
+	//! Current scheduling generation of each transition.
+	std::vector<size_t> m_generations;
+
+	//! Transitions waiting for their additional conditions.
+	std::vector<size_t> m_blockedTransitions;
+
+	//! Scheduled firings, earliest first.
+	std::priority_queue<ScheduledFiring, std::vector<ScheduledFiring>, std::greater<ScheduledFiring>> m_firings;
+
+	//! Random number generator of the delays and tie breakers.
+	std::mt19937_64 m_randomGenerator;
+
+	//! Current virtual time.
+	SimulationTime m_now = SimulationTime::zero();
+
+	//! Configuration of the simulation.
+	SimulationOptions m_options;
+};
+
+} // namespace ptne
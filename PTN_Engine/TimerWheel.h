@@ -0,0 +1,353 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Hierarchical timing wheel. Keeps timers identified by a key, with constant time scheduling and
+//! cancellation, independently of the number of timers.
+//!
+//! Time is measured in ticks. The wheel has NUMBER_OF_LEVELS levels of SLOTS_PER_LEVEL slots. A timer is kept at
+//! the level of the most significant byte in which its expiry differs from the current tick, and is cascaded to
+//! the lower levels as the current tick approaches its expiry. Timers out of the range of the levels are kept in
+//! an overflow list. Occupied slots are tracked in bitmaps, so that advancing the wheel jumps directly to the
+//! next expiry instead of visiting every tick.
+//!
+//! This class is not thread safe.
+//!
+template <typename Key>
+class TimerWheel
+{
+public:
+	using Tick = uint64_t;
+
+	~TimerWheel() = default;
+	TimerWheel() = default;
+	TimerWheel(const TimerWheel &) = delete;
+	TimerWheel(TimerWheel &&) = delete;
+	TimerWheel &operator=(const TimerWheel &) = delete;
+	TimerWheel &operator=(TimerWheel &&) = delete;
+
+	//!
+	//! \brief Schedule a timer. If a timer with the same key exists, it is rescheduled.
+	//! \param key - Identifier of the timer.
+	//! \param expiry - Tick at which the timer expires. Expiries in the past expire on the next advance.
+	//!
+	void schedule(const Key &key, const Tick expiry)
+	{
+		cancel(key);
+		auto &entry = *m_timers.try_emplace(key).first;
+		entry.second.expiry = std::max(expiry, m_currentTick);
+		place(entry);
+	}
+
+	//!
+	//! \brief Cancel a timer.
+	//! \param key - Identifier of the timer.
+	//! \return true if the timer existed, false otherwise.
+	//!
+	bool cancel(const Key &key)
+	{
+		auto it = m_timers.find(key);
+		if (it == m_timers.end())
+		{
+			return false;
+		}
+		unlink(*it);
+		m_timers.erase(it);
+		return true;
+	}
+
+	//!
+	//! \brief Whether a timer is scheduled.
+	//! \param key - Identifier of the timer.
+	//! \return true if the timer is scheduled and has not expired yet.
+	//!
+	bool contains(const Key &key) const
+	{
+		return m_timers.contains(key);
+	}
+
+	//!
+	//! \brief Number of scheduled timers.
+	//! \return The number of scheduled timers.
+	//!
+	size_t size() const
+	{
+		return m_timers.size();
+	}
+
+	//!
+	//! \brief Get the tick the wheel was last advanced to.
+	//! \return The current tick.
+	//!
+	Tick getCurrentTick() const
+	{
+		return m_currentTick;
+	}
+
+	//!
+	//! \brief Advance the wheel and remove the expired timers.
+	//! \param now - The new current tick. Ticks before the current one are ignored.
+	//! \return The keys of the timers that expired, in order of expiry.
+	//!
+	std::vector<Key> advance(const Tick now)
+	{
+		std::vector<Key> expired;
+		while (true)
+		{
+			collectExpired(expired);
+			if (m_currentTick >= now)
+			{
+				break;
+			}
+			const auto next = nextExpiry();
+			jumpTo(next.has_value() && *next < now ? *next : now);
+		}
+		return expired;
+	}
+
+	//!
+	//! \brief Get the earliest expiry of the scheduled timers.
+	//! \return The earliest expiry, or nothing if there are no timers.
+	//!
+	std::optional<Tick> nextExpiry() const
+	{
+		if (m_timers.empty())
+		{
+			return std::nullopt;
+		}
+
+		// Timers of a level expire before the timers of the levels above, since their expiry is closer to the
+		// current tick.
+		for (size_t level = 0; level < NUMBER_OF_LEVELS; ++level)
+		{
+			const size_t currentSlot = getSlotIndex(m_currentTick, level);
+			const auto slot = findOccupiedSlot(level, level == 0 ? currentSlot : currentSlot + 1);
+			if (!slot.has_value())
+			{
+				continue;
+			}
+			if (level == 0)
+			{
+				return (m_currentTick & ~SLOT_MASK) | *slot;
+			}
+			return earliestExpiry(m_levels[level][*slot]);
+		}
+		return earliestExpiry(m_overflow);
+	}
+
+	//!
+	//! \brief Remove all timers.
+	//!
+	void clear()
+	{
+		for (auto &level : m_levels)
+		{
+			for (auto &slot : level)
+			{
+				slot.clear();
+			}
+		}
+		m_occupiedSlots = {};
+		m_overflow.clear();
+		m_timers.clear();
+	}
+
+private:
+	static constexpr size_t BITS_PER_LEVEL = 8;
+	static constexpr size_t SLOTS_PER_LEVEL = size_t{ 1 } << BITS_PER_LEVEL;
+	static constexpr size_t NUMBER_OF_LEVELS = 4;
+	static constexpr Tick SLOT_MASK = SLOTS_PER_LEVEL - 1;
+	static constexpr size_t BITMAP_WORDS = SLOTS_PER_LEVEL / 64;
+
+	//! Location of a timer in the wheel.
+	struct Timer
+	{
+		Tick expiry = 0;
+		size_t level = 0;
+		size_t slot = 0;
+		size_t index = 0;
+	};
+
+	using Entry = typename std::unordered_map<Key, Timer>::value_type;
+
+	// Pointers to the entries of m_timers are stable, so the slots refer to them directly.
+	using Slot = std::vector<Entry *>;
+
+	static size_t getSlotIndex(const Tick tick, const size_t level)
+	{
+		return static_cast<size_t>((tick >> (level * BITS_PER_LEVEL)) & SLOT_MASK);
+	}
+
+	static Tick earliestExpiry(const Slot &slot)
+	{
+		return std::ranges::min(slot, {}, [](const Entry *entry) { return entry->second.expiry; })->second.expiry;
+	}
+
+	//!
+	//! \brief Find the first occupied slot of a level.
+	//! \param level - Level to be searched.
+	//! \param from - First slot to be considered.
+	//! \return The index of the slot, or nothing if all slots from "from" on are empty.
+	//!
+	std::optional<size_t> findOccupiedSlot(const size_t level, const size_t from) const
+	{
+		for (size_t word = from / 64; word < BITMAP_WORDS; ++word)
+		{
+			uint64_t bits = m_occupiedSlots[level][word];
+			if (word == from / 64)
+			{
+				bits &= ~uint64_t{ 0 } << (from % 64);
+			}
+			if (bits != 0)
+			{
+				return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+			}
+		}
+		return std::nullopt;
+	}
+
+	Slot &getSlot(const Timer &timer)
+	{
+		return timer.level == NUMBER_OF_LEVELS ? m_overflow : m_levels[timer.level][timer.slot];
+	}
+
+	void place(Entry &entry)
+	{
+		Timer &timer = entry.second;
+		const Tick difference = timer.expiry ^ m_currentTick;
+		timer.level = difference == 0 ? 0 : (static_cast<size_t>(std::bit_width(difference)) - 1) / BITS_PER_LEVEL;
+		if (timer.level >= NUMBER_OF_LEVELS)
+		{
+			timer.level = NUMBER_OF_LEVELS;
+		}
+		else
+		{
+			timer.slot = getSlotIndex(timer.expiry, timer.level);
+			m_occupiedSlots[timer.level][timer.slot / 64] |= uint64_t{ 1 } << (timer.slot % 64);
+		}
+		Slot &slot = getSlot(timer);
+		timer.index = slot.size();
+		slot.push_back(&entry);
+	}
+
+	void unlink(Entry &entry)
+	{
+		const Timer &timer = entry.second;
+		Slot &slot = getSlot(timer);
+		slot[timer.index] = slot.back();
+		slot[timer.index]->second.index = timer.index;
+		slot.pop_back();
+		if (slot.empty() && timer.level < NUMBER_OF_LEVELS)
+		{
+			m_occupiedSlots[timer.level][timer.slot / 64] &= ~(uint64_t{ 1 } << (timer.slot % 64));
+		}
+	}
+
+	//!
+	//! \brief Move the current tick forward and cascade the timers that get closer to their expiry. There must be
+	//! no timers expiring before the new tick.
+	//! \param tick - The new current tick.
+	//!
+	void jumpTo(const Tick tick)
+	{
+		const Tick difference = tick ^ m_currentTick;
+		m_currentTick = tick;
+		if (difference == 0)
+		{
+			return;
+		}
+
+		const size_t highestLevel = (static_cast<size_t>(std::bit_width(difference)) - 1) / BITS_PER_LEVEL;
+		if (highestLevel >= NUMBER_OF_LEVELS)
+		{
+			replace(m_overflow);
+		}
+		// Only the slot matching the new tick holds timers that must move down. Higher levels are cascaded
+		// first, so that their timers are cascaded again by the levels below if needed.
+		for (size_t level = std::min(highestLevel, NUMBER_OF_LEVELS - 1); level > 0; --level)
+		{
+			const size_t slotIndex = getSlotIndex(tick, level);
+			m_occupiedSlots[level][slotIndex / 64] &= ~(uint64_t{ 1 } << (slotIndex % 64));
+			replace(m_levels[level][slotIndex]);
+		}
+	}
+
+	void replace(Slot &slot)
+	{
+		m_cascading.swap(slot);
+		for (Entry *entry : m_cascading)
+		{
+			place(*entry);
+		}
+		m_cascading.clear();
+	}
+
+	void collectExpired(std::vector<Key> &expired)
+	{
+		Slot &slot = m_levels[0][getSlotIndex(m_currentTick, 0)];
+		if (slot.empty())
+		{
+			return;
+		}
+		for (Entry *entry : slot)
+		{
+			expired.push_back(entry->first);
+		}
+		const size_t slotIndex = getSlotIndex(m_currentTick, 0);
+		m_occupiedSlots[0][slotIndex / 64] &= ~(uint64_t{ 1 } << (slotIndex % 64));
+		m_cascading.swap(slot);
+		for (Entry *entry : m_cascading)
+		{
+			m_timers.erase(entry->first);
+		}
+		m_cascading.clear();
+	}
+
+	//! All the scheduled timers, by key.
+	std::unordered_map<Key, Timer> m_timers;
+
+	//! Slots of each level.
+	std::array<std::array<Slot, SLOTS_PER_LEVEL>, NUMBER_OF_LEVELS> m_levels;
+
+	//! Bitmaps of the occupied slots of each level.
+	std::array<std::array<uint64_t, BITMAP_WORDS>, NUMBER_OF_LEVELS> m_occupiedSlots = {};
+
+	//! Timers beyond the range of the levels.
+	Slot m_overflow;
+
+	//! Scratch slot used while moving timers, to avoid allocations.
+	Slot m_cascading;
+
+	//! The tick the wheel was last advanced to.
+	Tick m_currentTick = 0;
+};
+
+} // namespace ptne
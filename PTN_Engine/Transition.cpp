@@ -25,6 +25,7 @@
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <mutex>
 #include <vector>
 
@@ -32,21 +33,151 @@ namespace ptne
 {
 using namespace std;
 
+void TransitionArcs::addArc(const shared_ptr<Place> &place, const ArcProperties::Type type, const size_t weight)
+{
+	auto addArcTo = [&place, weight](auto &placesContainer)
+	{
+		auto sameNameAs = [&place](const auto &arc)
+		{ return lockWeakPtr(arc.place)->getName() == place->getName(); };
+
+		if (ranges::find_if(placesContainer, sameNameAs) != placesContainer.cend())
+		{
+			throw PTN_Exception("Arc already exists");
+		}
+		placesContainer.push_back({ place, weight });
+	};
+
+	using enum ArcProperties::Type;
+	switch (type)
+	{
+	default:
+	{
+		throw PTN_Exception("Unexpected type");
+	}
+	case ACTIVATION:
+	{
+		addArcTo(activationArcs);
+		break;
+	}
+	case BIDIRECTIONAL:
+	{
+		addArcTo(activationArcs);
+		addArcTo(destinationArcs);
+		break;
+	}
+	case DESTINATION:
+	{
+		addArcTo(destinationArcs);
+		break;
+	}
+	case INHIBITOR:
+	{
+		addArcTo(inhibitorArcs);
+		break;
+	}
+	case RESET:
+	{
+		addArcTo(resetArcs);
+		break;
+	}
+	case READ:
+	{
+		addArcTo(readArcs);
+		break;
+	}
+	}
+}
+
+void TransitionArcs::removeArc(const shared_ptr<Place> &place, const ArcProperties::Type type)
+{
+	auto removePlaceFrom = [&place](auto &placesContainer)
+	{
+		auto sameNameAs = [&place](const auto &arc)
+		{ return lockWeakPtr(arc.place)->getName() == place->getName(); };
+
+		auto it = ranges::find_if(placesContainer, sameNameAs);
+		if (it != placesContainer.cend())
+		{
+			placesContainer.erase(it);
+		}
+		else
+		{
+			throw PTN_Exception("Cannot remove palce " + place->getName());
+		}
+	};
+
+	using enum ArcProperties::Type;
+	switch (type)
+	{
+	default:
+	{
+		throw PTN_Exception("Unexpected type");
+	}
+	case ACTIVATION:
+	{
+		removePlaceFrom(activationArcs);
+		break;
+	}
+	case BIDIRECTIONAL:
+	{
+		removePlaceFrom(activationArcs);
+		removePlaceFrom(destinationArcs);
+		break;
+	}
+	case DESTINATION:
+	{
+		removePlaceFrom(destinationArcs);
+		break;
+	}
+	case INHIBITOR:
+	{
+		removePlaceFrom(inhibitorArcs);
+		break;
+	}
+	case RESET:
+	{
+		removePlaceFrom(resetArcs);
+		break;
+	}
+	case READ:
+	{
+		removePlaceFrom(readArcs);
+		break;
+	}
+	}
+}
+
 Transition::~Transition() = default;
 
 Transition::Transition(const string &name,
                        const vector<Arc> &activationArcs,
                        const vector<Arc> &destinationArcs,
                        const vector<Arc> &inhibitorArcs,
-                       const vector<pair<string, ConditionFunction>> &additionalActivationConditions,
-                       const bool requireNoActionsInExecution)
+                       const vector<pair<string, Condition>> &additionalActivationConditions,
+                       const bool requireNoActionsInExecution,
+                       const chrono::milliseconds minimumDelay,
+                       const chrono::milliseconds maximumDelay,
+                       const vector<Arc> &resetArcs,
+                       const vector<Arc> &readArcs,
+                       const bool batchFiring)
 : m_name(name)
 , m_activationArcs(activationArcs)
 , m_destinationArcs(destinationArcs)
 , m_additionalActivationConditions(additionalActivationConditions)
 , m_inhibitorArcs(inhibitorArcs)
+, m_resetArcs(resetArcs)
+, m_readArcs(readArcs)
+, m_minimumDelay(minimumDelay)
+, m_maximumDelay(maximumDelay)
 , m_requireNoActionsInExecution(requireNoActionsInExecution)
+, m_batchFiring(batchFiring)
 {
+	if (minimumDelay < chrono::milliseconds::zero() || maximumDelay < chrono::milliseconds::zero() ||
+		(maximumDelay != chrono::milliseconds::zero() && maximumDelay < minimumDelay))
+	{
+		throw InvalidFiringWindowException(name);
+	}
+
 	auto getPlacesFromArcs = [](const vector<Arc> &arcs)
 	{
 		vector<WeakPtrPlace> places;
@@ -57,6 +188,8 @@ Transition::Transition(const string &name,
 	utility::detectRepeated<Place, ActivationPlaceRepetitionException>(getPlacesFromArcs(activationArcs));
 	utility::detectRepeated<Place, DestinationPlaceRepetitionException>(getPlacesFromArcs(destinationArcs));
 	utility::detectRepeated<Place, InhibitorPlaceRepetitionException>(getPlacesFromArcs(inhibitorArcs));
+	utility::detectRepeated<Place, ResetPlaceRepetitionException>(getPlacesFromArcs(resetArcs));
+	utility::detectRepeated<Place, ReadPlaceRepetitionException>(getPlacesFromArcs(readArcs));
 
 	auto validateWeights = [](const vector<Arc> &arcs)
 	{
@@ -69,6 +202,7 @@ Transition::Transition(const string &name,
 	validateWeights(activationArcs);
 	validateWeights(destinationArcs);
 	validateWeights(inhibitorArcs);
+	validateWeights(readArcs);
 }
 
 string Transition::getName() const
@@ -77,26 +211,24 @@ string Transition::getName() const
 	return m_name;
 }
 
-bool Transition::execute()
+size_t Transition::execute(const bool checkFiringWindow, const bool checkConditions, const size_t maxFirings)
 {
 	unique_lock guard(m_mutex);
-	bool result = false;
+	size_t firings = 0;
 
 	blockStartingOnEnterActions(true);
 
-	if (!isActive())
-	{
-		result = false;
-	}
-	else
+	if (maxFirings != 0 && isActive(checkFiringWindow, checkConditions))
 	{
-		performTransit();
-		result = true;
+		firings = min(maxFirings, getEnablingDegree());
+		performTransit(firings);
+		// Firing restarts the count, in case the transition remains enabled.
+		m_enabledSince.reset();
 	}
 
 	blockStartingOnEnterActions(false);
 
-	return result;
+	return firings;
 }
 
 bool Transition::isEnabled() const
@@ -105,8 +237,19 @@ bool Transition::isEnabled() const
 	return isEnabledInternal();
 }
 
+bool Transition::canFire() const
+{
+	shared_lock guard(m_mutex);
+	return isActive(true, true);
+}
+
 bool Transition::isEnabledInternal() const
 {
+	if (m_retired)
+	{
+		return false;
+	}
+
 	if (!checkInhibitorPlaces())
 	{
 		return false;
@@ -117,13 +260,68 @@ bool Transition::isEnabledInternal() const
 		return false;
 	}
 
+	if (!checkReadPlaces())
+	{
+		return false;
+	}
+
+	if (!checkDestinationPlaces())
+	{
+		return false;
+	}
+
 	return true;
 }
 
-bool Transition::isActive() const
+bool Transition::isActive(const bool checkFiringWindow, const bool checkConditions) const
+{
+	return isEnabledInternal() &&
+		   (!checkConditions || !m_requireNoActionsInExecution || noActionsInExecution()) &&
+		   (!checkFiringWindow || !isTimed() || isWithinFiringWindowInternal(chrono::steady_clock::now())) &&
+		   (!checkConditions || checkAdditionalConditions());
+}
+
+bool Transition::isTimed() const
+{
+	return m_minimumDelay != chrono::milliseconds::zero() || m_maximumDelay != chrono::milliseconds::zero();
+}
+
+optional<chrono::steady_clock::time_point> Transition::startEnabledTime(const chrono::steady_clock::time_point now)
+{
+	unique_lock guard(m_mutex);
+	if (m_enabledSince.has_value())
+	{
+		return nullopt;
+	}
+	m_enabledSince = now;
+	return now + m_minimumDelay;
+}
+
+void Transition::resetEnabledTime()
 {
-	return isEnabledInternal() && (!m_requireNoActionsInExecution || noActionsInExecution()) &&
-		   checkAdditionalConditions();
+	unique_lock guard(m_mutex);
+	m_enabledSince.reset();
+}
+
+bool Transition::isWithinFiringWindow(const chrono::steady_clock::time_point now) const
+{
+	shared_lock guard(m_mutex);
+	return isWithinFiringWindowInternal(now);
+}
+
+bool Transition::isWithinFiringWindowInternal(const chrono::steady_clock::time_point now) const
+{
+	if (m_minimumDelay == chrono::milliseconds::zero() && m_maximumDelay == chrono::milliseconds::zero())
+	{
+		return true;
+	}
+	if (!m_enabledSince.has_value())
+	{
+		return false;
+	}
+	const auto enabledFor = now - *m_enabledSince;
+	return enabledFor >= m_minimumDelay &&
+		   (m_maximumDelay == chrono::milliseconds::zero() || enabledFor <= m_maximumDelay);
 }
 
 vector<Arc> Transition::getActivationArcs() const
@@ -138,7 +336,7 @@ vector<Arc> Transition::getDestinationArcs() const
 	return m_destinationArcs;
 }
 
-vector<pair<string, ConditionFunction>> Transition::getAdditionalActivationConditions() const
+vector<pair<string, Condition>> Transition::getAdditionalActivationConditions() const
 {
 	shared_lock guard(m_mutex);
 	return m_additionalActivationConditions;
@@ -150,6 +348,18 @@ vector<Arc> Transition::getInhibitorArcs() const
 	return m_inhibitorArcs;
 }
 
+vector<Arc> Transition::getResetArcs() const
+{
+	shared_lock guard(m_mutex);
+	return m_resetArcs;
+}
+
+vector<Arc> Transition::getReadArcs() const
+{
+	shared_lock guard(m_mutex);
+	return m_readArcs;
+}
+
 bool Transition::checkInhibitorPlaces() const
 {
 	auto numberOfTokensGreaterThan0 = [](const auto &inhibitorArc)
@@ -181,12 +391,24 @@ TransitionProperties Transition::getTransitionProperties() const
 		return additionalActivationConditionNames;
 	};
 
-	auto getAdditionalConditions = [this]()
+	auto getAdditionalConditions = [this, &transitionProperties]()
 	{
 		vector<ConditionFunction> additionalActivationConditions;
 		for (const auto &[_, additionalActivationCondition] : m_additionalActivationConditions)
 		{
-			additionalActivationConditions.push_back(additionalActivationCondition);
+			if (const ConditionFunction *conditionFunction = additionalActivationCondition.getConditionFunction())
+			{
+				additionalActivationConditions.push_back(*conditionFunction);
+			}
+			else if (additionalActivationCondition)
+			{
+				transitionProperties.additionalContextConditions.push_back(
+				additionalActivationCondition.getContextCondition());
+			}
+			else
+			{
+				additionalActivationConditions.emplace_back();
+			}
 		}
 		return additionalActivationConditions;
 	};
@@ -208,8 +430,13 @@ TransitionProperties Transition::getTransitionProperties() const
 	transitionProperties.activationArcs = getProperties(getActivationArcs(), ArcProperties::Type::ACTIVATION);
 	transitionProperties.destinationArcs = getProperties(getDestinationArcs(), ArcProperties::Type::DESTINATION);
 	transitionProperties.inhibitorArcs = getProperties(getInhibitorArcs(), ArcProperties::Type::INHIBITOR);
+	transitionProperties.resetArcs = getProperties(getResetArcs(), ArcProperties::Type::RESET);
+	transitionProperties.readArcs = getProperties(getReadArcs(), ArcProperties::Type::READ);
 	transitionProperties.name = getName();
 	transitionProperties.requireNoActionsInExecution = m_requireNoActionsInExecution;
+	transitionProperties.minimumDelay = m_minimumDelay;
+	transitionProperties.maximumDelay = m_maximumDelay;
+	transitionProperties.batchFiring = m_batchFiring;
 
 	return transitionProperties;
 }
@@ -217,99 +444,44 @@ TransitionProperties Transition::getTransitionProperties() const
 void Transition::addArc(const shared_ptr<Place> &place, const ArcProperties::Type type, const size_t weight)
 {
 	unique_lock guard(m_mutex);
-
-	auto addArcTo = [&place, weight](auto &placesContainer)
-	{
-		auto sameNameAs = [&place](const auto &arc)
-		{ return lockWeakPtr(arc.place)->getName() == place->getName(); };
-
-		if (ranges::find_if(placesContainer, sameNameAs) != placesContainer.cend())
-		{
-			throw PTN_Exception("Arc already exists");
-		}
-		placesContainer.push_back({ place, weight });
-	};
-
-	using enum ArcProperties::Type;
-	switch (type)
-	{
-	default:
-	{
-		throw PTN_Exception("Unexpected type");
-	}
-	case ACTIVATION:
-	{
-		addArcTo(m_activationArcs);
-		break;
-	}
-	case BIDIRECTIONAL:
-	{
-		addArcTo(m_activationArcs);
-		addArcTo(m_destinationArcs);
-		break;
-	}
-	case DESTINATION:
-	{
-		addArcTo(m_destinationArcs);
-		break;
-	}
-	case INHIBITOR:
-	{
-		addArcTo(m_inhibitorArcs);
-		break;
-	}
-	}
+	TransitionArcs arcs{ m_activationArcs, m_destinationArcs, m_inhibitorArcs, m_resetArcs, m_readArcs };
+	arcs.addArc(place, type, weight);
+	swapArcsInternal(arcs);
 }
 
 void Transition::removeArc(const shared_ptr<Place> &place, const ArcProperties::Type type)
 {
 	unique_lock guard(m_mutex);
+	TransitionArcs arcs{ m_activationArcs, m_destinationArcs, m_inhibitorArcs, m_resetArcs, m_readArcs };
+	arcs.removeArc(place, type);
+	swapArcsInternal(arcs);
+}
 
-	auto removePlaceFrom = [&place](auto &placesContainer)
-	{
-		auto sameNameAs = [&place](const auto &arc)
-		{ return lockWeakPtr(arc.place)->getName() == place->getName(); };
+void Transition::retire()
+{
+	unique_lock guard(m_mutex);
+	m_retired = true;
+}
 
-		auto it = ranges::find_if(placesContainer, sameNameAs);
-		if (it != placesContainer.cend())
-		{
-			placesContainer.erase(it);
-		}
-		else
-		{
-			throw PTN_Exception("Cannot remove palce " + place->getName());
-		}
-	};
+TransitionArcs Transition::getArcs() const
+{
+	shared_lock guard(m_mutex);
+	return TransitionArcs{ m_activationArcs, m_destinationArcs, m_inhibitorArcs, m_resetArcs, m_readArcs };
+}
 
-	using enum ArcProperties::Type;
-	switch (type)
-	{
-	default:
-	{
-		throw PTN_Exception("Unexpected type");
-	}
-	case ACTIVATION:
-	{
-		removePlaceFrom(m_activationArcs);
-		break;
-	}
-	case BIDIRECTIONAL:
-	{
-		removePlaceFrom(m_activationArcs);
-		removePlaceFrom(m_destinationArcs);
-		break;
-	}
-	case DESTINATION:
-	{
-		removePlaceFrom(m_destinationArcs);
-		break;
-	}
-	case INHIBITOR:
-	{
-		removePlaceFrom(m_inhibitorArcs);
-		break;
-	}
-	}
+void Transition::swapArcs(TransitionArcs &arcs)
+{
+	unique_lock guard(m_mutex);
+	swapArcsInternal(arcs);
+}
+
+void Transition::swapArcsInternal(TransitionArcs &arcs)
+{
+	m_activationArcs.swap(arcs.activationArcs);
+	m_destinationArcs.swap(arcs.destinationArcs);
+	m_inhibitorArcs.swap(arcs.inhibitorArcs);
+	m_resetArcs.swap(arcs.resetArcs);
+	m_readArcs.swap(arcs.readArcs);
 }
 
 bool Transition::checkActivationPlaces() const
@@ -329,6 +501,45 @@ bool Transition::checkActivationPlaces() const
 	return true;
 }
 
+bool Transition::checkReadPlaces() const
+{
+	auto hasEnoughTokens = [](const Arc &readArc)
+	{ return lockWeakPtr(readArc.place)->getNumberOfTokens() >= readArc.weight; };
+
+	return ranges::all_of(m_readArcs, hasEnoughTokens);
+}
+
+bool Transition::checkDestinationPlaces() const
+{
+	for (const Arc &destinationArc : m_destinationArcs)
+	{
+		SharedPtrPlace spPlace = lockWeakPtr(destinationArc.place);
+		const size_t capacity = spPlace->getCapacity();
+		if (capacity == 0)
+		{
+			continue;
+		}
+
+		auto isSamePlace = [&spPlace](const Arc &arc) { return arc.place.lock() == spPlace; };
+
+		size_t tokens = 0;
+		if (ranges::find_if(m_resetArcs, isSamePlace) == m_resetArcs.end())
+		{
+			tokens = spPlace->getNumberOfTokens();
+			if (auto it = ranges::find_if(m_activationArcs, isSamePlace); it != m_activationArcs.end())
+			{
+				tokens -= min(tokens, it->weight);
+			}
+		}
+
+		if (tokens > capacity || destinationArc.weight > capacity - tokens)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 bool Transition::checkAdditionalConditions() const
 {
 	for (const auto &[name, activationCondition] : m_additionalActivationConditions)
@@ -363,13 +574,52 @@ bool Transition::noActionsInExecution() const
 	return true;
 }
 
-void Transition::performTransit() const
+size_t Transition::getEnablingDegree() const
+{
+	// A source transition would fire without bound, and reset arcs or firing windows need single firings.
+	if (!m_batchFiring || m_activationArcs.empty() || !m_resetArcs.empty() || isTimed())
+	{
+		return 1;
+	}
+
+	size_t degree = numeric_limits<size_t>::max();
+	for (const Arc &activationArc : m_activationArcs)
+	{
+		degree = min(degree, lockWeakPtr(activationArc.place)->getNumberOfTokens() / activationArc.weight);
+	}
+
+	for (const Arc &destinationArc : m_destinationArcs)
+	{
+		SharedPtrPlace spPlace = lockWeakPtr(destinationArc.place);
+		auto isSamePlace = [&spPlace](const Arc &arc) { return arc.place.lock() == spPlace; };
+
+		// Tokens given to an inhibitor place disable the transition after the first firing.
+		if (ranges::find_if(m_inhibitorArcs, isSamePlace) != m_inhibitorArcs.end())
+		{
+			return 1;
+		}
+
+		const size_t capacity = spPlace->getCapacity();
+		const auto activationArc = ranges::find_if(m_activationArcs, isSamePlace);
+		const size_t consumed = activationArc != m_activationArcs.end() ? activationArc->weight : 0;
+		if (capacity != 0 && destinationArc.weight > consumed)
+		{
+			// The first firing is known to fit, since the transition is enabled.
+			const size_t room = capacity - spPlace->getNumberOfTokens();
+			degree = min(degree, room / (destinationArc.weight - consumed));
+		}
+	}
+	return max<size_t>(degree, 1);
+}
+
+void Transition::performTransit(const size_t firings) const
 {
-	exitActivationPlaces();
-	enterDestinationPlaces();
+	exitActivationPlaces(firings);
+	resetPlaces();
+	enterDestinationPlaces(firings);
 }
 
-void Transition::exitActivationPlaces() const
+void Transition::exitActivationPlaces(const size_t firings) const
 {
 	for (const Arc &activationArc : m_activationArcs)
 	{
@@ -378,12 +628,23 @@ void Transition::exitActivationPlaces() const
 
 		if (SharedPtrPlace spPlace = lockWeakPtr(activationPlace))
 		{
-			spPlace->exitPlace(activationWeight);
+			spPlace->exitPlace(activationWeight * firings, firings);
+		}
+	}
+}
+
+void Transition::resetPlaces() const
+{
+	for (const Arc &resetArc : m_resetArcs)
+	{
+		if (SharedPtrPlace spPlace = lockWeakPtr(resetArc.place))
+		{
+			spPlace->resetPlace();
 		}
 	}
 }
 
-void Transition::enterDestinationPlaces() const
+void Transition::enterDestinationPlaces(const size_t firings) const
 {
 	for (const Arc &destinationArc : m_destinationArcs)
 	{
@@ -392,7 +653,7 @@ void Transition::enterDestinationPlaces() const
 
 		if (SharedPtrPlace spPlace = lockWeakPtr(destinationPlace))
 		{
-			spPlace->enterPlace(destinationWeight);
+			spPlace->enterPlace(destinationWeight * firings, firings);
 		}
 	}
 }
@@ -20,9 +20,12 @@
 
 #pragma once
 
+#include "PTN_Engine/Condition.h"
 #include "PTN_Engine/PTN_Engine.h"
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
 #include <vector>
 
@@ -41,6 +44,33 @@ struct Arc
 	size_t weight = 1;
 };
 
+//!
+//! \brief Arcs of a transition. Structural updates edit a copy, which then replaces the arcs of the transition.
+//!
+struct TransitionArcs
+{
+	std::vector<Arc> activationArcs;
+	std::vector<Arc> destinationArcs;
+	std::vector<Arc> inhibitorArcs;
+	std::vector<Arc> resetArcs;
+	std::vector<Arc> readArcs;
+
+	//!
+	//! \brief Add an arc. Throws PTN_Exception if the place already has an arc of the same type.
+	//! \param place - Place linked by the arc.
+	//! \param type - Type of the arc.
+	//! \param weight - Weight of the arc.
+	//!
+	void addArc(const std::shared_ptr<Place> &place, const ArcProperties::Type type, const size_t weight);
+
+	//!
+	//! \brief Remove an arc. Throws PTN_Exception if the place has no arc of the given type.
+	//! \param place - Place linked by the arc.
+	//! \param type - Type of the arc.
+	//!
+	void removeArc(const std::shared_ptr<Place> &place, const ArcProperties::Type type);
+};
+
 //! \brief Implements a Petri net transition.
 class Transition final
 {
@@ -56,13 +86,23 @@ public:
 	//! \param additionalActivationConditions - vector of additional conditions
 	//! \param requireNoActionsInExecution - flag if the transition requires no onEnter actions in execution in
 	//! order to fire.
+	//! \param minimumDelay - time the transition must remain enabled before firing.
+	//! \param maximumDelay - time after being enabled after which the transition cannot fire. Zero for no deadline.
+	//! \param resetArcs - vector of reset arcs, whose places are emptied when the transition fires.
+	//! \param readArcs - vector of read arcs, whose places must have enough tokens, which are not taken.
+	//! \param batchFiring - whether the transition fires as many times as it is enabled at once.
 	//!
 	Transition(const std::string &name,
 			   const std::vector<Arc> &activationArcs,
 			   const std::vector<Arc> &destinationArcs,
 			   const std::vector<Arc> &inhibitorArcs,
-			   const std::vector<std::pair<std::string, ConditionFunction>> &additionalActivationConditions,
-			   const bool requireNoActionsInExecution);
+			   const std::vector<std::pair<std::string, Condition>> &additionalActivationConditions,
+			   const bool requireNoActionsInExecution,
+			   const std::chrono::milliseconds minimumDelay = std::chrono::milliseconds::zero(),
+			   const std::chrono::milliseconds maximumDelay = std::chrono::milliseconds::zero(),
+			   const std::vector<Arc> &resetArcs = {},
+			   const std::vector<Arc> &readArcs = {},
+			   const bool batchFiring = false);
 
 	Transition(const Transition &) = delete;
 	Transition(Transition &&transition) = delete;
@@ -73,28 +113,83 @@ public:
 
 	//!
 	//! Evaluate the activation places and transit the tokens if possible.
-	//! \return true if token transit was performed, false if not.
+	//! \param checkFiringWindow - Whether the firing window of timed transitions is checked against the current
+	//! time. Simulations, which use a virtual time, disable it.
+	//! \param checkConditions - Whether the additional conditions and the actions in execution are checked.
+	//! Replays of recorded firings, for which they held, disable it.
+	//! \param maxFirings - Maximum number of firings of a batch firing transition. Other transitions fire once.
+	//! \return The number of times the transition fired, zero if it was not enabled.
 	//!
-	bool execute();
+	size_t execute(const bool checkFiringWindow = true, const bool checkConditions = true, const size_t maxFirings = 1);
 
 	std::vector<Arc> getActivationArcs() const;
 
+	//!
+	//! \brief Get a copy of all the arcs of the transition.
+	//! \return The arcs.
+	//!
+	TransitionArcs getArcs() const;
+
+	//!
+	//! \brief Exchange the arcs of the transition with the given ones, in constant time.
+	//! \param arcs - The new arcs, replaced by the previous arcs of the transition.
+	//!
+	void swapArcs(TransitionArcs &arcs);
+
 	//!
 	//! Evaluates if the transition can attempt to be fired.
 	//! \return true if can attepmt to be fire the transition.
 	//!
 	bool isEnabled() const;
 
+	//!
+	//! \brief Evaluates if the transition can be fired now: it is enabled, its additional conditions hold, no
+	//! actions it waits for are in execution, and it is within its firing window.
+	//! \return true if execute would fire the transition.
+	//!
+	bool canFire() const;
+
+	//!
+	//! \brief Whether the transition has a firing delay or a deadline.
+	//! \return true if the transition is timed.
+	//!
+	bool isTimed() const;
+
+	//!
+	//! \brief Start counting the time the transition is enabled, if not yet started. To be called while the
+	//! transition is enabled.
+	//! \param now - Current time.
+	//! \return The time from which the transition can fire, if the count was started by this call.
+	//!
+	std::optional<std::chrono::steady_clock::time_point>
+	startEnabledTime(const std::chrono::steady_clock::time_point now);
+
+	//!
+	//! \brief Stop counting the time the transition is enabled. To be called while the transition is disabled.
+	//!
+	void resetEnabledTime();
+
+	//!
+	//! \brief Whether the time the transition has been enabled allows it to fire.
+	//! \param now - Current time.
+	//! \return true if the transition is not timed, or if now is within its firing window.
+	//!
+	bool isWithinFiringWindow(const std::chrono::steady_clock::time_point now) const;
+
 	//!
 	//! \brief Get all additional activation conditions.
-	//! \return A vector of function name, ConditionFunction pairs.
+	//! \return A vector of function name, Condition pairs.
 	//!
-	std::vector<std::pair<std::string, ConditionFunction>> getAdditionalActivationConditions() const;
+	std::vector<std::pair<std::string, Condition>> getAdditionalActivationConditions() const;
 
 	std::vector<Arc> getDestinationArcs() const;
 
 	std::vector<Arc> getInhibitorArcs() const;
 
+	std::vector<Arc> getResetArcs() const;
+
+	std::vector<Arc> getReadArcs() const;
+
 	std::string getName() const;
 
 	//!
@@ -110,6 +205,12 @@ public:
 	//!
 	void removeArc(const std::shared_ptr<Place> &place, const ArcProperties::Type type);
 
+	//!
+	//! \brief Disable the transition permanently, when it is removed from the net. Its places may no longer
+	//! exist, so it is not evaluated again.
+	//!
+	void retire();
+
 private:
 	//! Block/unblock activation places from starting any on enter actions.
 	void blockStartingOnEnterActions(const bool value) const;
@@ -126,23 +227,47 @@ private:
 	//!
 	bool checkActivationPlaces() const;
 
+	//!
+	//! \brief Checks if all read places have at least as many tokens as the weights of their arcs.
+	//! \return True if all read places have enough tokens.
+	//!
+	bool checkReadPlaces() const;
+
+	//!
+	//! \brief Checks if the destination places with a capacity have room for the tokens produced by the
+	//! transition, after the tokens it consumes from them have left.
+	//! \return True if no destination place would exceed its capacity.
+	//!
+	bool checkDestinationPlaces() const;
+
 	//!
 	//! \brief Checks if all additional conditions allow firing the transition.
 	//! \return True if all additional conditions are true.
 	//!
 	bool checkAdditionalConditions() const;
 
-	//! Inserts tokens in the destination places.
-	void enterDestinationPlaces() const;
+	//!
+	//! \brief Inserts tokens in the destination places.
+	//! \param firings - Number of firings whose tokens are inserted.
+	//!
+	void enterDestinationPlaces(const size_t firings) const;
+
+	//!
+	//! \brief Removes the tokens from the activation places.
+	//! \param firings - Number of firings whose tokens are removed.
+	//!
+	void exitActivationPlaces(const size_t firings) const;
 
-	//! Removes the tokens from the activation places.
-	void exitActivationPlaces() const;
+	//! Removes all the tokens from the reset places.
+	void resetPlaces() const;
 
 	//!
 	//! \brief Evaluates if the transition can be fired.
+	//! \param checkFiringWindow - Whether the firing window of timed transitions is checked.
+	//! \param checkConditions - Whether the additional conditions and the actions in execution are checked.
 	//! \return true if can be fired, false if it cannot.
 	//!
-	bool isActive() const;
+	bool isActive(const bool checkFiringWindow, const bool checkConditions) const;
 
 	//!
 	//! \brief Evaluates if the transition can be fired.
@@ -150,33 +275,74 @@ private:
 	//!
 	bool isEnabledInternal() const;
 
+	//!
+	//! \brief Whether the time the transition has been enabled allows it to fire. Requires m_mutex to be locked.
+	//! \param now - Current time.
+	//! \return true if the transition is not timed, or if now is within its firing window.
+	//!
+	bool isWithinFiringWindowInternal(const std::chrono::steady_clock::time_point now) const;
+
 	//!
 	//! \brief If there are no actions being currently executed in the activation places.
 	//! \return true if there are no actions being currently executed in the activation places.
 	//!
 	bool noActionsInExecution() const;
 
-	//! Moves the tokens from the inputs to the outputs.
-	void performTransit() const;
+	//!
+	//! \brief Number of times an enabled transition can fire in a row, without other firings in between.
+	//! \return The enabling degree, one if the transition does not fire in batches.
+	//!
+	size_t getEnablingDegree() const;
+
+	//!
+	//! \brief Moves the tokens from the inputs to the outputs.
+	//! \param firings - Number of firings whose tokens are moved at once.
+	//!
+	void performTransit(const size_t firings) const;
+
+	//!
+	//! \brief Exchange the arcs of the transition with the given ones. Requires m_mutex to be locked.
+	//! \param arcs - The new arcs, replaced by the previous arcs of the transition.
+	//!
+	void swapArcsInternal(TransitionArcs &arcs);
 
 	std::vector<Arc> m_activationArcs;
 
 	//! Pointers to the controller's functions that evaluate if the transition can be fired.
-	std::vector<std::pair<std::string, ConditionFunction>> m_additionalActivationConditions;
+	std::vector<std::pair<std::string, Condition>> m_additionalActivationConditions;
 
 	std::vector<Arc> m_destinationArcs;
 
 	std::vector<Arc> m_inhibitorArcs;
 
+	std::vector<Arc> m_resetArcs;
+
+	std::vector<Arc> m_readArcs;
+
 	//! Shared mutex to synchronize calls, allowing simultaneous reads (readers-writer lock).
 	mutable std::shared_mutex m_mutex;
 
 	//! \brief Name that identifies the transition.
 	std::string m_name;
 
+	//! Time the transition must remain enabled before it can fire.
+	const std::chrono::milliseconds m_minimumDelay;
+
+	//! Time after being enabled, after which the transition cannot fire. Zero means no deadline.
+	const std::chrono::milliseconds m_maximumDelay;
+
+	//! Since when the transition is enabled. Only tracked for timed transitions.
+	std::optional<std::chrono::steady_clock::time_point> m_enabledSince;
+
 	//! If on, the transition will only be activated if, besides all other conditions,
 	//! the activation places have no on enter actions in execution.
 	bool m_requireNoActionsInExecution = false;
+
+	//! Whether the transition was removed from the net.
+	bool m_retired = false;
+
+	//! Whether the transition fires as many times as it is enabled at once.
+	const bool m_batchFiring = false;
 };
 
 } // namespace ptne
@@ -29,7 +29,10 @@ namespace ptne
 using namespace std;
 
 TransitionsManager::~TransitionsManager() = default;
-TransitionsManager::TransitionsManager() = default;
+TransitionsManager::TransitionsManager()
+: m_randomGenerator(random_device{}())
+{
+}
 
 bool TransitionsManager::contains(const string &itemName) const
 {
@@ -43,38 +46,109 @@ void TransitionsManager::insert(shared_ptr<Transition> transition)
 	ManagerBase<Transition>::insert(transition);
 }
 
+void TransitionsManager::erase(const string &transitionName)
+{
+	unique_lock itemsGuard(m_itemsMutex);
+	ManagerBase<Transition>::erase(transitionName);
+	unique_lock timersGuard(m_timersMutex);
+	m_timers.cancel(transitionName);
+}
+
 void TransitionsManager::clear()
 {
 	unique_lock itemsGuard(m_itemsMutex);
 	ManagerBase<Transition>::clear();
+	unique_lock timersGuard(m_timersMutex);
+	m_timers.clear();
 }
 
 vector<weak_ptr<Transition>> TransitionsManager::collectEnabledTransitionsRandomly() const
 {
 	shared_lock transitionsGuard(m_itemsMutex);
 
+	const auto now = Clock::now();
 	vector<weak_ptr<Transition>> enabledTransitions;
 	for (const auto &[_, transition] : m_items)
 	{
-		if (transition->isEnabled())
+		const bool isEnabled = transition->isEnabled();
+		if (transition->isTimed())
+		{
+			updateTimer(*transition, isEnabled, now);
+			if (isEnabled && !transition->isWithinFiringWindow(now))
+			{
+				continue;
+			}
+		}
+		if (isEnabled)
 		{
 			enabledTransitions.push_back(transition);
 		}
 	}
 
-	// TO DO check performance
-	random_device randomDevice;
-	mt19937_64 seed(randomDevice());
-	ranges::shuffle(enabledTransitions, seed);
+	{
+		// Expired timers have already woken up the event loop, and their transitions are now collected.
+		unique_lock timersGuard(m_timersMutex);
+		m_timers.advance(static_cast<Tick>(chrono::floor<chrono::milliseconds>(now - m_timersOrigin).count()));
+	}
+
+	{
+		unique_lock randomGeneratorGuard(m_randomGeneratorMutex);
+		ranges::shuffle(enabledTransitions, m_randomGenerator);
+	}
 	return enabledTransitions;
 }
 
+void TransitionsManager::setRandomSeed(const uint64_t seed)
+{
+	unique_lock randomGeneratorGuard(m_randomGeneratorMutex);
+	m_randomGenerator.seed(seed);
+}
+
+optional<chrono::steady_clock::time_point> TransitionsManager::getNextFiringTime() const
+{
+	unique_lock timersGuard(m_timersMutex);
+	if (const auto nextExpiry = m_timers.nextExpiry())
+	{
+		return m_timersOrigin + chrono::milliseconds(*nextExpiry);
+	}
+	return nullopt;
+}
+
+void TransitionsManager::updateTimer(Transition &transition, const bool isEnabled, const Clock::time_point now) const
+{
+	if (!isEnabled)
+	{
+		transition.resetEnabledTime();
+		unique_lock timersGuard(m_timersMutex);
+		m_timers.cancel(transition.getName());
+	}
+	else if (const auto firingTime = transition.startEnabledTime(now); firingTime.has_value() && *firingTime > now)
+	{
+		// Rounded up, so that the event loop never wakes up before the transition can fire.
+		const auto expiry = chrono::ceil<chrono::milliseconds>(*firingTime - m_timersOrigin).count();
+		unique_lock timersGuard(m_timersMutex);
+		m_timers.schedule(transition.getName(), static_cast<Tick>(expiry));
+	}
+}
+
 SharedPtrTransition TransitionsManager::getTransition(const string &transitionName) const
 {
 	shared_lock itemsGuard(m_itemsMutex);
 	return ManagerBase<Transition>::getItem(transitionName);
 }
 
+vector<SharedPtrTransition> TransitionsManager::getTransitions() const
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	vector<SharedPtrTransition> transitions;
+	for (const auto &[_, transition] : m_items)
+	{
+		transitions.push_back(transition);
+	}
+	ranges::sort(transitions, {}, [](const auto &transition) { return transition->getName(); });
+	return transitions;
+}
+
 vector<TransitionProperties> TransitionsManager::getTransitionsProperties() const
 {
 	shared_lock itemsGuard(m_itemsMutex);
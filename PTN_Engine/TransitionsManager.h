@@ -21,7 +21,12 @@
 #pragma once
 
 #include "PTN_Engine/ManagerBase.h"
+#include "PTN_Engine/TimerWheel.h"
 #include "PTN_Engine/Transition.h"
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <shared_mutex>
 
 namespace ptne
@@ -49,22 +54,72 @@ public:
 	void clear();
 
 	//!
-	//! \brief collectEnabledTransitionsRandomly
+	//! \brief collectEnabledTransitionsRandomly. Timed transitions are only collected within their firing window.
 	//! \return A vector of weak pointers to the enabled transitions.
 	//!
 	std::vector<WeakPtrTransition> collectEnabledTransitionsRandomly() const;
 
+	//!
+	//! \brief Get the earliest time at which a timed transition, currently waiting for its minimum delay, can fire.
+	//! \return The earliest firing time, or nothing if no timed transition is waiting.
+	//!
+	std::optional<std::chrono::steady_clock::time_point> getNextFiringTime() const;
+
 	bool contains(const std::string &itemName) const;
 
+	//!
+	//! \brief Remove a transition from the container.
+	//! \param transitionName - Name of the transition.
+	//!
+	void erase(const std::string &transitionName);
+
 	SharedPtrTransition getTransition(const std::string &transitionName) const;
 
+	//!
+	//! \brief Get all transitions, sorted by name.
+	//! \return Vector with all the transitions.
+	//!
+	std::vector<SharedPtrTransition> getTransitions() const;
+
 	std::vector<TransitionProperties> getTransitionsProperties() const;
 
 	void insert(std::shared_ptr<Transition> transition);
 
+	//!
+	//! \brief Seed the generator ordering the enabled transitions.
+	//! \param seed - The seed.
+	//!
+	void setRandomSeed(const uint64_t seed);
+
 private:
+	using Clock = std::chrono::steady_clock;
+	using Tick = TimerWheel<std::string>::Tick;
+
+	//!
+	//! \brief Track the time a timed transition is enabled, and the time at which its minimum delay expires.
+	//! \param transition - Timed transition.
+	//! \param isEnabled - Whether the transition is enabled.
+	//! \param now - Current time.
+	//!
+	void updateTimer(Transition &transition, const bool isEnabled, const Clock::time_point now) const;
+
 	//! Shared mutex to synchronize the access to the items(readers-writer lock).
 	mutable std::shared_mutex m_itemsMutex;
+
+	//! Time of the tick 0 of the timer wheel. Each tick is one millisecond.
+	const Clock::time_point m_timersOrigin = Clock::now();
+
+	//! Minimum delays of the enabled timed transitions, by transition name.
+	mutable TimerWheel<std::string> m_timers;
+
+	//! Mutex protecting m_timers.
+	mutable std::mutex m_timersMutex;
+
+	//! Orders the enabled transitions randomly.
+	mutable std::mt19937_64 m_randomGenerator;
+
+	//! Mutex protecting m_randomGenerator.
+	mutable std::mutex m_randomGeneratorMutex;
 };
 
 } // namespace ptne
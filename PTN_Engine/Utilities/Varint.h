@@ -0,0 +1,66 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ptne::utility
+{
+
+//!
+//! \brief Append an unsigned integer in LEB128 format: 7 bits per byte, least significant first, with the high bit
+//! set in all bytes except the last.
+//! \param bytes - Buffer to append to.
+//! \param value - The integer.
+//!
+inline void writeVarint(std::vector<uint8_t> &bytes, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		bytes.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(static_cast<uint8_t>(value));
+}
+
+//!
+//! \brief Read an unsigned integer written with writeVarint.
+//! \param bytes - Buffer to read from.
+//! \param position - Position of the integer in the buffer. Advanced past it if it is read.
+//! \param value - The integer read.
+//! \return False if the buffer ends before the integer does, or if it does not fit in 64 bits.
+//!
+inline bool readVarint(const std::vector<uint8_t> &bytes, size_t &position, uint64_t &value)
+{
+	value = 0;
+	for (size_t i = position, shift = 0; i < bytes.size() && shift < 64; ++i, shift += 7)
+	{
+		value |= static_cast<uint64_t>(bytes[i] & 0x7f) << shift;
+		if ((bytes[i] & 0x80) == 0)
+		{
+			position = i + 1;
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace ptne::utility
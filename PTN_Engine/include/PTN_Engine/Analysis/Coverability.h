@@ -0,0 +1,117 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/Explicit.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ptne
+{
+
+/*!
+ * \brief Configuration of a coverability analysis.
+ */
+struct DLL_PUBLIC CoverabilityOptions final
+{
+	//!
+	//! \brief Number of threads expanding the coverability tree. Zero uses one thread per core.
+	//!
+	size_t numberOfThreads = 0;
+
+	//!
+	//! \brief Number of nodes of the coverability tree after which the analysis stops, incomplete.
+	//!
+	size_t maxNodes = 1'000'000;
+
+	//!
+	//! \brief Markings whose coverability is checked, as the number of tokens of the places of interest. A
+	//! marking is covered if a reachable marking has at least as many tokens in each of these places.
+	//!
+	std::vector<std::map<std::string, size_t>> targetMarkings;
+};
+
+/*!
+ * \brief Outcome of a coverability analysis.
+ */
+struct DLL_PUBLIC CoverabilityResult final
+{
+	//!
+	//! \brief Whether the coverability tree was completed. If not, the places found unbounded and the markings
+	//! found coverable are still correct, but other places may be unbounded and other markings coverable.
+	//!
+	bool complete = false;
+
+	//!
+	//! \brief Number of nodes of the coverability tree.
+	//!
+	size_t numberOfNodes = 0;
+
+	//!
+	//! \brief Places whose number of tokens can grow without bound, in order of their names.
+	//!
+	std::vector<std::string> unboundedPlaces;
+
+	//!
+	//! \brief Maximum number of tokens of each bounded place, by place name.
+	//!
+	std::map<std::string, size_t> placeBounds;
+
+	//!
+	//! \brief Whether each target marking is coverable, in the order of the options.
+	//!
+	std::vector<bool> coverableTargetMarkings;
+};
+
+//!
+//! \brief Build the coverability tree of a net from its current marking, with the Karp-Miller algorithm.
+//!
+//! Unlike the reachability analysis, this analysis terminates on unbounded nets. When a marking is reached that
+//! has more tokens than one of the markings leading to it, the places that grew are marked as unbounded, since
+//! repeating the same firings makes them grow indefinitely. Markings covered by an existing node of the tree are
+//! not expanded again, and each level of the tree is expanded in parallel.
+//! The input places are treated as unbounded sources of tokens. Otherwise, as in the other analyses, only the
+//! token game is considered: additional conditions are considered true and firing windows are not considered.
+//! Inhibitor arcs make the number of tokens matter beyond covering, so for nets with inhibitor arcs on unbounded
+//! places the result is an approximation. So is the result for nets with reset arcs, where places emptied by a
+//! reset may be reported as unbounded. Places with a capacity are never marked as unbounded, and input places
+//! with a capacity are reported as bounded by it, while the transitions producing tokens into them are considered
+//! disabled. Since extra tokens in a destination place with a capacity can disable a transition, a marking is only
+//! considered covered by one with the same number of tokens in these places. The net itself is not changed.
+//! \param ptnEngine - The net.
+//! \param options - Configuration of the analysis.
+//! \return The unbounded places, the bounds of the other places and the coverable target markings.
+//!
+DLL_PUBLIC CoverabilityResult exploreCoverability(const PTN_Engine &ptnEngine,
+												  const CoverabilityOptions &options = {});
+
+//!
+//! \brief Build the coverability tree of a net from its initial marking, with the Karp-Miller algorithm.
+//! \param placesProperties - The places of the net. The analysis starts from their initialNumberOfTokens.
+//! \param transitionsProperties - The transitions of the net.
+//! \param options - Configuration of the analysis.
+//! \return The unbounded places, the bounds of the other places and the coverable target markings.
+//!
+DLL_PUBLIC CoverabilityResult exploreCoverability(const std::vector<PlaceProperties> &placesProperties,
+												  const std::vector<TransitionProperties> &transitionsProperties,
+												  const CoverabilityOptions &options = {});
+
+} // namespace ptne
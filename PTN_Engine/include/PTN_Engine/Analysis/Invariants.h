@@ -0,0 +1,107 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/Explicit.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ptne
+{
+
+/*!
+ * \brief Configuration of the computation of invariants.
+ */
+struct DLL_PUBLIC InvariantsOptions final
+{
+	//!
+	//! \brief Whether to compute the place invariants.
+	//!
+	bool computePlaceInvariants = true;
+
+	//!
+	//! \brief Whether to compute the transition invariants.
+	//!
+	bool computeTransitionInvariants = true;
+
+	//!
+	//! \brief Maximum number of intermediate candidates kept by the computation of each kind of invariant. The
+	//! computation stops, incomplete, when it is reached.
+	//!
+	size_t maxRows = 1'000'000;
+};
+
+/*!
+ * \brief Invariants of a net.
+ */
+struct DLL_PUBLIC InvariantsResult final
+{
+	//!
+	//! \brief Whether all the minimal invariants were computed.
+	//!
+	bool complete = true;
+
+	//!
+	//! \brief Minimal place invariants, as the weight of each place in their support. The weighted sum of the
+	//! tokens of these places is the same in every reachable marking.
+	//!
+	std::vector<std::map<std::string, size_t>> placeInvariants;
+
+	//!
+	//! \brief Minimal transition invariants, as the number of firings of each transition in their support. Firing
+	//! these transitions this number of times, in any possible order, leads back to the same marking.
+	//!
+	std::vector<std::map<std::string, size_t>> transitionInvariants;
+
+	//!
+	//! \brief Upper bound of the number of tokens of each place covered by a place invariant, derived from the
+	//! place invariants and the marking they were computed from.
+	//!
+	std::map<std::string, size_t> placeBounds;
+};
+
+//!
+//! \brief Compute the minimal place and transition invariants of a net.
+//!
+//! The invariants are the minimal support non negative integer solutions of the incidence matrix equations,
+//! computed with the Farkas algorithm on sparse rows. They only depend on the structure of the net: the arcs from
+//! a place to a transition and back cancel each other, and inhibitor arcs, additional conditions and firing
+//! windows are ignored. The invariants involving places emptied by reset arcs, or the transitions emptying them,
+//! do not hold and are left out. The place bounds assume that no tokens are added to the input places.
+//! \param ptnEngine - The net. The place bounds are computed from its current marking.
+//! \param options - Configuration of the computation.
+//! \return The invariants.
+//!
+DLL_PUBLIC InvariantsResult computeInvariants(const PTN_Engine &ptnEngine, const InvariantsOptions &options = {});
+
+//!
+//! \brief Compute the minimal place and transition invariants of a net.
+//! \param placesProperties - The places of the net. The place bounds are computed from their
+//! initialNumberOfTokens.
+//! \param transitionsProperties - The transitions of the net.
+//! \param options - Configuration of the computation.
+//! \return The invariants.
+//!
+DLL_PUBLIC InvariantsResult computeInvariants(const std::vector<PlaceProperties> &placesProperties,
+											  const std::vector<TransitionProperties> &transitionsProperties,
+											  const InvariantsOptions &options = {});
+
+} // namespace ptne
@@ -0,0 +1,171 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/Explicit.h"
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ptne
+{
+
+/*!
+ * \brief Configuration of a Monte Carlo analysis.
+ */
+struct DLL_PUBLIC MonteCarloOptions final
+{
+	//!
+	//! \brief Number of independent replications of the simulation.
+	//!
+	size_t replications = 1000;
+
+	//!
+	//! \brief Number of threads running the replications. Zero uses one thread per core.
+	//!
+	size_t numberOfThreads = 0;
+
+	//!
+	//! \brief Seed from which the seed of each replication is derived. The results do not depend on the number of
+	//! threads.
+	//!
+	uint64_t seed = 0;
+
+	//!
+	//! \brief Virtual time after which each replication stops. Replications in which no transition is scheduled
+	//! any more keep their final marking until this time.
+	//!
+	SimulationTime duration = SimulationTime::max();
+
+	//!
+	//! \brief Number of firings after which each replication stops.
+	//!
+	size_t maxFirings = 10000;
+
+	//!
+	//! \brief Firing delays by transition name. Transitions not listed use their firing window, as in a
+	//! simulation.
+	//!
+	std::unordered_map<std::string, DelayDistribution> delays;
+
+	//!
+	//! \brief Markings whose reachability is measured, as the number of tokens of the places of interest. The
+	//! places not listed can have any number of tokens.
+	//!
+	std::vector<std::map<std::string, size_t>> targetMarkings;
+};
+
+/*!
+ * \brief Statistics of a place over the replications of a Monte Carlo analysis.
+ */
+struct DLL_PUBLIC PlaceStatistics final
+{
+	//!
+	//! \brief Mean number of tokens. Weighted by virtual time in replications where virtual time elapsed, by
+	//! visited marking otherwise.
+	//!
+	double meanOccupancy = 0;
+
+	//!
+	//! \brief Maximum number of tokens in any replication.
+	//!
+	size_t maxTokens = 0;
+};
+
+/*!
+ * \brief Statistics of a target marking over the replications of a Monte Carlo analysis.
+ */
+struct DLL_PUBLIC TargetMarkingStatistics final
+{
+	//!
+	//! \brief Number of replications in which the target marking was reached.
+	//!
+	size_t replicationsReached = 0;
+
+	//!
+	//! \brief Mean virtual time until the target marking was first reached, in the replications that reached it.
+	//!
+	SimulationTime meanTimeToReach = SimulationTime::zero();
+
+	//!
+	//! \brief Mean number of firings until the target marking was first reached, in the replications that
+	//! reached it.
+	//!
+	double meanFiringsToReach = 0;
+};
+
+/*!
+ * \brief Outcome of a Monte Carlo analysis.
+ */
+struct DLL_PUBLIC MonteCarloResult final
+{
+	//!
+	//! \brief Number of replications run.
+	//!
+	size_t replications = 0;
+
+	//!
+	//! \brief Mean number of firings of each transition per replication, by transition name.
+	//!
+	std::map<std::string, double> meanFiringsPerTransition;
+
+	//!
+	//! \brief Statistics of each place, by place name.
+	//!
+	std::map<std::string, PlaceStatistics> places;
+
+	//!
+	//! \brief Statistics of each target marking, in the order of the options.
+	//!
+	std::vector<TargetMarkingStatistics> targetMarkings;
+
+	//!
+	//! \brief Mean virtual time at which the replications stopped.
+	//!
+	SimulationTime meanEndTime = SimulationTime::zero();
+};
+
+//!
+//! \brief Run independent replications of the token game of a net, in parallel and in virtual time.
+//!
+//! The replications start from the current marking of the net, and follow the rules of PTN_Engine::simulate,
+//! except that additional conditions are considered true and actions are not executed. The net itself is not
+//! changed.
+//! \param ptnEngine - The net.
+//! \param options - Configuration of the analysis.
+//! \return Statistics aggregated over all replications.
+//!
+DLL_PUBLIC MonteCarloResult runMonteCarlo(const PTN_Engine &ptnEngine, const MonteCarloOptions &options = {});
+
+//!
+//! \brief Run independent replications of the token game of a net, in parallel and in virtual time.
+//! \param placesProperties - The places of the net. The replications start from their initialNumberOfTokens.
+//! \param transitionsProperties - The transitions of the net.
+//! \param options - Configuration of the analysis.
+//! \return Statistics aggregated over all replications.
+//!
+DLL_PUBLIC MonteCarloResult runMonteCarlo(const std::vector<PlaceProperties> &placesProperties,
+										  const std::vector<TransitionProperties> &transitionsProperties,
+										  const MonteCarloOptions &options = {});
+
+} // namespace ptne
@@ -0,0 +1,124 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/Explicit.h"
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ptne
+{
+
+/*!
+ * \brief Configuration of a reachability analysis.
+ */
+struct DLL_PUBLIC ReachabilityOptions final
+{
+	//!
+	//! \brief Number of threads exploring the markings. Zero uses one thread per core.
+	//!
+	size_t numberOfThreads = 0;
+
+	//!
+	//! \brief Maximum number of bytes used to store the reachable markings. The exploration stops, incomplete,
+	//! when it is reached.
+	//!
+	size_t memoryLimit = size_t{ 1 } << 30;
+
+	//!
+	//! \brief Number of reachable markings after which the exploration stops, incomplete.
+	//!
+	size_t maxMarkings = std::numeric_limits<size_t>::max();
+
+	//!
+	//! \brief Maximum number of deadlock markings included in the result.
+	//!
+	size_t maxReportedDeadlocks = 10;
+};
+
+/*!
+ * \brief Outcome of a reachability analysis.
+ */
+struct DLL_PUBLIC ReachabilityResult final
+{
+	//!
+	//! \brief Whether all the reachable markings were explored. If not, the other results only refer to the
+	//! explored markings.
+	//!
+	bool complete = false;
+
+	//!
+	//! \brief Number of reachable markings found.
+	//!
+	size_t numberOfMarkings = 0;
+
+	//!
+	//! \brief Number of firings between the explored markings.
+	//!
+	size_t numberOfEdges = 0;
+
+	//!
+	//! \brief Number of reachable markings in which no transition is enabled.
+	//!
+	size_t numberOfDeadlocks = 0;
+
+	//!
+	//! \brief Some of the deadlock markings, as the number of tokens by place name.
+	//!
+	std::vector<std::map<std::string, size_t>> deadlocks;
+
+	//!
+	//! \brief Transitions not enabled in any reachable marking, in order of their names.
+	//!
+	std::vector<std::string> deadTransitions;
+
+	//!
+	//! \brief Maximum number of tokens of each place in the reachable markings, by place name.
+	//!
+	std::map<std::string, size_t> placeBounds;
+};
+
+//!
+//! \brief Explore the markings reachable from the current marking of a net, in parallel.
+//!
+//! The exploration considers all the possible firing orders of the token game: additional conditions are
+//! considered true, firing windows are not considered and no tokens are added to the input places. The net
+//! itself is not changed.
+//! \param ptnEngine - The net.
+//! \param options - Configuration of the analysis.
+//! \return The properties of the reachable markings.
+//!
+DLL_PUBLIC ReachabilityResult exploreReachability(const PTN_Engine &ptnEngine,
+												  const ReachabilityOptions &options = {});
+
+//!
+//! \brief Explore the markings reachable from the initial marking of a net, in parallel.
+//! \param placesProperties - The places of the net. The exploration starts from their initialNumberOfTokens.
+//! \param transitionsProperties - The transitions of the net.
+//! \param options - Configuration of the analysis.
+//! \return The properties of the reachable markings.
+//!
+DLL_PUBLIC ReachabilityResult exploreReachability(const std::vector<PlaceProperties> &placesProperties,
+												  const std::vector<TransitionProperties> &transitionsProperties,
+												  const ReachabilityOptions &options = {});
+
+} // namespace ptne
@@ -0,0 +1,145 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/Explicit.h"
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ptne
+{
+
+/*!
+ * \brief Configuration of a verification.
+ */
+struct DLL_PUBLIC VerificationOptions final
+{
+	//!
+	//! \brief Whether to check if a deadlock is reachable.
+	//!
+	bool checkDeadlocks = true;
+
+	//!
+	//! \brief Markings whose reachability is checked, as the number of tokens of the places of interest. The
+	//! places not listed can have any number of tokens.
+	//!
+	std::vector<std::map<std::string, size_t>> targetMarkings;
+
+	//!
+	//! \brief Whether to explore only a reduced set of firing orders that preserves the checked properties,
+	//! instead of all of them.
+	//!
+	bool partialOrderReduction = true;
+
+	//!
+	//! \brief Maximum number of bytes used to store the markings of each check. The check stops, incomplete,
+	//! when it is reached.
+	//!
+	size_t memoryLimit = size_t{ 1 } << 30;
+
+	//!
+	//! \brief Number of markings after which each check stops, incomplete.
+	//!
+	size_t maxMarkings = std::numeric_limits<size_t>::max();
+};
+
+/*!
+ * \brief Outcome of checking the reachability of a target marking.
+ */
+struct DLL_PUBLIC TargetMarkingVerdict final
+{
+	//!
+	//! \brief Whether the target marking is reachable.
+	//!
+	bool reachable = false;
+
+	//!
+	//! \brief Whether the verdict is definitive: the target was reached, or all the relevant markings were
+	//! explored without reaching it.
+	//!
+	bool complete = false;
+
+	//!
+	//! \brief A sequence of transition names whose firing reaches the target marking, if it is reachable.
+	//!
+	std::vector<std::string> firingSequence;
+};
+
+/*!
+ * \brief Outcome of a verification.
+ */
+struct DLL_PUBLIC VerificationResult final
+{
+	//!
+	//! \brief Whether a deadlock is reachable.
+	//!
+	bool deadlockReachable = false;
+
+	//!
+	//! \brief Whether the verdict of the deadlock check is definitive: a deadlock was found, or all the relevant
+	//! markings were explored without finding one.
+	//!
+	bool deadlockCheckComplete = false;
+
+	//!
+	//! \brief A sequence of transition names whose firing leads to a deadlock, if one is reachable.
+	//!
+	std::vector<std::string> deadlockFiringSequence;
+
+	//!
+	//! \brief Outcome for each target marking, in the order of the options.
+	//!
+	std::vector<TargetMarkingVerdict> targetMarkings;
+
+	//!
+	//! \brief Total number of markings explored by all the checks.
+	//!
+	size_t numberOfMarkings = 0;
+};
+
+//!
+//! \brief Check the deadlock freedom and the reachability of target markings of a net, from its current marking.
+//!
+//! Each check searches the reachable markings breadth first, so the firing sequences found are the shortest in
+//! the explored markings. With partial order reduction, only the transitions of a stubborn set are fired in each
+//! marking, which avoids exploring the interleavings of independent transitions.
+//! As in the other analyses, only the token game is checked: additional conditions are considered true, firing
+//! windows are ignored and no tokens are added to the input places. The firing sequences can be replayed with
+//! PTN_Engine::fireTransition. The net itself is not changed.
+//! \param ptnEngine - The net.
+//! \param options - Configuration of the verification.
+//! \return The outcome of the checks.
+//!
+DLL_PUBLIC VerificationResult verify(const PTN_Engine &ptnEngine, const VerificationOptions &options = {});
+
+//!
+//! \brief Check the deadlock freedom and the reachability of target markings of a net, from its initial marking.
+//! \param placesProperties - The places of the net. The checks start from their initialNumberOfTokens.
+//! \param transitionsProperties - The transitions of the net.
+//! \param options - Configuration of the verification.
+//! \return The outcome of the checks.
+//!
+DLL_PUBLIC VerificationResult verify(const std::vector<PlaceProperties> &placesProperties,
+									 const std::vector<TransitionProperties> &transitionsProperties,
+									 const VerificationOptions &options = {});
+
+} // namespace ptne
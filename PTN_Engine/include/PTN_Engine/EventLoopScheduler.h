@@ -0,0 +1,72 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Utilities/Explicit.h"
+#include <cstddef>
+#include <memory>
+
+namespace ptne
+{
+
+class EventLoop;
+
+//!
+//! \brief Fixed pool of threads shared by the event loops of many PTN_Engine objects.
+//!
+//! An engine attached to a scheduler does not own an event loop thread. Whenever the engine has
+//! pending input, or its event loop sleep duration expires, one of the pool threads runs one
+//! execution cycle of the net. Idle engines do not hold any thread. The execution cycles of the
+//! same engine are never run concurrently, so the ordering guarantees of each engine are the same
+//! as with a dedicated event loop thread.
+//!
+//! \sa PTN_Engine::setEventLoopScheduler
+//!
+class DLL_PUBLIC EventLoopScheduler final
+{
+public:
+	~EventLoopScheduler();
+
+	//!
+	//! \brief Constructor.
+	//! \param numberOfThreads - Number of threads in the pool. Must be at least 1.
+	//!
+	explicit EventLoopScheduler(const size_t numberOfThreads);
+
+	EventLoopScheduler(const EventLoopScheduler &) = delete;
+	EventLoopScheduler(EventLoopScheduler &&) = delete;
+	EventLoopScheduler &operator=(const EventLoopScheduler &) = delete;
+	EventLoopScheduler &operator=(EventLoopScheduler &&) = delete;
+
+	//!
+	//! \brief Get the number of threads in the pool.
+	//! \return The number of threads in the pool.
+	//!
+	size_t getNumberOfThreads() const;
+
+private:
+	friend class EventLoop;
+
+	class EventLoopSchedulerImp;
+
+	//! Pointer to the implementation of the scheduler.
+	std::unique_ptr<EventLoopSchedulerImp> m_imp;
+};
+
+} // namespace ptne
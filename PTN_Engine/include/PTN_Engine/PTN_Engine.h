@@ -20,17 +20,95 @@
 
 #include "PTN_Engine/Utilities/Explicit.h"
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace ptne
 {
+class EventLoopScheduler;
+
 using ConditionFunction = std::function<bool(void)>;
 using ActionFunction = std::function<void(void)>;
 
+using ContextConditionFunction = bool (*)(void *userData);
+
+/*!
+ * \brief Condition made of a function pointer and a user pointer. Unlike a ConditionFunction, it is called without
+ * type erasure and copied without allocation, for transitions evaluating many cheap conditions.
+ */
+struct DLL_PUBLIC ContextCondition final
+{
+	//!
+	//! \brief The function to be called.
+	//!
+	ContextConditionFunction function = nullptr;
+
+	//!
+	//! \brief Pointer passed to the function.
+	//!
+	void *userData = nullptr;
+};
+
+/*!
+ * \brief What a context action is told about the change of the number of tokens of its place.
+ */
+struct DLL_PUBLIC ActionContext final
+{
+	//!
+	//! \brief Identifies the place while it is part of the net, so that per place data can be looked up without
+	//! hashing the name.
+	//!
+	const void *placeHandle = nullptr;
+
+	//!
+	//! \brief Name of the place. Refers to the name held by the place, which is kept alive until the action has run.
+	//!
+	std::string_view placeName;
+
+	//!
+	//! \brief Number of tokens that entered the place, negative if they left it.
+	//!
+	std::ptrdiff_t tokenDelta = 0;
+
+	//!
+	//! \brief Number of tokens of the place after the change.
+	//!
+	size_t numberOfTokens = 0;
+
+	//!
+	//! \brief The user data of the action.
+	//!
+	void *userData = nullptr;
+};
+
+using ContextActionFunction = void (*)(const ActionContext &);
+
+/*!
+ * \brief Action receiving the context of the call. Being a function pointer and a user pointer, the same action
+ * can serve many places without being allocated for each of them.
+ */
+struct DLL_PUBLIC ContextAction final
+{
+	//!
+	//! \brief The function to be called.
+	//!
+	ContextActionFunction function = nullptr;
+
+	//!
+	//! \brief Pointer passed to the function in ActionContext::userData.
+	//!
+	void *userData = nullptr;
+};
+
 /*!
  * \brief The PlaceProperties class
  */
@@ -42,7 +120,8 @@ struct DLL_PUBLIC ArcProperties final
 		DESTINATION,
 		BIDIRECTIONAL,
 		INHIBITOR,
-		// RESET,
+		RESET,
+		READ,
 	};
 
 	/*!
@@ -105,6 +184,43 @@ struct DLL_PUBLIC TransitionProperties final
 	//! \brief requireNoActionsInExecution
 	//!
 	bool requireNoActionsInExecution = false;
+
+	//!
+	//! \brief Time the transition must remain enabled before it can fire.
+	//!
+	std::chrono::milliseconds minimumDelay = std::chrono::milliseconds::zero();
+
+	//!
+	//! \brief Time after being enabled, after which the transition can no longer fire until it is disabled and
+	//! enabled again. Zero means no deadline. Setting it equal to minimumDelay gives a deterministic delay.
+	//!
+	std::chrono::milliseconds maximumDelay = std::chrono::milliseconds::zero();
+
+	//!
+	//! \brief Places emptied when the transition fires, after the tokens of the activation places are consumed
+	//! and before the destination places receive theirs. They do not influence whether the transition is enabled.
+	//!
+	std::vector<ArcProperties> resetArcs;
+
+	//!
+	//! \brief Places that must have at least the weight of the arc in tokens for the transition to be enabled. Unlike
+	//! bidirectional arcs, their tokens are neither taken nor given back, so no actions are called and transitions
+	//! reading the same place do not conflict.
+	//!
+	std::vector<ArcProperties> readArcs;
+
+	//!
+	//! \brief Whether the transition fires as many times as it is enabled at once, moving all the tokens in a single
+	//! update of the marking. The additional conditions are evaluated once for the whole batch and the actions of
+	//! its places are called once per firing. Meant for transitions whose firings need not be interleaved with
+	//! other firings. Transitions without activation arcs, with reset arcs or with a firing window fire once.
+	//!
+	bool batchFiring = false;
+
+	//!
+	//! \brief Conditions made of a function pointer and a user pointer, evaluated with additionalConditions.
+	//!
+	std::vector<ContextCondition> additionalContextConditions;
 };
 
 /*!
@@ -146,6 +262,261 @@ struct DLL_PUBLIC PlaceProperties final
 	//! \brief A flag determining if this place can have tokens added manually.
 	//!
 	bool input = false;
+
+	//!
+	//! \brief Maximum number of tokens the place can hold. Zero means unbounded. Transitions that would exceed it
+	//! are not enabled, and incrementInputPlace applies a FULL_PLACE_POLICY.
+	//!
+	size_t capacity = 0;
+
+	//!
+	//! \brief Action called with its context once a token enters the place. Exclusive with onEnterAction.
+	//!
+	ContextAction onEnterContextAction;
+
+	//!
+	//! \brief Action called with its context once a token leaves the place. Exclusive with onExitAction.
+	//!
+	ContextAction onExitContextAction;
+};
+
+/*!
+ * \brief Outcome of running the net for a bounded amount of work.
+ */
+struct DLL_PUBLIC StepResult final
+{
+	//!
+	//! \brief The number of transitions fired. A batch firing counts each of its firings.
+	//!
+	size_t firedTransitions = 0;
+
+	//!
+	//! \brief Whether there were still enabled transitions when returning.
+	//!
+	bool workRemaining = false;
+};
+
+/*!
+ * \brief Outcome of the structural reduction of a net.
+ */
+struct DLL_PUBLIC NetReductionResult final
+{
+	//!
+	//! \brief The names of the places removed from the net.
+	//!
+	std::vector<std::string> removedPlaces;
+
+	//!
+	//! \brief The names of the transitions removed from the net.
+	//!
+	std::vector<std::string> removedTransitions;
+};
+
+//!
+//! \brief Virtual time of a simulation, in milliseconds.
+//!
+using SimulationTime = std::chrono::duration<double, std::milli>;
+
+/*!
+ * \brief Probability distribution of the firing delay of a transition in a simulation.
+ */
+struct DLL_PUBLIC DelayDistribution final
+{
+	enum class Type
+	{
+		DETERMINISTIC,
+		UNIFORM,
+		EXPONENTIAL
+	};
+
+	//!
+	//! \brief Type of the distribution.
+	//!
+	Type type = Type::DETERMINISTIC;
+
+	//!
+	//! \brief The delay of a DETERMINISTIC distribution, or the lower bound of an UNIFORM distribution.
+	//!
+	SimulationTime minimum = SimulationTime::zero();
+
+	//!
+	//! \brief The upper bound of an UNIFORM distribution.
+	//!
+	SimulationTime maximum = SimulationTime::zero();
+
+	//!
+	//! \brief The mean delay of an EXPONENTIAL distribution.
+	//!
+	SimulationTime mean = SimulationTime::zero();
+};
+
+/*!
+ * \brief Configuration of a simulation.
+ */
+struct DLL_PUBLIC SimulationOptions final
+{
+	//!
+	//! \brief Virtual time after which the simulation stops.
+	//!
+	SimulationTime duration = SimulationTime::max();
+
+	//!
+	//! \brief Number of firings after which the simulation stops.
+	//!
+	size_t maxFirings = std::numeric_limits<size_t>::max();
+
+	//!
+	//! \brief Seed of the random number generator, for reproducible simulations.
+	//!
+	uint64_t seed = 0;
+
+	//!
+	//! \brief Whether the on enter and on exit actions of the places are executed, or suppressed.
+	//!
+	bool executeActions = false;
+
+	//!
+	//! \brief Firing delays by transition name. Transitions not listed use their firing window: a deterministic
+	//! minimumDelay if they have no deadline, a uniform distribution between minimumDelay and maximumDelay
+	//! otherwise.
+	//!
+	std::unordered_map<std::string, DelayDistribution> delays;
+};
+
+/*!
+ * \brief Outcome of a simulation.
+ */
+struct DLL_PUBLIC SimulationResult final
+{
+	//!
+	//! \brief The total number of fired transitions.
+	//!
+	size_t firedTransitions = 0;
+
+	//!
+	//! \brief The number of firings of each transition, by transition name.
+	//!
+	std::map<std::string, size_t> firingsPerTransition;
+
+	//!
+	//! \brief The virtual time at which the simulation stopped.
+	//!
+	SimulationTime endTime = SimulationTime::zero();
+
+	//!
+	//! \brief Whether there were still firings scheduled when the simulation stopped.
+	//!
+	bool workRemaining = false;
+};
+
+/*!
+ * \brief Configuration of the journal recording the changes of the marking.
+ */
+struct DLL_PUBLIC JournalOptions final
+{
+	enum class FsyncPolicy
+	{
+		//! Each group commit is synchronized to the storage device.
+		ON_COMMIT,
+		//! Only the checkpoints are synchronized to the storage device. The records in between survive a crash of
+		//! the process, but not of the system.
+		ON_CHECKPOINT
+	};
+
+	//!
+	//! \brief Path of the journal file.
+	//!
+	std::string path;
+
+	//!
+	//! \brief When the journal file is synchronized to the storage device.
+	//!
+	FsyncPolicy fsyncPolicy = FsyncPolicy::ON_COMMIT;
+
+	//!
+	//! \brief Maximum time the records are kept in memory before being written together to the file.
+	//!
+	std::chrono::milliseconds commitInterval = std::chrono::milliseconds(10);
+
+	//!
+	//! \brief Number of records after which the marking is written and the file is truncated.
+	//!
+	size_t checkpointInterval = 100'000;
+};
+
+/*!
+ * \brief Event of a recorded execution.
+ */
+struct DLL_PUBLIC RecordedEvent final
+{
+	enum class Type
+	{
+		INPUT,
+		FIRING
+	};
+
+	//!
+	//! \brief Whether a token was added to an input place or a transition was fired.
+	//!
+	Type type = Type::FIRING;
+
+	//!
+	//! \brief The name of the input place or of the fired transition.
+	//!
+	std::string name;
+};
+
+/*!
+ * \brief Execution of a net recorded to be replayed.
+ */
+struct DLL_PUBLIC ExecutionRecording final
+{
+	//!
+	//! \brief Snapshot of the marking when the recording started, as taken by snapshotMarking.
+	//!
+	std::vector<uint8_t> initialMarking;
+
+	//!
+	//! \brief The input tokens and the fired transitions, in order.
+	//!
+	std::vector<RecordedEvent> events;
+};
+
+/*!
+ * \brief Changes to the structure of a net, applied together by PTN_Engine::updateStructure.
+ */
+struct DLL_PUBLIC StructureUpdate final
+{
+	//!
+	//! \brief Places to be created.
+	//!
+	std::vector<PlaceProperties> places;
+
+	//!
+	//! \brief Transitions to be created. Their arcs may link to the places created by the same update. A removed
+	//! transition may be created again with other properties.
+	//!
+	std::vector<TransitionProperties> transitions;
+
+	//!
+	//! \brief Names of the places to be removed, with their tokens. No remaining transition may link to them.
+	//!
+	std::vector<std::string> removedPlaces;
+
+	//!
+	//! \brief Names of the transitions to be removed.
+	//!
+	std::vector<std::string> removedTransitions;
+
+	//!
+	//! \brief Arcs to be removed, before the arcs are added.
+	//!
+	std::vector<ArcProperties> removedArcs;
+
+	//!
+	//! \brief Arcs to be added, to existing transitions or to the transitions created by the same update.
+	//!
+	std::vector<ArcProperties> addedArcs;
 };
 
 //! Base class that implements the Petri net logic.
@@ -162,7 +533,32 @@ public:
 		SINGLE_THREAD,
 		EVENT_LOOP,
 		DETACHED,
-		JOB_QUEUE
+		JOB_QUEUE,
+		EXTERNAL_LOOP
+	};
+
+	//!
+	//! \brief What incrementInputPlace does with a token for a place that is at its capacity.
+	//!
+	enum class FULL_PLACE_POLICY
+	{
+		//! Throw PlaceCapacityException.
+		THROW,
+		//! Discard the token.
+		DROP,
+		//! Wait until a firing makes room in the place, or until the timeout expires.
+		BLOCK
+	};
+
+	//!
+	//! \brief How the enabled transitions are fired.
+	//!
+	enum class FIRING_SEMANTICS
+	{
+		//! Each firing is a step on its own, the enabled transitions are fired one at a time in random order.
+		INTERLEAVING,
+		//! Each step fires a maximal set of enabled transitions that do not conflict with each other, as a whole.
+		MAXIMAL_STEP
 	};
 
 	using EventLoopSleepDuration = std::chrono::duration<long, std::ratio<1, 1000>>;
@@ -193,6 +589,13 @@ public:
 	 */
 	void registerAction(const std::string &name, const ActionFunction &action) const;
 
+	/*!
+	 * Register an action receiving the context of the call, to be used by any number of places.
+	 * \param name The name of the action.
+	 * \param action The function to be called, with its user data.
+	 */
+	void registerAction(const std::string &name, const ContextAction &action) const;
+
 	/*!
 	 * Register a condition
 	 * \param name The name of the condition
@@ -200,6 +603,13 @@ public:
 	 */
 	void registerCondition(const std::string &name, const ConditionFunction &condition) const;
 
+	/*!
+	 * Register a condition made of a function pointer and a user pointer.
+	 * \param name The name of the condition
+	 * \param condition The function to be called, with its user data.
+	 */
+	void registerCondition(const std::string &name, const ContextCondition &condition) const;
+
 	/*!
 	 * Start the petri net event loop.
 	 * \param returnWhenStopped run the net only until no transition is fireable.
@@ -208,6 +618,145 @@ public:
 	 */
 	void execute(const bool log = false, std::ostream &o = std::cout);
 
+	/*!
+	 * \brief Run the net in the calling thread until no transition is enabled or a number of transitions were
+	 * fired. Cannot be called while the event loop is running.
+	 * \param maxFirings - Maximum number of transitions to be fired, counting each firing of a batch.
+	 * \return The number of fired transitions and whether there is remaining work.
+	 */
+	StepResult step(const size_t maxFirings = 1);
+
+	/*!
+	 * \brief Run the net in the calling thread until no transition is enabled or a time budget is spent. The
+	 * budget is checked after each firing, so the actions of the last fired transition may exceed it. Cannot be
+	 * called while the event loop is running.
+	 * \param duration - Time budget.
+	 * \return The number of fired transitions and whether there is remaining work.
+	 */
+	StepResult runFor(const std::chrono::nanoseconds duration);
+
+	/*!
+	 * \brief Fire a given transition in the calling thread, if it is enabled and its additional conditions hold.
+	 * The firing window of the transition is not checked. Allows replaying a firing sequence, e.g. one found by an
+	 * analysis. Batch firing transitions fire once. Cannot be called while the event loop is running.
+	 * \param transition - The name of the transition.
+	 * \return True if the transition was fired.
+	 */
+	bool fireTransition(const std::string &transition);
+
+	/*!
+	 * \brief Simplify the structure of the net, so that it fires fewer transitions for the same behavior.
+	 * Chains of a place and a transition without observable effects are fused into the transition producing the
+	 * tokens, places that never restrict a firing are removed, and transitions that only give back the tokens
+	 * they take are removed. Places with actions or a capacity, input places and transitions with additional
+	 * conditions, inhibitor arcs or firing windows are kept as they are. Removed places and transitions can no
+	 * longer be accessed by their names. Meant to be called once the net is built, before execute. Cannot be
+	 * called while the event loop is running.
+	 * \return The names of the removed places and transitions.
+	 */
+	NetReductionResult reduceNet();
+
+	/*!
+	 * \brief Take a snapshot of the number of tokens in every place, in a compact binary format. The snapshot is
+	 * consistent even while the event loop is running: it is taken between two firings. It cannot be taken from
+	 * an action executed by the event loop.
+	 * \return The snapshot, to be given to restoreMarking.
+	 */
+	std::vector<uint8_t> snapshotMarking() const;
+
+	/*!
+	 * \brief Set the number of tokens in every place to the values of a snapshot taken with snapshotMarking, from
+	 * this net or from a net with the same places, transitions and arcs. No actions are executed. May be called
+	 * while the event loop is running, the marking is restored between two firings. Throws
+	 * InvalidSnapshotException, leaving the marking unchanged, if the snapshot is malformed or was taken from a
+	 * net with another structure.
+	 * \param snapshot - The snapshot.
+	 */
+	void restoreMarking(const std::vector<uint8_t> &snapshot);
+
+	/*!
+	 * \brief Set the number of tokens in every place back to the number it was created with, to run the same net
+	 * again without building it anew. No actions are executed. May be called while the event loop is running,
+	 * the marking is reset between two firings.
+	 */
+	void resetMarking();
+
+	/*!
+	 * \brief Get a 64 bit hash of the marking, maintained incrementally as tokens enter and leave the places, so
+	 * getting it does not depend on the size of the net. Each place with tokens contributes a value derived from
+	 * its name and number of tokens, so nets with the same places and marking have the same hash. Useful to check
+	 * that replicas are consistent, to detect cycles in the reached markings and as a key to cache per marking
+	 * results. Different markings may, with very low probability, have the same hash. Does not wait for the
+	 * transition being fired, so it may be called while the event loop is running and from actions and conditions.
+	 * The hash is only consistent between firings, during a firing it may reflect part of the firing.
+	 * \return The hash of the marking.
+	 */
+	uint64_t getMarkingHash() const;
+
+	/*!
+	 * \brief Start recording the input tokens and the fired transitions in a journal file, so that the marking can
+	 * be recovered after a crash. If the file exists, the marking it records is restored first, without executing
+	 * any action. The records are written in batches by a background thread. A checkpoint with the whole marking
+	 * replaces the file every JournalOptions::checkpointInterval records. The structure of the net cannot be
+	 * changed while the journal is open. Cannot be called while the event loop is running. Throws
+	 * JournalException if the file cannot be written or belongs to a net with another structure.
+	 * \param options - Path, fsync policy and intervals of the journal.
+	 * \return The number of records replayed after the last checkpoint of an existing file.
+	 */
+	size_t openJournal(const JournalOptions &options);
+
+	/*!
+	 * \brief Write the pending records and stop recording. Cannot be called while the event loop is running.
+	 * Throws JournalException if a write failed.
+	 */
+	void closeJournal();
+
+	/*!
+	 * \brief Wait until the records made so far are written, and synchronized if the fsync policy is ON_COMMIT.
+	 * Throws JournalException if a write failed.
+	 */
+	void syncJournal() const;
+
+	/*!
+	 * \brief Start recording the input tokens and the fired transitions, to replay the execution later. The
+	 * order in which conflicts were resolved and the outcome of the additional conditions are captured by the
+	 * fired transitions. May be called while the event loop is running. The structure of the net cannot be
+	 * changed while recording.
+	 */
+	void startRecording();
+
+	/*!
+	 * \brief Stop recording. May be called while the event loop is running.
+	 * \return The marking when the recording started and the recorded events.
+	 */
+	ExecutionRecording stopRecording();
+
+	/*!
+	 * \brief Re-execute a recorded execution in the calling thread, from its initial marking. Each recorded
+	 * firing is verified to be enabled by the tokens and inhibitor arcs, while the additional conditions and the
+	 * firing windows are taken as recorded. Throws ReplayDivergenceException at the first firing that is not
+	 * enabled, leaving the marking reached so far. Cannot be called while the event loop is running.
+	 * \param recording - The recorded execution, from a net with the same structure.
+	 * \param executeActions - Whether the on enter and on exit actions of the places are executed, or suppressed.
+	 */
+	void replay(const ExecutionRecording &recording, const bool executeActions = false);
+
+	/*!
+	 * \brief Seed the generator that orders the enabled transitions, so that executions in a single thread can
+	 * be repeated.
+	 * \param seed - The seed.
+	 */
+	void setRandomSeed(const uint64_t seed);
+
+	/*!
+	 * \brief Simulate the net in the calling thread, in virtual time. Each enabled transition fires after a delay
+	 * sampled from its distribution, and the virtual clock jumps directly to the next firing. The simulation
+	 * starts from and changes the current marking. Cannot be called while the event loop is running.
+	 * \param options - Duration, delay distributions and other settings of the simulation.
+	 * \return Statistics of the simulation.
+	 */
+	SimulationResult simulate(const SimulationOptions &options = {});
+
 	/*!
 	 * Return the number of tokens in a given place.
 	 * \param place The name of the place to get the number of tokens from.
@@ -216,11 +765,31 @@ public:
 	size_t getNumberOfTokens(const std::string &place) const;
 
 	/*!
-	 * Add a token to an input place.
+	 * Add a token to an input place. Throws PlaceCapacityException if the place is at its capacity.
 	 * \param place Name of the place to be incremented.
 	 */
 	void incrementInputPlace(const std::string &place);
 
+	/*!
+	 * \brief Add a token to an input place, applying a policy if the place is at its capacity. This is how the
+	 * net exerts backpressure on the producers of its inputs. Blocking waits for the firings, so it cannot be
+	 * done by the actions and conditions called while firing a transition.
+	 * \param place - Name of the place to be incremented.
+	 * \param policy - What to do if the place is full.
+	 * \param timeout - Maximum time to wait for room with the BLOCK policy.
+	 * \return Whether the token was added.
+	 */
+	bool incrementInputPlace(const std::string &place,
+							 const FULL_PLACE_POLICY policy,
+							 const std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+	/*!
+	 * \brief Add a token to an input place if it has room for it, without blocking.
+	 * \param place - Name of the place to be incremented.
+	 * \return Whether the token was added.
+	 */
+	bool tryIncrementInputPlace(const std::string &place);
+
 	/*!
 	 * Print the petri net places and number of tokens.
 	 * \param o Output stream.
@@ -236,6 +805,18 @@ public:
 	//! Get the information on which thread the actions are run.
 	ACTIONS_THREAD_OPTION getActionsThreadOption() const;
 
+	/*!
+	 * \brief Set how the enabled transitions are fired. Throws PTN_Exception if the event loop is running.
+	 * \param firingSemantics - The firing semantics. INTERLEAVING by default.
+	 */
+	void setFiringSemantics(const FIRING_SEMANTICS firingSemantics);
+
+	/*!
+	 * \brief getFiringSemantics
+	 * \return How the enabled transitions are fired.
+	 */
+	FIRING_SEMANTICS getFiringSemantics() const;
+
 	/*!
 	 * \brief Whether the Petri Net's event loop is running or not.
 	 * \return True if the event loop is running, false otherwise.
@@ -260,17 +841,58 @@ public:
 	EventLoopSleepDuration getEventLoopSleepDuration() const;
 
 	/*!
-	 * \brief addArc
+	 * \brief Run the event loop in the threads of a scheduler shared with other engines, instead of in a
+	 * dedicated thread. Has no effect in SINGLE_THREAD mode.
+	 * \param scheduler - The scheduler to be used. nullptr sets back a dedicated thread.
+	 */
+	void setEventLoopScheduler(const std::shared_ptr<EventLoopScheduler> &scheduler);
+
+	/*!
+	 * \brief getEventLoopScheduler
+	 * \return The scheduler running the event loop, or nullptr if it runs in a dedicated thread.
+	 */
+	std::shared_ptr<EventLoopScheduler> getEventLoopScheduler() const;
+
+	/*!
+	 * \brief Get the Linux event file descriptor (eventfd) to be registered in an external event loop (e.g. epoll).
+	 * The descriptor becomes readable when the net has pending work, which is then processed by calling poll.
+	 * Only available in the EXTERNAL_LOOP mode.
+	 * \return The event file descriptor. It is owned by the PTN_Engine and must not be closed.
+	 */
+	int getEventFileDescriptor() const;
+
+	/*!
+	 * \brief Process the pending work of the net in the calling thread, without blocking. Only available in the
+	 * EXTERNAL_LOOP mode, after calling execute. If work is still pending when returning, the event file
+	 * descriptor is left readable.
+	 * \param maxSteps - Maximum number of transitions to be fired.
+	 * \return The number of fired transitions.
+	 */
+	size_t poll(const size_t maxSteps = std::numeric_limits<size_t>::max());
+
+	/*!
+	 * \brief Add an arc. May be called while the event loop is running, like updateStructure.
 	 * \param arcProperties
 	 */
 	void addArc(const ArcProperties &arcProperties);
 
 	/*!
-	 * \brief addArc
+	 * \brief Remove an arc. May be called while the event loop is running, like updateStructure.
 	 * \param arcProperties
 	 */
 	void removeArc(const ArcProperties &arcProperties);
 
+	/*!
+	 * \brief Apply several changes to the structure of the net as a single transaction, also while the event loop
+	 * is running. The new places, transitions and arcs are built and validated aside, without blocking the
+	 * firings, and then published together between two firings, so that no firing sees a part of the update. The
+	 * places and transitions that are not removed keep their tokens and state. If any change is invalid an
+	 * exception is thrown and the net is left unchanged. Cannot be called by an action or a condition while a
+	 * transition is being fired, nor while the journal is open or the execution is recorded.
+	 * \param update - Places and transitions to create and remove and arcs to remove and add.
+	 */
+	void updateStructure(const StructureUpdate &update);
+
 	/*!
 	 * \brief clearNet
 	 */
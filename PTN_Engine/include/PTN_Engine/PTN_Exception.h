@@ -77,6 +77,18 @@ public:
 	}
 };
 
+/*!
+ * Exception to be thrown when a place would hold more tokens than its capacity.
+ */
+class DLL_PUBLIC PlaceCapacityException : public PTN_Exception
+{
+public:
+	explicit PlaceCapacityException(const std::string &name)
+	: PTN_Exception("The place " + name + " cannot hold more tokens than its capacity.")
+	{
+	}
+};
+
 /*!
  * Exception to be thrown if the user tries to add a Place to the net that with the name of an already
  * existing one.
@@ -191,5 +203,77 @@ public:
 	}
 };
 
+/*!
+ * Exception to be thrown when reset places in the constructor are repeated.
+ */
+class DLL_PUBLIC ResetPlaceRepetitionException : public PTN_Exception
+{
+public:
+	ResetPlaceRepetitionException()
+	: PTN_Exception("Repetition of reset places is not permitted.")
+	{
+	}
+};
+
+/*!
+ * Exception to be thrown when read places in the constructor are repeated.
+ */
+class DLL_PUBLIC ReadPlaceRepetitionException : public PTN_Exception
+{
+public:
+	ReadPlaceRepetitionException()
+	: PTN_Exception("Repetition of read places is not permitted.")
+	{
+	}
+};
+
+/*!
+ * Exception to be thrown when the deadline of a transition is before its minimum delay.
+ */
+class DLL_PUBLIC InvalidFiringWindowException : public PTN_Exception
+{
+public:
+	explicit InvalidFiringWindowException(const std::string &name)
+	: PTN_Exception("The maximum delay of transition " + name + " is shorter than its minimum delay.")
+	{
+	}
+};
+
+/*!
+ * Exception to be thrown when a marking snapshot cannot be restored.
+ */
+class DLL_PUBLIC InvalidSnapshotException : public PTN_Exception
+{
+public:
+	explicit InvalidSnapshotException(const std::string &reason)
+	: PTN_Exception("Cannot restore the marking snapshot: " + reason + ".")
+	{
+	}
+};
+
+/*!
+ * Exception to be thrown when the journal cannot be read or written.
+ */
+class DLL_PUBLIC JournalException : public PTN_Exception
+{
+public:
+	JournalException(const std::string &path, const std::string &reason)
+	: PTN_Exception("Journal " + path + ": " + reason + ".")
+	{
+	}
+};
+
+/*!
+ * Exception to be thrown when a recorded firing is not enabled during a replay.
+ */
+class DLL_PUBLIC ReplayDivergenceException : public PTN_Exception
+{
+public:
+	ReplayDivergenceException(const size_t event, const std::string &transition)
+	: PTN_Exception("The replay diverges at event " + std::to_string(event) + ": transition " + transition +
+					" is not enabled.")
+	{
+	}
+};
 
 } // namespace ptne
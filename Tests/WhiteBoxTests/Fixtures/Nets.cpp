@@ -0,0 +1,73 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+
+using namespace std;
+using namespace ptne;
+
+void createMutualExclusion(PTN_Engine &ptnEngine)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Mutex", .initialNumberOfTokens = 1 });
+	for (const string process : { "1", "2" })
+	{
+		ptnEngine.createPlace(PlaceProperties{ .name = "Idle" + process, .initialNumberOfTokens = 1 });
+		ptnEngine.createPlace(PlaceProperties{ .name = "Critical" + process });
+		ptnEngine.createTransition(
+		TransitionProperties{ .name = "Enter" + process,
+							  .activationArcs = { ArcProperties{ .placeName = "Idle" + process },
+												  ArcProperties{ .placeName = "Mutex" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "Critical" + process } } });
+		ptnEngine.createTransition(
+		TransitionProperties{ .name = "Leave" + process,
+							  .activationArcs = { ArcProperties{ .placeName = "Critical" + process } },
+							  .destinationArcs = { ArcProperties{ .placeName = "Idle" + process },
+												   ArcProperties{ .placeName = "Mutex" } } });
+	}
+}
+
+void createRing(vector<PlaceProperties> &places,
+				vector<TransitionProperties> &transitions,
+				const size_t size,
+				const size_t tokens)
+{
+	for (size_t i = 1; i <= size; ++i)
+	{
+		const string place = "P" + to_string(i);
+		places.push_back(PlaceProperties{ .name = place, .initialNumberOfTokens = i == 1 ? tokens : 0 });
+		transitions.push_back(
+		TransitionProperties{ .name = "T" + to_string(i),
+							  .activationArcs = { ArcProperties{ .placeName = place } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P" + to_string(i % size + 1) } } });
+	}
+}
+
+void createRing(PTN_Engine &ptnEngine, const size_t size, const size_t tokens)
+{
+	vector<PlaceProperties> places;
+	vector<TransitionProperties> transitions;
+	createRing(places, transitions, size, tokens);
+	for (const PlaceProperties &place : places)
+	{
+		ptnEngine.createPlace(place);
+	}
+	for (const TransitionProperties &transition : transitions)
+	{
+		ptnEngine.createTransition(transition);
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <vector>
+
+//!
+//! \brief Two processes, each moving from place Idle<i> to place Critical<i> through transition Enter<i> and back
+//! through Leave<i>, with the place Mutex keeping them from being critical at the same time.
+//! \param ptnEngine - The net in which the places and transitions are created.
+//!
+void createMutualExclusion(ptne::PTN_Engine &ptnEngine);
+
+//!
+//! \brief Ring of places P1 to P<size>, in which transition T<i> passes the tokens of place P<i> to the next place.
+//! \param places - Receives the properties of the places.
+//! \param transitions - Receives the properties of the transitions.
+//! \param size - Number of places, and of transitions.
+//! \param tokens - Initial number of tokens of P1, the other places are empty.
+//!
+void createRing(std::vector<ptne::PlaceProperties> &places,
+				std::vector<ptne::TransitionProperties> &transitions,
+				const size_t size,
+				const size_t tokens);
+
+//!
+//! \brief Create in a net the ring of places described by the other overload.
+//! \param ptnEngine - The net in which the places and transitions are created.
+//! \param size - Number of places, and of transitions.
+//! \param tokens - Initial number of tokens of P1, the other places are empty.
+//!
+void createRing(ptne::PTN_Engine &ptnEngine, const size_t size, const size_t tokens);
@@ -16,8 +16,120 @@
  * limitations under the License.
  */
 
-// #include "PTN_Engine/ImportExport/XML/src/XML/XML_FileExporter.h"
+#include "PTN_Engine/ImportExport/FileExporterFactory.h"
+#include "PTN_Engine/ImportExport/FileImporterFactory.h"
+#include "PTN_Engine/ImportExport/IFileExporter.h"
+#include "PTN_Engine/ImportExport/IFileImporter.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <filesystem>
 #include <gtest/gtest.h>
 
+using namespace std;
+using namespace ptne;
 
-// void _export(const PTN_Engine &ptnEngine, const std::string &filePath) override;
+namespace
+{
+//! Export a net to a temporary xml file and import it into another net.
+void exportAndImport(const PTN_Engine &ptnEngine, PTN_Engine &importedPtnEngine, const string &fileName)
+{
+	const string filePath = (filesystem::temp_directory_path() / fileName).string();
+	FileExporterFactory::createXMLFileExporter()->_export(ptnEngine, filePath);
+	FileImporterFactory::createXMLFileImporter()->_import(filePath, importedPtnEngine);
+	filesystem::remove(filePath);
+}
+} // namespace
+
+TEST(XML_FileExporter_, reset_arcs_are_exported_and_imported)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .initialNumberOfTokens = 3 });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .resetArcs = { ArcProperties{ .placeName = "P2" } } });
+
+	PTN_Engine importedPtnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	exportAndImport(ptnEngine, importedPtnEngine, "ResetArcs.xml");
+
+	const vector<TransitionProperties> transitions = importedPtnEngine.getTransitionsProperties();
+	ASSERT_EQ(1, transitions.size());
+	ASSERT_EQ(1, transitions[0].resetArcs.size());
+	EXPECT_EQ("P2", transitions[0].resetArcs[0].placeName);
+	EXPECT_TRUE(transitions[0].destinationArcs.empty());
+	EXPECT_TRUE(importedPtnEngine.fireTransition("T1"));
+	EXPECT_EQ(0, importedPtnEngine.getNumberOfTokens("P2"));
+}
+
+TEST(XML_FileExporter_, read_arcs_are_exported_and_imported)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .initialNumberOfTokens = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .readArcs = { ArcProperties{ .weight = 2, .placeName = "P2" } } });
+
+	PTN_Engine importedPtnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	exportAndImport(ptnEngine, importedPtnEngine, "ReadArcs.xml");
+
+	const vector<TransitionProperties> transitions = importedPtnEngine.getTransitionsProperties();
+	ASSERT_EQ(1, transitions.size());
+	ASSERT_EQ(1, transitions[0].readArcs.size());
+	EXPECT_EQ("P2", transitions[0].readArcs[0].placeName);
+	EXPECT_EQ(2, transitions[0].readArcs[0].weight);
+	ASSERT_EQ(1, transitions[0].activationArcs.size());
+	EXPECT_EQ("P1", transitions[0].activationArcs[0].placeName);
+	EXPECT_TRUE(importedPtnEngine.fireTransition("T1"));
+	EXPECT_EQ(2, importedPtnEngine.getNumberOfTokens("P2"));
+}
+
+TEST(XML_FileExporter_, capacities_are_exported_and_imported)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true, .capacity = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Unbounded" });
+
+	PTN_Engine importedPtnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	exportAndImport(ptnEngine, importedPtnEngine, "Capacities.xml");
+
+	const vector<PlaceProperties> places = importedPtnEngine.getPlacesProperties();
+	const auto input = ranges::find(places, "Input", &PlaceProperties::name);
+	const auto unbounded = ranges::find(places, "Unbounded", &PlaceProperties::name);
+	ASSERT_NE(places.end(), input);
+	ASSERT_NE(places.end(), unbounded);
+	EXPECT_EQ(2, input->capacity);
+	EXPECT_TRUE(input->input);
+	EXPECT_EQ(0, unbounded->capacity);
+	importedPtnEngine.incrementInputPlace("Input");
+	importedPtnEngine.incrementInputPlace("Input");
+	EXPECT_THROW(importedPtnEngine.incrementInputPlace("Input"), PlaceCapacityException);
+}
+
+TEST(XML_FileExporter_, batch_firing_is_exported_and_imported)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 5 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "Batch",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .batchFiring = true });
+	ptnEngine.createTransition(TransitionProperties{ .name = "Single",
+													 .activationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	PTN_Engine importedPtnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	exportAndImport(ptnEngine, importedPtnEngine, "BatchFiring.xml");
+
+	const vector<TransitionProperties> transitions = importedPtnEngine.getTransitionsProperties();
+	const auto batch = ranges::find(transitions, "Batch", &TransitionProperties::name);
+	const auto single = ranges::find(transitions, "Single", &TransitionProperties::name);
+	ASSERT_NE(transitions.end(), batch);
+	ASSERT_NE(transitions.end(), single);
+	EXPECT_TRUE(batch->batchFiring);
+	EXPECT_FALSE(single->batchFiring);
+}
@@ -16,8 +16,152 @@
  * limitations under the License.
  */
 
-// #include "PTN_Engine/ImportExport/XML/src/XML/XML_FileImporter.h"
+#include "PTN_Engine/ImportExport/FileImporterFactory.h"
+#include "PTN_Engine/ImportExport/IFileImporter.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 
+using namespace std;
+using namespace ptne;
 
-// void _import(const std::string &filePath, PTN_Engine &ptnEngine) override;
+namespace
+{
+const string assetsDirectory = IMPORT_EXPORT_ASSETS_DIR;
+
+//! Import the net of an asset, registering the conditions its transitions use.
+void importNet(PTN_Engine &ptnEngine, const string &fileName)
+{
+	ptnEngine.registerCondition("canStart", [] { return true; });
+	ptnEngine.registerCondition("isReady", [] { return true; });
+	FileImporterFactory::createXMLFileImporter()->_import(assetsDirectory + fileName, ptnEngine);
+}
+
+TransitionProperties getTransition(const PTN_Engine &ptnEngine, const string &name)
+{
+	const vector<TransitionProperties> transitions = ptnEngine.getTransitionsProperties();
+	return *ranges::find(transitions, name, &TransitionProperties::name);
+}
+} // namespace
+
+TEST(XML_FileImporter_, reloading_keeps_the_marking_and_applies_the_changes)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	importNet(ptnEngine, "Net.xml");
+	ASSERT_TRUE(ptnEngine.fireTransition("Start"));
+
+	const ReloadResult result =
+	FileImporterFactory::createXMLFileImporter()->_reload(assetsDirectory + "RevisedNet.xml", ptnEngine);
+
+	EXPECT_EQ(vector<string>{ "New" }, result.addedPlaces);
+	EXPECT_EQ(vector<string>{ "Old" }, result.removedPlaces);
+	EXPECT_EQ(vector<string>{ "Refill" }, result.addedTransitions);
+	EXPECT_EQ(vector<string>{ "Drain" }, result.removedTransitions);
+	EXPECT_EQ((vector<string>{ "Start", "Finish", "Recycle" }), result.changedTransitions);
+
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Idle"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Busy"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Done"));
+	EXPECT_EQ(4, ptnEngine.getNumberOfTokens("New"));
+	EXPECT_THROW(ptnEngine.getNumberOfTokens("Old"), PTN_Exception);
+
+	EXPECT_EQ((vector<string>{ "canStart", "isReady" }), getTransition(ptnEngine, "Start").additionalConditionsNames);
+	ASSERT_EQ(1, getTransition(ptnEngine, "Finish").destinationArcs.size());
+	EXPECT_EQ(2, getTransition(ptnEngine, "Finish").destinationArcs[0].weight);
+	EXPECT_EQ(10ms, getTransition(ptnEngine, "Recycle").minimumDelay);
+	EXPECT_EQ(1, getTransition(ptnEngine, "Refill").destinationArcs.size());
+	EXPECT_EQ(4, ptnEngine.getTransitionsProperties().size());
+
+	// The reloaded net keeps firing from the kept marking.
+	EXPECT_TRUE(ptnEngine.fireTransition("Finish"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Busy"));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Done"));
+}
+
+TEST(XML_FileImporter_, reloading_the_same_net_changes_nothing)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	importNet(ptnEngine, "Net.xml");
+
+	const ReloadResult result =
+	FileImporterFactory::createXMLFileImporter()->_reload(assetsDirectory + "Net.xml", ptnEngine);
+
+	EXPECT_TRUE(result.addedPlaces.empty());
+	EXPECT_TRUE(result.removedPlaces.empty());
+	EXPECT_TRUE(result.addedTransitions.empty());
+	EXPECT_TRUE(result.removedTransitions.empty());
+	EXPECT_TRUE(result.changedTransitions.empty());
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Old"));
+}
+
+TEST(XML_FileImporter_, reloading_rejects_changes_to_the_input_flag_the_capacity_or_the_actions_of_a_place)
+{
+	auto reload = [](PTN_Engine &ptnEngine)
+	{ FileImporterFactory::createXMLFileImporter()->_reload(assetsDirectory + "Net.xml", ptnEngine); };
+
+	PTN_Engine inputChanged(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	inputChanged.createPlace(PlaceProperties{ .name = "Idle", .input = true });
+	EXPECT_THROW(reload(inputChanged), PTN_Exception);
+
+	PTN_Engine capacityChanged(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	capacityChanged.createPlace(PlaceProperties{ .name = "Requests", .input = true, .capacity = 5 });
+	EXPECT_THROW(reload(capacityChanged), PTN_Exception);
+
+	PTN_Engine actionChanged(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	actionChanged.registerAction("log", [] {});
+	actionChanged.createPlace(PlaceProperties{ .name = "Done", .onEnterActionFunctionName = "log" });
+	EXPECT_THROW(reload(actionChanged), PTN_Exception);
+
+	// The rejected reloads leave the nets unchanged.
+	for (const PTN_Engine *ptnEngine : { &inputChanged, &capacityChanged, &actionChanged })
+	{
+		EXPECT_EQ(1, ptnEngine->getPlacesProperties().size());
+		EXPECT_TRUE(ptnEngine->getTransitionsProperties().empty());
+	}
+}
+
+TEST(XML_FileImporter_, reset_places_are_imported_as_reset_arcs)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	importNet(ptnEngine, "Transitions.xml");
+
+	const TransitionProperties flush = getTransition(ptnEngine, "Flush");
+	ASSERT_EQ(1, flush.resetArcs.size());
+	EXPECT_EQ("Buffer", flush.resetArcs[0].placeName);
+	EXPECT_TRUE(ptnEngine.fireTransition("Flush"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Buffer"));
+}
+
+TEST(XML_FileImporter_, read_places_are_imported_as_read_arcs)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	importNet(ptnEngine, "Transitions.xml");
+
+	const TransitionProperties check = getTransition(ptnEngine, "Check");
+	ASSERT_EQ(1, check.readArcs.size());
+	EXPECT_EQ("Permit", check.readArcs[0].placeName);
+	EXPECT_TRUE(check.activationArcs.empty());
+	EXPECT_TRUE(ptnEngine.fireTransition("Check"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Permit"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Done"));
+}
+
+TEST(XML_FileImporter_, capacities_are_imported)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	importNet(ptnEngine, "Net.xml");
+
+	const vector<PlaceProperties> places = ptnEngine.getPlacesProperties();
+	EXPECT_EQ(3, ranges::find(places, "Requests", &PlaceProperties::name)->capacity);
+	EXPECT_EQ(0, ranges::find(places, "Idle", &PlaceProperties::name)->capacity);
+}
+
+TEST(XML_FileImporter_, batch_firing_is_imported)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	importNet(ptnEngine, "Transitions.xml");
+
+	EXPECT_TRUE(getTransition(ptnEngine, "Process").batchFiring);
+	EXPECT_FALSE(getTransition(ptnEngine, "Flush").batchFiring);
+}
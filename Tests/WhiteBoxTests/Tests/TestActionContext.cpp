@@ -0,0 +1,194 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <future>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! What a context action was told, copied since the name is only valid during the call.
+struct Call
+{
+	const void *placeHandle = nullptr;
+	string placeName;
+	ptrdiff_t tokenDelta = 0;
+	size_t numberOfTokens = 0;
+};
+
+void recordCall(const ActionContext &context)
+{
+	static_cast<vector<Call> *>(context.userData)
+	->push_back(Call{ .placeHandle = context.placeHandle,
+					  .placeName = string(context.placeName),
+					  .tokenDelta = context.tokenDelta,
+					  .numberOfTokens = context.numberOfTokens });
+}
+} // namespace
+
+TEST(ActionContext_, a_registered_context_action_serves_many_places)
+{
+	vector<Call> calls;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.registerAction("record", ContextAction{ .function = recordCall, .userData = &calls });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 1 });
+	for (const string name : { "P1", "P2" })
+	{
+		ptnEngine.createPlace(PlaceProperties{ .name = name, .onEnterActionFunctionName = "record" });
+	}
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "T1",
+						  .activationArcs = { ArcProperties{ .placeName = "Input" } },
+						  .destinationArcs = { ArcProperties{ .weight = 2, .placeName = "P1" },
+											   ArcProperties{ .weight = 3, .placeName = "P2" } } });
+
+	EXPECT_TRUE(ptnEngine.fireTransition("T1"));
+	ASSERT_EQ(2, calls.size());
+	ranges::sort(calls, {}, &Call::placeName);
+	EXPECT_EQ("P1", calls[0].placeName);
+	EXPECT_EQ(2, calls[0].tokenDelta);
+	EXPECT_EQ(2, calls[0].numberOfTokens);
+	EXPECT_EQ("P2", calls[1].placeName);
+	EXPECT_EQ(3, calls[1].tokenDelta);
+	EXPECT_EQ(3, calls[1].numberOfTokens);
+	EXPECT_NE(calls[0].placeHandle, calls[1].placeHandle);
+}
+
+TEST(ActionContext_, exit_actions_are_told_the_tokens_that_left)
+{
+	vector<Call> calls;
+	const ContextAction record{ .function = recordCall, .userData = &calls };
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(
+	PlaceProperties{ .name = "Consumed", .initialNumberOfTokens = 5, .onExitContextAction = record });
+	ptnEngine.createPlace(
+	PlaceProperties{ .name = "Reset", .initialNumberOfTokens = 4, .onExitContextAction = record });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .weight = 2,
+																						.placeName = "Consumed" } },
+													 .resetArcs = { ArcProperties{ .placeName = "Reset" } } });
+
+	EXPECT_TRUE(ptnEngine.fireTransition("T1"));
+	ASSERT_EQ(2, calls.size());
+	ranges::sort(calls, {}, &Call::placeName);
+	EXPECT_EQ(-2, calls[0].tokenDelta);
+	EXPECT_EQ(3, calls[0].numberOfTokens);
+	EXPECT_EQ(-4, calls[1].tokenDelta);
+	EXPECT_EQ(0, calls[1].numberOfTokens);
+}
+
+TEST(ActionContext_, each_firing_of_a_batch_is_told_its_share_of_the_tokens)
+{
+	vector<Call> calls;
+	const ContextAction record{ .function = recordCall, .userData = &calls };
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 3 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output", .onEnterContextAction = record });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .weight = 2,
+																						 .placeName = "Output" } },
+													 .batchFiring = true });
+
+	EXPECT_EQ(3, ptnEngine.step(3).firedTransitions);
+	ASSERT_EQ(3, calls.size());
+	for (size_t i = 0; i < calls.size(); ++i)
+	{
+		EXPECT_EQ(2, calls[i].tokenDelta);
+		EXPECT_EQ(2 * (i + 1), calls[i].numberOfTokens);
+	}
+}
+
+TEST(ActionContext_, context_actions_are_run_by_the_job_queue)
+{
+	vector<Call> calls;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	ptnEngine.registerAction("record", ContextAction{ .function = recordCall, .userData = &calls });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output", .onEnterActionFunctionName = "record" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace("Input");
+	this_thread::sleep_for(100ms);
+	ptnEngine.stop();
+
+	ASSERT_EQ(1, calls.size());
+	EXPECT_EQ("Output", calls[0].placeName);
+	EXPECT_EQ(1, calls[0].numberOfTokens);
+}
+
+TEST(ActionContext_, queued_context_actions_keep_their_place_alive)
+{
+	vector<Call> calls;
+	promise<void> gate;
+	future<void> gateOpened = gate.get_future();
+	auto waitForGate = [](const ActionContext &context) { static_cast<future<void> *>(context.userData)->wait(); };
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(
+	PlaceProperties{ .name = "Gate", .onEnterContextAction = { .function = waitForGate, .userData = &gateOpened } });
+	ptnEngine.createPlace(PlaceProperties{ .name = "A place with a name too long for the small string optimization",
+										   .onEnterContextAction = { .function = recordCall, .userData = &calls } });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "T1",
+						  .activationArcs = { ArcProperties{ .placeName = "Input" } },
+						  .destinationArcs = { ArcProperties{ .placeName = "Gate" },
+											   ArcProperties{ .placeName = "A place with a name too long for the "
+																		  "small string optimization" } } });
+
+	// The action of the removed place is still queued behind the action of the gate.
+	EXPECT_TRUE(ptnEngine.fireTransition("T1"));
+	ptnEngine.clearNet();
+	gate.set_value();
+	this_thread::sleep_for(100ms);
+
+	ASSERT_EQ(1, calls.size());
+	EXPECT_EQ("A place with a name too long for the small string optimization", calls[0].placeName);
+	EXPECT_EQ(1, calls[0].numberOfTokens);
+}
+
+TEST(ActionContext_, invalid_context_actions_throw)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.registerAction("action", [] {});
+	const ContextAction record{ .function = recordCall };
+	EXPECT_THROW(ptnEngine.registerAction("action", record), RepeatedFunctionException);
+	EXPECT_THROW(ptnEngine.registerAction("null", ContextAction{}), PTN_Exception);
+
+	ptnEngine.registerAction("context", record);
+	EXPECT_THROW(ptnEngine.registerAction("context", [] {}), RepeatedFunctionException);
+	EXPECT_THROW(ptnEngine.createPlace(
+				 PlaceProperties{ .name = "P1", .onEnterAction = [] {}, .onEnterContextAction = record }),
+				 PTN_Exception);
+	EXPECT_TRUE(ptnEngine.getPlacesProperties().empty());
+
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .onExitActionFunctionName = "context" });
+	EXPECT_EQ(recordCall, ptnEngine.getPlacesProperties().front().onExitContextAction.function);
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Batch firing transition T1, taking tokens from Input two at a time and giving three to Output.
+void createBatchNet(PTN_Engine &ptnEngine, const size_t inputTokens, size_t &exits, size_t &enters)
+{
+	ptnEngine.createPlace(
+	PlaceProperties{ .name = "Input", .initialNumberOfTokens = inputTokens, .onExitAction = [&exits] { ++exits; } });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output", .onEnterAction = [&enters] { ++enters; } });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "T1",
+						  .activationArcs = { ArcProperties{ .weight = 2, .placeName = "Input" } },
+						  .destinationArcs = { ArcProperties{ .weight = 3, .placeName = "Output" } },
+						  .batchFiring = true });
+}
+} // namespace
+
+TEST(BatchFiring_, fires_the_enabling_degree_at_once_and_calls_the_actions_per_firing)
+{
+	size_t exits = 0;
+	size_t enters = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createBatchNet(ptnEngine, 20001, exits, enters);
+
+	const StepResult result = ptnEngine.step(numeric_limits<size_t>::max());
+	EXPECT_EQ(10000, result.firedTransitions);
+	EXPECT_FALSE(result.workRemaining);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(30000, ptnEngine.getNumberOfTokens("Output"));
+	EXPECT_EQ(10000, exits);
+	EXPECT_EQ(10000, enters);
+	EXPECT_TRUE(ptnEngine.getTransitionsProperties().front().batchFiring);
+}
+
+TEST(BatchFiring_, batches_are_limited_by_the_firing_budget)
+{
+	size_t exits = 0;
+	size_t enters = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createBatchNet(ptnEngine, 20, exits, enters);
+
+	EXPECT_EQ(4, ptnEngine.step(4).firedTransitions);
+	EXPECT_EQ(12, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_TRUE(ptnEngine.fireTransition("T1"));
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(5, exits);
+}
+
+TEST(BatchFiring_, batches_are_limited_by_capacities)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 10 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Bounded", .capacity = 7 });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "Fill",
+						  .activationArcs = { ArcProperties{ .placeName = "Input" } },
+						  .destinationArcs = { ArcProperties{ .weight = 2, .placeName = "Bounded" } },
+						  .batchFiring = true });
+
+	EXPECT_EQ(3, ptnEngine.step(10).firedTransitions);
+	EXPECT_EQ(6, ptnEngine.getNumberOfTokens("Bounded"));
+	EXPECT_EQ(7, ptnEngine.getNumberOfTokens("Input"));
+}
+
+TEST(BatchFiring_, transitions_inhibited_by_their_destinations_fire_once)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 10 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Done" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "Once",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Done" } },
+													 .inhibitorArcs = { ArcProperties{ .placeName = "Done" } },
+													 .batchFiring = true });
+
+	EXPECT_EQ(1, ptnEngine.step(10).firedTransitions);
+	EXPECT_EQ(9, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Done"));
+}
+
+TEST(BatchFiring_, recorded_batches_replay_as_single_firings)
+{
+	size_t exits = 0;
+	size_t enters = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createBatchNet(ptnEngine, 10, exits, enters);
+
+	ptnEngine.startRecording();
+	EXPECT_EQ(5, ptnEngine.step(10).firedTransitions);
+	const ExecutionRecording recording = ptnEngine.stopRecording();
+	EXPECT_EQ(5, recording.events.size());
+
+	ptnEngine.replay(recording);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(15, ptnEngine.getNumberOfTokens("Output"));
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/Condition.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+bool isSet(void *flag)
+{
+	return *static_cast<bool *>(flag);
+}
+
+//! Transition T<i> moving the token of place In<i> to place Out<i>.
+void createTransition(PTN_Engine &ptnEngine, const size_t i, const TransitionProperties &conditions)
+{
+	const string suffix = to_string(i);
+	ptnEngine.createPlace(PlaceProperties{ .name = "In" + suffix, .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Out" + suffix });
+	TransitionProperties transitionProperties = conditions;
+	transitionProperties.name = "T" + suffix;
+	transitionProperties.activationArcs = { ArcProperties{ .placeName = "In" + suffix } };
+	transitionProperties.destinationArcs = { ArcProperties{ .placeName = "Out" + suffix } };
+	ptnEngine.createTransition(transitionProperties);
+}
+} // namespace
+
+TEST(ContextCondition_, context_conditions_are_called_with_their_user_data)
+{
+	bool flag = false;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createTransition(ptnEngine, 0, TransitionProperties{ .additionalContextConditions = { { isSet, &flag } } });
+
+	EXPECT_FALSE(ptnEngine.fireTransition("T0"));
+	flag = true;
+	EXPECT_TRUE(ptnEngine.fireTransition("T0"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Out0"));
+}
+
+TEST(ContextCondition_, a_registered_context_condition_serves_many_transitions)
+{
+	bool flag = false;
+	bool otherFlag = true;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.registerCondition("flag", ContextCondition{ .function = isSet, .userData = &flag });
+	ptnEngine.registerCondition("otherFlag", [&otherFlag] { return otherFlag; });
+	for (size_t i = 0; i < 3; ++i)
+	{
+		createTransition(ptnEngine, i, TransitionProperties{ .additionalConditionsNames = { "flag", "otherFlag" } });
+	}
+
+	EXPECT_EQ(0, ptnEngine.step(10).firedTransitions);
+	flag = true;
+	EXPECT_EQ(3, ptnEngine.step(10).firedTransitions);
+}
+
+TEST(ContextCondition_, transition_properties_keep_both_kinds_of_conditions)
+{
+	bool flag = true;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createTransition(ptnEngine,
+					 0,
+					 TransitionProperties{ .additionalConditions = { [] { return true; } },
+										   .additionalContextConditions = { { isSet, &flag } } });
+
+	const TransitionProperties transitionProperties = ptnEngine.getTransitionsProperties().front();
+	ASSERT_EQ(1, transitionProperties.additionalConditions.size());
+	EXPECT_TRUE(transitionProperties.additionalConditions.front()());
+	ASSERT_EQ(1, transitionProperties.additionalContextConditions.size());
+	EXPECT_EQ(isSet, transitionProperties.additionalContextConditions.front().function);
+	EXPECT_EQ(&flag, transitionProperties.additionalContextConditions.front().userData);
+}
+
+TEST(ContextCondition_, invalid_context_conditions_throw)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	EXPECT_THROW(ptnEngine.registerCondition("null", ContextCondition{}), PTN_Exception);
+	ptnEngine.registerCondition("condition", [] { return true; });
+	EXPECT_THROW(ptnEngine.registerCondition("condition", ContextCondition{ .function = isSet }),
+				 RepeatedFunctionException);
+}
+
+TEST(ContextCondition_, copies_of_a_condition_share_its_function)
+{
+	size_t calls = 0;
+	const Condition condition(ConditionFunction([&calls] { return ++calls != 0; }));
+	const Condition copy = condition;
+
+	EXPECT_TRUE(copy());
+	EXPECT_EQ(1, calls);
+	EXPECT_EQ(condition.getConditionFunction(), copy.getConditionFunction());
+	EXPECT_EQ(nullptr, copy.getContextCondition().function);
+	EXPECT_FALSE(Condition());
+	EXPECT_FALSE(Condition(ConditionFunction()));
+}
@@ -0,0 +1,138 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/Coverability.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! A worker processing the requests queued from an input place.
+void createRequestQueue(PTN_Engine &ptnEngine)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Requests", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Queue" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Idle", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Busy" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "Receive",
+													 .activationArcs = { ArcProperties{ .placeName = "Requests" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Queue" } } });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "Start",
+						  .activationArcs = { ArcProperties{ .placeName = "Queue" }, ArcProperties{ .placeName = "Idle" } },
+						  .destinationArcs = { ArcProperties{ .placeName = "Busy" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "Finish",
+													 .activationArcs = { ArcProperties{ .placeName = "Busy" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Idle" } } });
+}
+
+//! Independent cycles of places, each with one token.
+void createCycles(vector<PlaceProperties> &places,
+				  vector<TransitionProperties> &transitions,
+				  const size_t numberOfCycles,
+				  const size_t cycleSize)
+{
+	for (size_t i = 0; i < numberOfCycles; ++i)
+	{
+		for (size_t j = 0; j < cycleSize; ++j)
+		{
+			const string place = "P" + to_string(i) + "_" + to_string(j);
+			const string nextPlace = "P" + to_string(i) + "_" + to_string((j + 1) % cycleSize);
+			places.push_back(PlaceProperties{ .name = place, .initialNumberOfTokens = j == 0 ? 1u : 0u });
+			transitions.push_back(TransitionProperties{ .name = "T" + to_string(i) + "_" + to_string(j),
+														.activationArcs = { ArcProperties{ .placeName = place } },
+														.destinationArcs = { ArcProperties{ .placeName = nextPlace } } });
+		}
+	}
+}
+} // namespace
+
+TEST(Coverability_, input_places_are_unbounded_sources)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRequestQueue(ptnEngine);
+
+	const CoverabilityResult result = exploreCoverability(
+	ptnEngine,
+	CoverabilityOptions{ .targetMarkings = { { { "Queue", 1000 }, { "Busy", 1 } }, { { "Idle", 1 }, { "Busy", 1 } } } });
+	EXPECT_TRUE(result.complete);
+	EXPECT_EQ((vector<string>{ "Queue", "Requests" }), result.unboundedPlaces);
+	EXPECT_EQ((map<string, size_t>{ { "Busy", 1 }, { "Idle", 1 } }), result.placeBounds);
+	EXPECT_EQ((vector<bool>{ true, false }), result.coverableTargetMarkings);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Queue"));
+}
+
+TEST(Coverability_, unbounded_places_are_found_without_input_places)
+{
+	// Producer leaks tokens into P2, which is never consumed.
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "P2" },
+										  PlaceProperties{ .name = "P3" } };
+	const vector<TransitionProperties> transitions{
+		TransitionProperties{ .name = "Produce",
+							  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P1" }, ArcProperties{ .placeName = "P2" } } },
+		TransitionProperties{ .name = "Stop",
+							  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P3" } } }
+	};
+
+	const CoverabilityResult result = exploreCoverability(
+	places, transitions, CoverabilityOptions{ .targetMarkings = { { { "P2", 5 }, { "P3", 1 } }, { { "P1", 2 } } } });
+	EXPECT_TRUE(result.complete);
+	EXPECT_EQ(vector<string>{ "P2" }, result.unboundedPlaces);
+	EXPECT_EQ((map<string, size_t>{ { "P1", 1 }, { "P3", 1 } }), result.placeBounds);
+	EXPECT_EQ((vector<bool>{ true, false }), result.coverableTargetMarkings);
+
+	EXPECT_THROW(exploreCoverability(places, transitions, CoverabilityOptions{ .targetMarkings = { { { "P4", 1 } } } }),
+				 InvalidNameException);
+}
+
+TEST(Coverability_, bounded_nets_give_the_same_result_with_any_number_of_threads)
+{
+	vector<PlaceProperties> places;
+	vector<TransitionProperties> transitions;
+	createCycles(places, transitions, 4, 4);
+
+	const CoverabilityResult result =
+	exploreCoverability(places, transitions, CoverabilityOptions{ .numberOfThreads = 1 });
+	EXPECT_TRUE(result.complete);
+	EXPECT_TRUE(result.unboundedPlaces.empty());
+	EXPECT_EQ(16, result.placeBounds.size());
+	EXPECT_EQ(1, result.placeBounds.at("P3_2"));
+
+	const CoverabilityResult parallelResult =
+	exploreCoverability(places, transitions, CoverabilityOptions{ .numberOfThreads = 4 });
+	EXPECT_EQ(result.numberOfNodes, parallelResult.numberOfNodes);
+	EXPECT_EQ(result.placeBounds, parallelResult.placeBounds);
+}
+
+TEST(Coverability_, incomplete_analyses_are_reported)
+{
+	vector<PlaceProperties> places;
+	vector<TransitionProperties> transitions;
+	createCycles(places, transitions, 4, 4);
+
+	const CoverabilityResult result = exploreCoverability(places, transitions, CoverabilityOptions{ .maxNodes = 10 });
+	EXPECT_FALSE(result.complete);
+	EXPECT_EQ(10, result.numberOfNodes);
+}
@@ -0,0 +1,117 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EventLoopScheduler.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+void createInputToOutputNet(PTN_Engine &ptnEngine)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+}
+} // namespace
+
+TEST(EventLoopScheduler_, constructor_with_zero_threads_throws)
+{
+	EXPECT_THROW(EventLoopScheduler{ 0 }, PTN_Exception);
+}
+
+TEST(EventLoopScheduler_, getNumberOfThreads_returns_the_number_of_threads_in_the_pool)
+{
+	EventLoopScheduler scheduler(3);
+	EXPECT_EQ(3, scheduler.getNumberOfThreads());
+}
+
+TEST(EventLoopScheduler_, engines_attached_to_a_scheduler_process_their_inputs)
+{
+	auto scheduler = make_shared<EventLoopScheduler>(2);
+
+	vector<unique_ptr<PTN_Engine>> ptnEngines;
+	for (size_t i = 0; i < 50; ++i)
+	{
+		auto ptnEngine = make_unique<PTN_Engine>(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+		ptnEngine->setEventLoopScheduler(scheduler);
+		createInputToOutputNet(*ptnEngine);
+		ptnEngine->execute();
+		EXPECT_TRUE(ptnEngine->isEventLoopRunning());
+		ptnEngines.push_back(std::move(ptnEngine));
+	}
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		for (auto &ptnEngine : ptnEngines)
+		{
+			ptnEngine->incrementInputPlace("Input");
+		}
+	}
+	this_thread::sleep_for(100ms);
+
+	for (auto &ptnEngine : ptnEngines)
+	{
+		EXPECT_EQ(0, ptnEngine->getNumberOfTokens("Input"));
+		EXPECT_EQ(3, ptnEngine->getNumberOfTokens("Output"));
+		ptnEngine->stop();
+		EXPECT_FALSE(ptnEngine->isEventLoopRunning());
+	}
+}
+
+TEST(EventLoopScheduler_, stopped_engines_are_not_run_by_the_scheduler)
+{
+	auto scheduler = make_shared<EventLoopScheduler>(1);
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	ptnEngine.setEventLoopScheduler(scheduler);
+	createInputToOutputNet(ptnEngine);
+
+	ptnEngine.execute();
+	ptnEngine.stop();
+	ptnEngine.incrementInputPlace("Input");
+	this_thread::sleep_for(50ms);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Output"));
+
+	ptnEngine.execute();
+	this_thread::sleep_for(50ms);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Output"));
+}
+
+TEST(EventLoopScheduler_, setEventLoopScheduler_while_running_throws)
+{
+	auto scheduler = make_shared<EventLoopScheduler>(1);
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	EXPECT_EQ(nullptr, ptnEngine.getEventLoopScheduler());
+	ptnEngine.setEventLoopScheduler(scheduler);
+	EXPECT_EQ(scheduler, ptnEngine.getEventLoopScheduler());
+
+	ptnEngine.execute();
+	EXPECT_THROW(ptnEngine.setEventLoopScheduler(nullptr), PTN_Exception);
+	ptnEngine.stop();
+	ptnEngine.setEventLoopScheduler(nullptr);
+	EXPECT_EQ(nullptr, ptnEngine.getEventLoopScheduler());
+}
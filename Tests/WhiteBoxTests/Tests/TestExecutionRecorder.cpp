@@ -0,0 +1,142 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Input place whose tokens go to A or B. Only T2 has a condition.
+void createConflict(PTN_Engine &ptnEngine, const ConditionFunction &condition, const ActionFunction &onEnterA = {})
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "A", .onEnterAction = onEnterA });
+	ptnEngine.createPlace(PlaceProperties{ .name = "B" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "A" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "B" } },
+													 .additionalConditions = { condition } });
+}
+} // namespace
+
+TEST(ExecutionRecorder_, replay_reproduces_a_recorded_execution)
+{
+	atomic<size_t> evaluations = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	createConflict(ptnEngine, [&evaluations] { return ++evaluations % 3 == 0; });
+	ptnEngine.incrementInputPlace("Input");
+	ptnEngine.execute();
+	while (ptnEngine.getNumberOfTokens("Input") != 0)
+	{
+		this_thread::sleep_for(1ms);
+	}
+	ptnEngine.startRecording();
+	for (size_t i = 0; i < 200; ++i)
+	{
+		ptnEngine.incrementInputPlace("Input");
+	}
+	while (ptnEngine.getNumberOfTokens("A") + ptnEngine.getNumberOfTokens("B") < 201)
+	{
+		this_thread::sleep_for(1ms);
+	}
+	EXPECT_THROW(ptnEngine.createPlace(PlaceProperties{ .name = "C" }), PTN_Exception);
+	const ExecutionRecording recording = ptnEngine.stopRecording();
+	ptnEngine.stop();
+	EXPECT_EQ(400, recording.events.size());
+
+	// The conditions of the copy never hold, the replay takes them as recorded.
+	PTN_Engine copy(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createConflict(copy, [] { return false; });
+	copy.replay(recording);
+	EXPECT_EQ(ptnEngine.getNumberOfTokens("A"), copy.getNumberOfTokens("A"));
+	EXPECT_EQ(ptnEngine.getNumberOfTokens("B"), copy.getNumberOfTokens("B"));
+	EXPECT_EQ(0, copy.getNumberOfTokens("Input"));
+}
+
+TEST(ExecutionRecorder_, replay_throws_at_the_first_firing_that_is_not_enabled)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createConflict(ptnEngine, [] { return true; });
+	ptnEngine.startRecording();
+	ptnEngine.incrementInputPlace("Input");
+	ptnEngine.step(1);
+	ExecutionRecording recording = ptnEngine.stopRecording();
+	ASSERT_EQ(2, recording.events.size());
+	EXPECT_EQ(RecordedEvent::Type::INPUT, recording.events[0].type);
+	EXPECT_EQ(RecordedEvent::Type::FIRING, recording.events[1].type);
+
+	ranges::swap(recording.events[0], recording.events[1]);
+	EXPECT_THROW(ptnEngine.replay(recording), ReplayDivergenceException);
+
+	recording.events[0].name = "T3";
+	EXPECT_THROW(ptnEngine.replay(recording), InvalidNameException);
+}
+
+TEST(ExecutionRecorder_, actions_are_only_executed_on_request)
+{
+	size_t onEnterA = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createConflict(ptnEngine, [] { return false; }, [&onEnterA] { ++onEnterA; });
+	ptnEngine.startRecording();
+	ptnEngine.incrementInputPlace("Input");
+	ptnEngine.step(1);
+	const ExecutionRecording recording = ptnEngine.stopRecording();
+	EXPECT_EQ(1, onEnterA);
+
+	ptnEngine.replay(recording);
+	EXPECT_EQ(1, onEnterA);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("A"));
+
+	ptnEngine.replay(recording, true);
+	EXPECT_EQ(2, onEnterA);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("A"));
+}
+
+TEST(ExecutionRecorder_, executions_with_the_same_random_seed_are_repeated)
+{
+	auto run = []
+	{
+		PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+		createConflict(ptnEngine, [] { return true; });
+		ptnEngine.setRandomSeed(42);
+		ptnEngine.startRecording();
+		for (size_t i = 0; i < 100; ++i)
+		{
+			ptnEngine.incrementInputPlace("Input");
+			ptnEngine.step(1);
+		}
+		return ptnEngine.stopRecording();
+	};
+
+	const ExecutionRecording first = run();
+	const ExecutionRecording second = run();
+	ASSERT_EQ(first.events.size(), second.events.size());
+	for (size_t i = 0; i < first.events.size(); ++i)
+	{
+		EXPECT_EQ(first.events[i].name, second.events[i].name);
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+#include "PTN_Engine/Analysis/Invariants.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+TEST(Invariants_, minimal_invariants_of_a_mutual_exclusion)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createMutualExclusion(ptnEngine);
+
+	const InvariantsResult result = computeInvariants(ptnEngine);
+	EXPECT_TRUE(result.complete);
+	using Invariant = map<string, size_t>;
+	EXPECT_EQ(3, result.placeInvariants.size());
+	EXPECT_NE(ranges::find(result.placeInvariants, Invariant{ { "Critical1", 1 }, { "Critical2", 1 }, { "Mutex", 1 } }),
+			  result.placeInvariants.end());
+	EXPECT_NE(ranges::find(result.placeInvariants, Invariant{ { "Critical1", 1 }, { "Idle1", 1 } }),
+			  result.placeInvariants.end());
+	EXPECT_NE(ranges::find(result.placeInvariants, Invariant{ { "Critical2", 1 }, { "Idle2", 1 } }),
+			  result.placeInvariants.end());
+
+	EXPECT_EQ(2, result.transitionInvariants.size());
+	EXPECT_NE(ranges::find(result.transitionInvariants, Invariant{ { "Enter1", 1 }, { "Leave1", 1 } }),
+			  result.transitionInvariants.end());
+	EXPECT_NE(ranges::find(result.transitionInvariants, Invariant{ { "Enter2", 1 }, { "Leave2", 1 } }),
+			  result.transitionInvariants.end());
+
+	EXPECT_EQ((Invariant{ { "Critical1", 1 }, { "Critical2", 1 }, { "Idle1", 1 }, { "Idle2", 1 }, { "Mutex", 1 } }),
+			  result.placeBounds);
+}
+
+TEST(Invariants_, weighted_arcs_and_unbounded_places)
+{
+	vector<PlaceProperties> places{ PlaceProperties{ .name = "P1", .initialNumberOfTokens = 3 },
+									PlaceProperties{ .name = "P2" },
+									PlaceProperties{ .name = "P3" } };
+	vector<TransitionProperties> transitions{
+		TransitionProperties{ .name = "Split",
+							  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+							  .destinationArcs = { ArcProperties{ .weight = 2, .placeName = "P2" } } },
+		TransitionProperties{ .name = "Join",
+							  .activationArcs = { ArcProperties{ .weight = 2, .placeName = "P2" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P1" } } }
+	};
+
+	const InvariantsResult result = computeInvariants(places, transitions);
+	using Invariant = map<string, size_t>;
+	EXPECT_EQ((vector<Invariant>{ { { "P1", 2 }, { "P2", 1 } }, { { "P3", 1 } } }), result.placeInvariants);
+	EXPECT_EQ((vector<Invariant>{ { { "Join", 1 }, { "Split", 1 } } }), result.transitionInvariants);
+	EXPECT_EQ((Invariant{ { "P1", 3 }, { "P2", 6 }, { "P3", 0 } }), result.placeBounds);
+
+	// A producer makes P3 unbounded, so it is no longer covered by a place invariant.
+	transitions.push_back(TransitionProperties{ .name = "Produce",
+												.activationArcs = { ArcProperties{ .placeName = "P1" } },
+												.destinationArcs = { ArcProperties{ .placeName = "P1" },
+																	 ArcProperties{ .placeName = "P3" } } });
+	const InvariantsResult unboundedResult =
+	computeInvariants(places, transitions, InvariantsOptions{ .computeTransitionInvariants = false });
+	EXPECT_EQ((vector<Invariant>{ { { "P1", 2 }, { "P2", 1 } } }), unboundedResult.placeInvariants);
+	EXPECT_TRUE(unboundedResult.transitionInvariants.empty());
+	EXPECT_EQ((Invariant{ { "P1", 3 }, { "P2", 6 } }), unboundedResult.placeBounds);
+}
+
+TEST(Invariants_, large_sparse_nets)
+{
+	vector<PlaceProperties> places;
+	vector<TransitionProperties> transitions;
+	createRing(places, transitions, 10000, 5000);
+
+	const InvariantsResult result = computeInvariants(places, transitions);
+	EXPECT_TRUE(result.complete);
+	ASSERT_EQ(1, result.placeInvariants.size());
+	EXPECT_EQ(10000, result.placeInvariants[0].size());
+	ASSERT_EQ(1, result.transitionInvariants.size());
+	EXPECT_EQ(10000, result.transitionInvariants[0].size());
+	EXPECT_EQ(5000, result.placeBounds.at("P42"));
+}
+
+TEST(Invariants_, incomplete_computations_are_reported)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createMutualExclusion(ptnEngine);
+
+	const InvariantsResult result = computeInvariants(ptnEngine, InvariantsOptions{ .maxRows = 4 });
+	EXPECT_FALSE(result.complete);
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Input place feeding a pipeline of two transitions.
+void createPipeline(PTN_Engine &ptnEngine)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Middle" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Middle" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .weight = 2, .placeName = "Middle" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+}
+
+class Journal_ : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		const string name = testing::UnitTest::GetInstance()->current_test_info()->name();
+		m_path = filesystem::temp_directory_path() / ("PTN_Engine_" + name + ".journal");
+		filesystem::remove(m_path);
+	}
+
+	void TearDown() override
+	{
+		filesystem::remove(m_path);
+	}
+
+	JournalOptions options(const size_t checkpointInterval = 100'000) const
+	{
+		return JournalOptions{ .path = m_path.string(), .checkpointInterval = checkpointInterval };
+	}
+
+	filesystem::path m_path;
+};
+} // namespace
+
+TEST_F(Journal_, the_marking_is_recovered_from_the_journal)
+{
+	{
+		PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+		createPipeline(ptnEngine);
+		EXPECT_EQ(0, ptnEngine.openJournal(options()));
+		for (size_t i = 0; i < 5; ++i)
+		{
+			ptnEngine.incrementInputPlace("Input");
+		}
+		ptnEngine.step(100);
+		ptnEngine.incrementInputPlace("Input");
+	}
+
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createPipeline(ptnEngine);
+	// 6 inputs, 5 firings of T1 and 2 of T2.
+	EXPECT_EQ(13, ptnEngine.openJournal(options()));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Middle"));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Output"));
+	EXPECT_THROW(ptnEngine.createPlace(PlaceProperties{ .name = "Other" }), PTN_Exception);
+
+	ptnEngine.closeJournal();
+	ptnEngine.createPlace(PlaceProperties{ .name = "Other" });
+	EXPECT_THROW(ptnEngine.openJournal(options()), JournalException);
+}
+
+TEST_F(Journal_, recovery_stops_at_the_last_complete_record)
+{
+	const filesystem::path crashPath = m_path.string() + ".crash";
+	{
+		PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+		createPipeline(ptnEngine);
+		ptnEngine.openJournal(options());
+		ptnEngine.incrementInputPlace("Input");
+		ptnEngine.incrementInputPlace("Input");
+		ptnEngine.syncJournal();
+		filesystem::copy_file(m_path, crashPath, filesystem::copy_options::overwrite_existing);
+		ptnEngine.incrementInputPlace("Input");
+	}
+
+	// A record interrupted by the crash.
+	ofstream(crashPath, ios::binary | ios::app).put(2);
+
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createPipeline(ptnEngine);
+	EXPECT_EQ(2, ptnEngine.openJournal(JournalOptions{ .path = crashPath.string() }));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Input"));
+	ptnEngine.closeJournal();
+	filesystem::remove(crashPath);
+}
+
+TEST_F(Journal_, checkpoints_truncate_the_journal)
+{
+	{
+		PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+		createPipeline(ptnEngine);
+		ptnEngine.openJournal(options(10));
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			ptnEngine.incrementInputPlace("Input");
+			ptnEngine.step(10);
+		}
+		ptnEngine.syncJournal();
+		EXPECT_GT(100, filesystem::file_size(m_path));
+	}
+
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createPipeline(ptnEngine);
+	EXPECT_GT(10, ptnEngine.openJournal(options()));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Middle"));
+	EXPECT_EQ(500, ptnEngine.getNumberOfTokens("Output"));
+}
+
+TEST_F(Journal_, firings_of_the_event_loop_are_recorded)
+{
+	{
+		PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+		createPipeline(ptnEngine);
+		ptnEngine.openJournal(options(100));
+		ptnEngine.execute();
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			ptnEngine.incrementInputPlace("Input");
+		}
+		while (ptnEngine.getNumberOfTokens("Output") < 500)
+		{
+			this_thread::sleep_for(1ms);
+		}
+		ptnEngine.stop();
+	}
+
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createPipeline(ptnEngine);
+	ptnEngine.openJournal(options());
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Middle"));
+	EXPECT_EQ(500, ptnEngine.getNumberOfTokens("Output"));
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <set>
+
+using namespace std;
+using namespace ptne;
+
+TEST(MarkingHash_, the_hash_returns_to_its_value_when_the_marking_returns)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 3, 1);
+
+	const uint64_t initialHash = ptnEngine.getMarkingHash();
+	ptnEngine.step(1);
+	const uint64_t secondHash = ptnEngine.getMarkingHash();
+	EXPECT_NE(initialHash, secondHash);
+	ptnEngine.step(1);
+	EXPECT_NE(initialHash, ptnEngine.getMarkingHash());
+	EXPECT_NE(secondHash, ptnEngine.getMarkingHash());
+	ptnEngine.step(1);
+	EXPECT_EQ(initialHash, ptnEngine.getMarkingHash());
+}
+
+TEST(MarkingHash_, nets_with_the_same_marking_have_the_same_hash)
+{
+	PTN_Engine first(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	PTN_Engine second(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(first, 3, 4);
+	createRing(second, 3, 4);
+	EXPECT_EQ(first.getMarkingHash(), second.getMarkingHash());
+
+	first.step(2);
+	EXPECT_NE(first.getMarkingHash(), second.getMarkingHash());
+
+	second.restoreMarking(first.snapshotMarking());
+	EXPECT_EQ(first.getMarkingHash(), second.getMarkingHash());
+}
+
+TEST(MarkingHash_, empty_places_do_not_change_the_hash)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	EXPECT_EQ(0, ptnEngine.getMarkingHash());
+	createRing(ptnEngine, 3, 0);
+	EXPECT_EQ(0, ptnEngine.getMarkingHash());
+
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.incrementInputPlace("Input");
+	EXPECT_NE(0, ptnEngine.getMarkingHash());
+	ptnEngine.clearNet();
+	EXPECT_EQ(0, ptnEngine.getMarkingHash());
+}
+
+TEST(MarkingHash_, different_numbers_of_tokens_have_different_hashes)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+
+	set<uint64_t> hashes{ ptnEngine.getMarkingHash() };
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		ptnEngine.incrementInputPlace("Input");
+		hashes.insert(ptnEngine.getMarkingHash());
+	}
+	EXPECT_EQ(1001, hashes.size());
+}
+
+TEST(MarkingHash_, actions_can_read_the_hash)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	uint64_t hashInAction = 0;
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2",
+										   .onEnterAction = [&ptnEngine, &hashInAction]
+										   { hashInAction = ptnEngine.getMarkingHash(); } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+
+	EXPECT_NO_THROW(ptnEngine.step(1));
+	EXPECT_EQ(ptnEngine.getMarkingHash(), hashInAction);
+}
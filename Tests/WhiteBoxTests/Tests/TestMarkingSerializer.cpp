@@ -0,0 +1,135 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+TEST(MarkingSerializer_, restoreMarking_sets_back_the_marking_of_the_snapshot)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 2, 300);
+
+	const vector<uint8_t> snapshot = ptnEngine.snapshotMarking();
+	ptnEngine.step(7);
+	EXPECT_NE(300, ptnEngine.getNumberOfTokens("P1"));
+
+	ptnEngine.restoreMarking(snapshot);
+	EXPECT_EQ(300, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(snapshot, ptnEngine.snapshotMarking());
+}
+
+TEST(MarkingSerializer_, snapshots_can_be_restored_in_nets_with_the_same_structure)
+{
+	PTN_Engine source(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(source, 2, 5);
+	source.step(3);
+
+	PTN_Engine copy(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(copy, 2, 0);
+	copy.restoreMarking(source.snapshotMarking());
+	EXPECT_EQ(source.getNumberOfTokens("P1"), copy.getNumberOfTokens("P1"));
+	EXPECT_EQ(source.getNumberOfTokens("P2"), copy.getNumberOfTokens("P2"));
+}
+
+TEST(MarkingSerializer_, invalid_snapshots_throw_and_leave_the_marking_unchanged)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 2, 5);
+	const vector<uint8_t> snapshot = ptnEngine.snapshotMarking();
+	ptnEngine.step(1);
+
+	vector<uint8_t> truncated = snapshot;
+	truncated.pop_back();
+	EXPECT_THROW(ptnEngine.restoreMarking(truncated), InvalidSnapshotException);
+
+	vector<uint8_t> corrupted = snapshot;
+	corrupted[6] ^= 1;
+	EXPECT_THROW(ptnEngine.restoreMarking(corrupted), InvalidSnapshotException);
+
+	vector<uint8_t> extended = snapshot;
+	extended.push_back(0);
+	EXPECT_THROW(ptnEngine.restoreMarking(extended), InvalidSnapshotException);
+
+	PTN_Engine other(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(other, 2, 5);
+	other.addArc(ArcProperties{ .weight = 2, .placeName = "P2", .transitionName = "T1" });
+	EXPECT_THROW(ptnEngine.restoreMarking(other.snapshotMarking()), InvalidSnapshotException);
+
+	EXPECT_EQ(4, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P2"));
+}
+
+TEST(MarkingSerializer_, snapshots_taken_while_the_event_loop_runs_are_consistent)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	createRing(ptnEngine, 2, 100);
+	PTN_Engine copy(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(copy, 2, 0);
+
+	ptnEngine.execute();
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		copy.restoreMarking(ptnEngine.snapshotMarking());
+		ASSERT_EQ(100, copy.getNumberOfTokens("P1") + copy.getNumberOfTokens("P2"));
+	}
+
+	ptnEngine.restoreMarking(copy.snapshotMarking());
+	ptnEngine.stop();
+	EXPECT_EQ(100, ptnEngine.getNumberOfTokens("P1") + ptnEngine.getNumberOfTokens("P2"));
+}
+
+TEST(MarkingSerializer_, resetMarking_sets_back_the_initial_marking)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 2, 3);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 2, .input = true });
+	const uint64_t initialHash = ptnEngine.getMarkingHash();
+
+	for (size_t job = 0; job < 3; ++job)
+	{
+		ptnEngine.incrementInputPlace("Input");
+		ptnEngine.step(1);
+		EXPECT_NE(3, ptnEngine.getNumberOfTokens("P1"));
+
+		ptnEngine.resetMarking();
+		EXPECT_EQ(3, ptnEngine.getNumberOfTokens("P1"));
+		EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+		EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Input"));
+		EXPECT_EQ(initialHash, ptnEngine.getMarkingHash());
+	}
+}
+
+TEST(MarkingSerializer_, resetMarking_uses_the_initial_tokens_of_places_added_later)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 2, 1);
+	ptnEngine.step(1);
+
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3", .initialNumberOfTokens = 4, .input = true });
+	ptnEngine.incrementInputPlace("P3");
+	ptnEngine.resetMarking();
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(4, ptnEngine.getNumberOfTokens("P3"));
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/MarkingStore.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std;
+using namespace ptne;
+
+TEST(MarkingStore_, inserted_markings_are_stored_once)
+{
+	MarkingStore store(3, 1 << 20);
+	MarkingStore::Writer writer;
+
+	MarkingStore::Reference first = 0;
+	EXPECT_EQ(MarkingStore::InsertStatus::INSERTED, store.insert({ 1, 0, 300 }, writer, first));
+	MarkingStore::Reference second = 0;
+	EXPECT_EQ(MarkingStore::InsertStatus::INSERTED, store.insert({ 0, 1, 300 }, writer, second));
+	MarkingStore::Reference again = 0;
+	EXPECT_EQ(MarkingStore::InsertStatus::ALREADY_STORED, store.insert({ 1, 0, 300 }, writer, again));
+	EXPECT_EQ(first, again);
+	EXPECT_EQ(2, store.size());
+
+	CompiledNet::Marking marking;
+	store.get(second, marking);
+	EXPECT_EQ((CompiledNet::Marking{ 0, 1, 300 }), marking);
+	store.get(first, marking);
+	EXPECT_EQ((CompiledNet::Marking{ 1, 0, 300 }), marking);
+}
+
+TEST(MarkingStore_, insertions_fail_once_the_store_is_full)
+{
+	MarkingStore store(1, 1 << 20, 10);
+	MarkingStore::Writer writer;
+	MarkingStore::Reference reference = 0;
+	for (size_t i = 0; i < 10; ++i)
+	{
+		EXPECT_EQ(MarkingStore::InsertStatus::INSERTED, store.insert({ i }, writer, reference));
+	}
+	EXPECT_EQ(MarkingStore::InsertStatus::FULL, store.insert({ 10 }, writer, reference));
+	EXPECT_EQ(MarkingStore::InsertStatus::ALREADY_STORED, store.insert({ 3 }, writer, reference));
+	EXPECT_EQ(10, store.size());
+
+	EXPECT_THROW(MarkingStore(1, 8), PTN_Exception);
+}
+
+TEST(MarkingStore_, concurrent_insertions_store_each_marking_once)
+{
+	constexpr size_t numberOfThreads = 4;
+	constexpr size_t numberOfMarkings = 20000;
+	MarkingStore store(2, 16 << 20);
+	vector<size_t> inserted(numberOfThreads, 0);
+	{
+		vector<jthread> threads;
+		for (size_t thread = 0; thread < numberOfThreads; ++thread)
+		{
+			threads.emplace_back(
+			[&store, &inserted, thread]
+			{
+				MarkingStore::Writer writer;
+				MarkingStore::Reference reference = 0;
+				// All threads insert the same markings, in different orders.
+				for (size_t i = 0; i < numberOfMarkings; ++i)
+				{
+					const size_t value = (i * (2 * thread + 1)) % numberOfMarkings;
+					if (store.insert({ value, value * 7 }, writer, reference) == MarkingStore::InsertStatus::INSERTED)
+					{
+						++inserted[thread];
+					}
+				}
+			});
+		}
+	}
+
+	EXPECT_EQ(numberOfMarkings, store.size());
+	EXPECT_EQ(numberOfMarkings, inserted[0] + inserted[1] + inserted[2] + inserted[3]);
+
+	MarkingStore::Writer writer;
+	MarkingStore::Reference reference = 0;
+	CompiledNet::Marking marking;
+	for (size_t value = 0; value < numberOfMarkings; value += 997)
+	{
+		ASSERT_EQ(MarkingStore::InsertStatus::ALREADY_STORED, store.insert({ value, value * 7 }, writer, reference));
+		store.get(reference, marking);
+		EXPECT_EQ((CompiledNet::Marking{ value, value * 7 }), marking);
+	}
+}
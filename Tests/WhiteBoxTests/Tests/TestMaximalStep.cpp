@@ -0,0 +1,180 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Transition T<i> moving the token of place In<i> to place Out<i>, for each input place.
+void createMovingTransitions(PTN_Engine &ptnEngine, const size_t numberOfTransitions, const bool input = false)
+{
+	for (size_t i = 0; i < numberOfTransitions; ++i)
+	{
+		const string suffix = to_string(i);
+		ptnEngine.createPlace(PlaceProperties{ .name = "In" + suffix, .initialNumberOfTokens = 1, .input = input });
+		ptnEngine.createPlace(PlaceProperties{ .name = "Out" + suffix });
+		ptnEngine.createTransition(
+		TransitionProperties{ .name = "T" + suffix,
+							  .activationArcs = { ArcProperties{ .placeName = "In" + suffix } },
+							  .destinationArcs = { ArcProperties{ .placeName = "Out" + suffix } } });
+	}
+}
+} // namespace
+
+TEST(MaximalStep_, firing_semantics_is_interleaving_by_default_and_cannot_change_while_running)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	EXPECT_EQ(PTN_Engine::FIRING_SEMANTICS::INTERLEAVING, ptnEngine.getFiringSemantics());
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	EXPECT_EQ(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP, ptnEngine.getFiringSemantics());
+
+	ptnEngine.execute();
+	EXPECT_THROW(ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::INTERLEAVING), PTN_Exception);
+	ptnEngine.stop();
+	EXPECT_EQ(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP, ptnEngine.getFiringSemantics());
+}
+
+TEST(MaximalStep_, independent_transitions_fire_in_the_same_step)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	createMovingTransitions(ptnEngine, 5);
+
+	const StepResult result = ptnEngine.step(1);
+	EXPECT_EQ(5, result.firedTransitions);
+	EXPECT_FALSE(result.workRemaining);
+	for (size_t i = 0; i < 5; ++i)
+	{
+		EXPECT_EQ(0, ptnEngine.getNumberOfTokens("In" + to_string(i)));
+		EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Out" + to_string(i)));
+	}
+}
+
+TEST(MaximalStep_, transitions_competing_for_tokens_fire_as_many_as_the_tokens_allow)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Shared", .initialNumberOfTokens = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	for (const string name : { "T1", "T2", "T3" })
+	{
+		ptnEngine.createTransition(
+		TransitionProperties{ .name = name,
+							  .activationArcs = { ArcProperties{ .placeName = "Shared" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+	}
+
+	EXPECT_EQ(2, ptnEngine.step(1).firedTransitions);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Shared"));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Output"));
+}
+
+TEST(MaximalStep_, transitions_reading_a_token_fire_in_the_same_step)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	createMovingTransitions(ptnEngine, 2);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Flag", .initialNumberOfTokens = 1 });
+	ptnEngine.addArc(ArcProperties{ .placeName = "Flag", .transitionName = "T0", .type = ArcProperties::Type::READ });
+	ptnEngine.addArc(ArcProperties{ .placeName = "Flag", .transitionName = "T1", .type = ArcProperties::Type::READ });
+
+	EXPECT_EQ(2, ptnEngine.step(1).firedTransitions);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Flag"));
+}
+
+TEST(MaximalStep_, transitions_disabling_each_other_with_an_inhibitor_arc_do_not_fire_in_the_same_step)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	createMovingTransitions(ptnEngine, 2);
+	ptnEngine.addArc(
+	ArcProperties{ .placeName = "Out0", .transitionName = "T1", .type = ArcProperties::Type::INHIBITOR });
+
+	const StepResult result = ptnEngine.step(1);
+	EXPECT_EQ(1, result.firedTransitions);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Out0") + ptnEngine.getNumberOfTokens("Out1"));
+}
+
+TEST(MaximalStep_, transitions_exceeding_a_capacity_together_do_not_fire_in_the_same_step)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Bounded", .capacity = 2 });
+	createMovingTransitions(ptnEngine, 3);
+	for (const string name : { "T0", "T1", "T2" })
+	{
+		ptnEngine.addArc(
+		ArcProperties{ .placeName = "Bounded", .transitionName = name, .type = ArcProperties::Type::DESTINATION });
+	}
+
+	EXPECT_EQ(2, ptnEngine.step(1).firedTransitions);
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Bounded"));
+}
+
+TEST(MaximalStep_, the_event_loop_fires_maximal_steps)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	createMovingTransitions(ptnEngine, 3, true);
+
+	ptnEngine.execute();
+	for (size_t i = 0; i < 3; ++i)
+	{
+		ptnEngine.incrementInputPlace("In" + to_string(i));
+	}
+	this_thread::sleep_for(100ms);
+	ptnEngine.stop();
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ(0, ptnEngine.getNumberOfTokens("In" + to_string(i)));
+		EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Out" + to_string(i)));
+	}
+}
+
+TEST(MaximalStep_, transitions_whose_conditions_do_not_hold_do_not_take_the_tokens_of_the_step)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setFiringSemantics(PTN_Engine::FIRING_SEMANTICS::MAXIMAL_STEP);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Shared", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	// Whatever the order in which the step is chosen, the blocked transitions must not exclude T0.
+	for (const string name : { "T1", "T2", "T3", "T4" })
+	{
+		ptnEngine.createTransition(TransitionProperties{ .name = name,
+														 .activationArcs = { ArcProperties{ .placeName = "Shared" } },
+														 .additionalConditions = { [] { return false; } } });
+	}
+	ptnEngine.createTransition(TransitionProperties{ .name = "T0",
+													 .activationArcs = { ArcProperties{ .placeName = "Shared" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+
+	for (size_t i = 0; i < 20; ++i)
+	{
+		ptnEngine.resetMarking();
+		EXPECT_EQ(1, ptnEngine.step(1).firedTransitions);
+		EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Output"));
+	}
+}
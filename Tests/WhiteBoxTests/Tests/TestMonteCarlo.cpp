@@ -0,0 +1,170 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/MonteCarlo.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+void createConflict(PTN_Engine &ptnEngine)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "A" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "B" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "A" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "B" } } });
+}
+} // namespace
+
+TEST(MonteCarlo_, conflicts_are_resolved_randomly_in_each_replication)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createConflict(ptnEngine);
+
+	const MonteCarloResult result = runMonteCarlo(
+	ptnEngine, MonteCarloOptions{ .replications = 2000, .seed = 7, .targetMarkings = { { { "A", 1 } }, { { "B", 1 } } } });
+
+	EXPECT_EQ(2000, result.replications);
+	EXPECT_NEAR(0.5, result.meanFiringsPerTransition.at("T1"), 0.05);
+	EXPECT_DOUBLE_EQ(1.0, result.meanFiringsPerTransition.at("T1") + result.meanFiringsPerTransition.at("T2"));
+	ASSERT_EQ(2, result.targetMarkings.size());
+	EXPECT_EQ(2000, result.targetMarkings[0].replicationsReached + result.targetMarkings[1].replicationsReached);
+	EXPECT_DOUBLE_EQ(1.0, result.targetMarkings[0].meanFiringsToReach);
+	EXPECT_EQ(1, result.places.at("A").maxTokens);
+	EXPECT_EQ(1, result.places.at("P1").maxTokens);
+
+	// The net itself is not changed.
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("A"));
+}
+
+TEST(MonteCarlo_, results_do_not_depend_on_the_number_of_threads)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createConflict(ptnEngine);
+	ptnEngine.createTransition(TransitionProperties{ .name = "T3",
+													 .activationArcs = { ArcProperties{ .placeName = "A" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T4",
+													 .activationArcs = { ArcProperties{ .placeName = "B" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	MonteCarloOptions options{
+		.replications = 500,
+		.seed = 42,
+		.duration = SimulationTime(100.0),
+		.delays = { { "T1", DelayDistribution{ .type = DelayDistribution::Type::EXPONENTIAL, .mean = SimulationTime(2.0) } },
+					{ "T2", DelayDistribution{ .type = DelayDistribution::Type::EXPONENTIAL, .mean = SimulationTime(3.0) } },
+					{ "T3", DelayDistribution{ .type = DelayDistribution::Type::UNIFORM,
+											   .minimum = SimulationTime(1.0),
+											   .maximum = SimulationTime(5.0) } },
+					{ "T4", DelayDistribution{ .minimum = SimulationTime(1.0) } } },
+		.targetMarkings = { { { "B", 1 } } }
+	};
+
+	options.numberOfThreads = 1;
+	const MonteCarloResult singleThreadResult = runMonteCarlo(ptnEngine, options);
+	options.numberOfThreads = 4;
+	const MonteCarloResult multiThreadResult = runMonteCarlo(ptnEngine, options);
+
+	EXPECT_EQ(singleThreadResult.meanFiringsPerTransition, multiThreadResult.meanFiringsPerTransition);
+	EXPECT_EQ(singleThreadResult.meanEndTime, multiThreadResult.meanEndTime);
+	EXPECT_EQ(SimulationTime(100.0), singleThreadResult.meanEndTime);
+	for (const auto &[name, placeStatistics] : singleThreadResult.places)
+	{
+		EXPECT_EQ(placeStatistics.meanOccupancy, multiThreadResult.places.at(name).meanOccupancy);
+		EXPECT_EQ(placeStatistics.maxTokens, multiThreadResult.places.at(name).maxTokens);
+	}
+	EXPECT_EQ(singleThreadResult.targetMarkings[0].meanTimeToReach, multiThreadResult.targetMarkings[0].meanTimeToReach);
+
+	options.seed = 43;
+	EXPECT_NE(singleThreadResult.meanFiringsPerTransition, runMonteCarlo(ptnEngine, options).meanFiringsPerTransition);
+}
+
+TEST(MonteCarlo_, occupancy_is_weighted_by_virtual_time)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .weight = 2, .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } },
+													 .minimumDelay = 10ms });
+
+	const MonteCarloResult result =
+	runMonteCarlo(ptnEngine,
+				  MonteCarloOptions{ .replications = 10,
+									 .duration = SimulationTime(40.0),
+									 .targetMarkings = { { { "Output", 1 } } } });
+
+	EXPECT_DOUBLE_EQ(0.5, result.places.at("Input").meanOccupancy);
+	EXPECT_DOUBLE_EQ(0.75, result.places.at("Output").meanOccupancy);
+	EXPECT_EQ(2, result.places.at("Input").maxTokens);
+	EXPECT_EQ(SimulationTime(40.0), result.meanEndTime);
+	EXPECT_EQ(10, result.targetMarkings[0].replicationsReached);
+	EXPECT_EQ(SimulationTime(10.0), result.targetMarkings[0].meanTimeToReach);
+}
+
+TEST(MonteCarlo_, without_delays_occupancy_is_averaged_over_the_visited_markings)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 3 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .additionalConditions = { [] { return false; } } });
+
+	const MonteCarloResult result = runMonteCarlo(ptnEngine, MonteCarloOptions{ .replications = 3 });
+
+	// Additional conditions are not part of the token game. The visited markings are 3, 2, 1 and 0 tokens.
+	EXPECT_DOUBLE_EQ(3.0, result.meanFiringsPerTransition.at("T1"));
+	EXPECT_DOUBLE_EQ(1.5, result.places.at("P1").meanOccupancy);
+	EXPECT_DOUBLE_EQ(1.5, result.places.at("P2").meanOccupancy);
+	EXPECT_EQ(SimulationTime::zero(), result.meanEndTime);
+}
+
+TEST(MonteCarlo_, max_firings_bounds_each_replication)
+{
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 } };
+	const vector<TransitionProperties> transitions{ TransitionProperties{
+	.name = "T1",
+	.activationArcs = { ArcProperties{ .placeName = "P1" } },
+	.destinationArcs = { ArcProperties{ .placeName = "P1" } } } };
+
+	const MonteCarloResult result =
+	runMonteCarlo(places, transitions, MonteCarloOptions{ .replications = 100, .maxFirings = 25 });
+	EXPECT_DOUBLE_EQ(25.0, result.meanFiringsPerTransition.at("T1"));
+}
+
+TEST(MonteCarlo_, unknown_places_in_target_markings_throw)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createConflict(ptnEngine);
+	EXPECT_THROW(runMonteCarlo(ptnEngine, MonteCarloOptions{ .targetMarkings = { { { "C", 1 } } } }),
+				 InvalidNameException);
+}
@@ -0,0 +1,151 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/NetReducer.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Chain of action-less places and transitions from an input place to a place with an action.
+void createChain(PTN_Engine &ptnEngine, const size_t length, const ActionFunction &onEnterOutput)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output", .onEnterAction = onEnterOutput });
+	for (size_t i = 0; i < length; ++i)
+	{
+		ptnEngine.createPlace(PlaceProperties{ .name = "C" + to_string(i) });
+	}
+	for (size_t i = 0; i <= length; ++i)
+	{
+		const string from = i == 0 ? "Input" : "C" + to_string(i - 1);
+		const string to = i == length ? "Output" : "C" + to_string(i);
+		ptnEngine.createTransition(TransitionProperties{ .name = "T" + to_string(i),
+														 .activationArcs = { ArcProperties{ .placeName = from } },
+														 .destinationArcs = { ArcProperties{ .placeName = to } } });
+	}
+}
+} // namespace
+
+TEST(NetReducer_, serial_chains_are_fused)
+{
+	size_t outputs = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createChain(ptnEngine, 10, [&outputs] { ++outputs; });
+
+	const NetReductionResult result = ptnEngine.reduceNet();
+	EXPECT_EQ(10, result.removedPlaces.size());
+	EXPECT_EQ(10, result.removedTransitions.size());
+	EXPECT_EQ(2, ptnEngine.getPlacesProperties().size());
+	const vector<TransitionProperties> transitions = ptnEngine.getTransitionsProperties();
+	ASSERT_EQ(1, transitions.size());
+	EXPECT_EQ("T0", transitions[0].name);
+	ASSERT_EQ(1, transitions[0].destinationArcs.size());
+	EXPECT_EQ("Output", transitions[0].destinationArcs[0].placeName);
+	EXPECT_THROW(ptnEngine.getNumberOfTokens("C3"), InvalidNameException);
+
+	ptnEngine.incrementInputPlace("Input");
+	const StepResult stepResult = ptnEngine.step(100);
+	EXPECT_EQ(1, stepResult.firedTransitions);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Output"));
+	EXPECT_EQ(1, outputs);
+}
+
+TEST(NetReducer_, observable_places_and_transitions_are_kept)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .onExitAction = [] {} });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P4" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T3",
+													 .activationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .additionalConditions = { [] { return true; } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T4",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .inhibitorArcs = { ArcProperties{ .placeName = "P4" } } });
+
+	const NetReductionResult result = ptnEngine.reduceNet();
+	EXPECT_TRUE(result.removedPlaces.empty());
+	EXPECT_TRUE(result.removedTransitions.empty());
+	EXPECT_EQ(4, ptnEngine.getTransitionsProperties().size());
+}
+
+TEST(NetReducer_, redundant_places_and_idle_transitions_are_removed)
+{
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "A", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "B" },
+										  PlaceProperties{ .name = "Duplicate", .initialNumberOfTokens = 2 },
+										  PlaceProperties{ .name = "Log" },
+										  PlaceProperties{ .name = "Resource", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "Watched", .onEnterActionFunctionName = "f" } };
+	const vector<TransitionProperties> transitions{
+		TransitionProperties{ .name = "Forward",
+							  .activationArcs = { ArcProperties{ .placeName = "A" },
+												  ArcProperties{ .placeName = "Duplicate" },
+												  ArcProperties{ .placeName = "Resource" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "B" },
+												   ArcProperties{ .placeName = "Log" },
+												   ArcProperties{ .placeName = "Resource" },
+												   ArcProperties{ .placeName = "Watched" } },
+							  .additionalConditionsNames = { "c" } },
+		TransitionProperties{ .name = "Backward",
+							  .activationArcs = { ArcProperties{ .placeName = "B" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "A" },
+												   ArcProperties{ .placeName = "Duplicate" } },
+							  .requireNoActionsInExecution = true },
+		TransitionProperties{ .name = "Idle",
+							  .activationArcs = { ArcProperties{ .placeName = "A" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "A" } } }
+	};
+
+	NetReducer reducer(places, transitions);
+	const NetReductionResult result = reducer.reduce();
+	EXPECT_EQ((vector<string>{ "Duplicate", "Log", "Resource" }), result.removedPlaces);
+	EXPECT_EQ(vector<string>{ "Idle" }, result.removedTransitions);
+
+	const vector<TransitionProperties> reducedTransitions = reducer.getTransitionsProperties();
+	ASSERT_EQ(2, reducedTransitions.size());
+	EXPECT_EQ("Backward", reducedTransitions[0].name);
+	EXPECT_EQ(1, reducedTransitions[0].destinationArcs.size());
+	EXPECT_EQ("Forward", reducedTransitions[1].name);
+	EXPECT_EQ(1, reducedTransitions[1].activationArcs.size());
+	EXPECT_EQ(2, reducedTransitions[1].destinationArcs.size());
+}
+
+TEST(NetReducer_, reduceNet_throws_while_the_event_loop_is_running)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	createChain(ptnEngine, 2, [] {});
+	ptnEngine.execute();
+	EXPECT_THROW(ptnEngine.reduceNet(), PTN_Exception);
+	ptnEngine.stop();
+	EXPECT_EQ(2, ptnEngine.reduceNet().removedPlaces.size());
+}
@@ -21,6 +21,10 @@
 #include "PTN_Engine/Transition.h"
 #include <gtest/gtest.h>
 
+#ifdef __linux__
+#include <poll.h>
+#endif
+
 using namespace std;
 using namespace ptne;
 
@@ -36,6 +40,33 @@ public:
 	PTN_Engine ptnEngine = PTN_Engine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
 };
 
+#ifdef __linux__
+class PTN_Engine_ExternalLoop : public testing::Test
+{
+public:
+	void SetUp() override
+	{
+		ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+		ptnEngine.createPlace(PlaceProperties{ .name = "P1" });
+		ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+		ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+														 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+														 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+		ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+														 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+														 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	}
+
+	bool isEventFileDescriptorReadable() const
+	{
+		pollfd pollFileDescriptor{ .fd = ptnEngine.getEventFileDescriptor(), .events = POLLIN, .revents = 0 };
+		return ::poll(&pollFileDescriptor, 1, 0) == 1 && (pollFileDescriptor.revents & POLLIN) != 0;
+	}
+
+	PTN_Engine ptnEngine = PTN_Engine(PTN_Engine::ACTIONS_THREAD_OPTION::EXTERNAL_LOOP);
+};
+#endif
+
 TEST(PTN_Engine_, constructors_do_not_throw)
 {
 	ASSERT_NO_THROW(PTN_Engine{ PTN_Engine::ACTIONS_THREAD_OPTION::DETACHED });
@@ -425,3 +456,157 @@ TEST_F(PTN_Engine_JobQueue, stops_the_petri_net_execution_and_never_throws)
 	ASSERT_NO_THROW(ptnEngine.stop());
 	ASSERT_NO_THROW(ptnEngine.stop());
 }
+
+#ifdef __linux__
+TEST_F(PTN_Engine_ExternalLoop, event_file_descriptor_is_readable_while_there_is_pending_work)
+{
+	EXPECT_FALSE(isEventFileDescriptorReadable());
+	EXPECT_THROW(ptnEngine.poll(), PTN_Exception);
+
+	ptnEngine.execute();
+	EXPECT_TRUE(ptnEngine.isEventLoopRunning());
+	EXPECT_TRUE(isEventFileDescriptorReadable());
+	EXPECT_EQ(0, ptnEngine.poll());
+	EXPECT_FALSE(isEventFileDescriptorReadable());
+
+	ptnEngine.incrementInputPlace("Input");
+	EXPECT_TRUE(isEventFileDescriptorReadable());
+	EXPECT_EQ(2, ptnEngine.poll());
+	EXPECT_FALSE(isEventFileDescriptorReadable());
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P2"));
+
+	ptnEngine.stop();
+	EXPECT_FALSE(ptnEngine.isEventLoopRunning());
+	EXPECT_THROW(ptnEngine.poll(), PTN_Exception);
+}
+
+TEST_F(PTN_Engine_ExternalLoop, poll_fires_at_most_maxSteps_transitions)
+{
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace("Input");
+
+	EXPECT_EQ(1, ptnEngine.poll(1));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_TRUE(isEventFileDescriptorReadable());
+
+	EXPECT_EQ(1, ptnEngine.poll(1));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_FALSE(isEventFileDescriptorReadable());
+}
+#endif
+
+TEST(PTN_Engine_, getEventFileDescriptor_and_poll_throw_if_not_in_EXTERNAL_LOOP_mode)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	EXPECT_THROW(ptnEngine.getEventFileDescriptor(), PTN_Exception);
+	EXPECT_THROW(ptnEngine.poll(), PTN_Exception);
+}
+
+TEST(PTN_Engine_, step_fires_at_most_maxFirings_transitions)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 3 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+
+	StepResult result = ptnEngine.step();
+	EXPECT_EQ(1, result.firedTransitions);
+	EXPECT_TRUE(result.workRemaining);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P2"));
+
+	result = ptnEngine.step(5);
+	EXPECT_EQ(2, result.firedTransitions);
+	EXPECT_FALSE(result.workRemaining);
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens("P2"));
+
+	result = ptnEngine.step(0);
+	EXPECT_EQ(0, result.firedTransitions);
+	EXPECT_FALSE(result.workRemaining);
+}
+
+TEST(PTN_Engine_, runFor_returns_when_the_time_budget_is_spent)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	const auto start = chrono::steady_clock::now();
+	const StepResult result = ptnEngine.runFor(5ms);
+	EXPECT_LT(chrono::steady_clock::now() - start, 1s);
+	EXPECT_LT(0, result.firedTransitions);
+	EXPECT_TRUE(result.workRemaining);
+}
+
+TEST(PTN_Engine_, fireTransition_fires_the_given_transition_if_it_is_enabled)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .minimumDelay = 1h });
+
+	// The firing window is not checked.
+	EXPECT_TRUE(ptnEngine.fireTransition("T2"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P3"));
+	EXPECT_FALSE(ptnEngine.fireTransition("T1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_THROW(ptnEngine.fireTransition("T3"), InvalidNameException);
+}
+
+TEST_F(PTN_Engine_EventLoop, step_runFor_and_fireTransition_throw_while_the_event_loop_is_running)
+{
+	ptnEngine.execute();
+	EXPECT_THROW(ptnEngine.step(), PTN_Exception);
+	EXPECT_THROW(ptnEngine.runFor(1ms), PTN_Exception);
+	EXPECT_THROW(ptnEngine.fireTransition("T1"), PTN_Exception);
+	ptnEngine.stop();
+	EXPECT_NO_THROW(ptnEngine.step());
+}
+
+TEST_F(PTN_Engine_EventLoop, timed_transition_fires_after_its_delay_without_waiting_for_the_sleep_duration)
+{
+	ptnEngine.setEventLoopSleepDuration(10s);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Timeout" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Timeout" } },
+													 .minimumDelay = 50ms });
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace("Input");
+
+	this_thread::sleep_for(20ms);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Timeout"));
+	this_thread::sleep_for(300ms);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Timeout"));
+	ptnEngine.stop();
+}
+
+TEST(PTN_Engine_, timed_transition_cannot_fire_after_its_deadline)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	bool allowFiring = false;
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .additionalConditions = { [&allowFiring] { return allowFiring; } },
+													 .maximumDelay = 20ms });
+
+	EXPECT_EQ(0, ptnEngine.step().firedTransitions);
+	this_thread::sleep_for(40ms);
+	allowFiring = true;
+	EXPECT_EQ(0, ptnEngine.step().firedTransitions);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+}
@@ -0,0 +1,230 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/Analysis/Coverability.h"
+#include "PTN_Engine/Analysis/Reachability.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Input place with the given capacity, consumed by T1 into Output.
+void createBoundedInputNet(PTN_Engine &ptnEngine, const size_t capacity)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true, .capacity = capacity });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+}
+} // namespace
+
+TEST(PlaceCapacities_, initial_tokens_above_the_capacity_throw)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	EXPECT_THROW(ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 3, .capacity = 2 }),
+				 PlaceCapacityException);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .initialNumberOfTokens = 2, .capacity = 2 });
+	EXPECT_EQ(2, ptnEngine.getPlacesProperties().front().capacity);
+}
+
+TEST(PlaceCapacities_, a_full_destination_place_disables_the_transition)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 5 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Buffer", .capacity = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Gate", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "Produce",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Buffer" } } });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "Consume",
+						  .activationArcs = { ArcProperties{ .placeName = "Buffer" },
+											  ArcProperties{ .placeName = "Gate" } },
+						  .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+
+	EXPECT_EQ(2, ptnEngine.step(10).firedTransitions);
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Buffer"));
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens("Input"));
+
+	ptnEngine.incrementInputPlace("Gate");
+	EXPECT_EQ(2, ptnEngine.step(10).firedTransitions);
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Buffer"));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Output"));
+}
+
+TEST(PlaceCapacities_, a_transition_taking_from_a_full_place_can_give_tokens_back)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Full", .initialNumberOfTokens = 2, .capacity = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Counter" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Full" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Full" },
+																		  ArcProperties{ .placeName = "Counter" } } });
+
+	EXPECT_EQ(3, ptnEngine.step(3).firedTransitions);
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Full"));
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens("Counter"));
+}
+
+TEST(PlaceCapacities_, full_input_places_throw_or_drop_the_token)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createBoundedInputNet(ptnEngine, 2);
+
+	ptnEngine.incrementInputPlace("Input");
+	EXPECT_TRUE(ptnEngine.tryIncrementInputPlace("Input"));
+	EXPECT_FALSE(ptnEngine.tryIncrementInputPlace("Input"));
+	EXPECT_FALSE(ptnEngine.incrementInputPlace("Input", PTN_Engine::FULL_PLACE_POLICY::DROP));
+	EXPECT_THROW(ptnEngine.incrementInputPlace("Input"), PlaceCapacityException);
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Input"));
+
+	EXPECT_EQ(1, ptnEngine.step().firedTransitions);
+	EXPECT_TRUE(ptnEngine.tryIncrementInputPlace("Input"));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Input"));
+}
+
+TEST(PlaceCapacities_, blocking_on_a_full_input_place_times_out)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createBoundedInputNet(ptnEngine, 1);
+	ptnEngine.incrementInputPlace("Input");
+
+	const auto start = chrono::steady_clock::now();
+	EXPECT_FALSE(ptnEngine.incrementInputPlace("Input", PTN_Engine::FULL_PLACE_POLICY::BLOCK, 20ms));
+	EXPECT_GE(chrono::steady_clock::now() - start, 20ms);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Input"));
+}
+
+TEST(PlaceCapacities_, blocking_producers_are_paced_by_the_event_loop)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	createBoundedInputNet(ptnEngine, 1);
+	ptnEngine.execute();
+
+	for (size_t i = 0; i < 20; ++i)
+	{
+		EXPECT_TRUE(ptnEngine.incrementInputPlace("Input", PTN_Engine::FULL_PLACE_POLICY::BLOCK, 5s));
+		EXPECT_LE(ptnEngine.getNumberOfTokens("Input"), 1);
+	}
+	this_thread::sleep_for(50ms);
+	ptnEngine.stop();
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(20, ptnEngine.getNumberOfTokens("Output"));
+}
+
+TEST(PlaceCapacities_, producers_do_not_deadlock_with_actions_calling_the_engine)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	atomic<size_t> actions = 0;
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true, .capacity = 5 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output",
+										   .onEnterAction =
+										   [&ptnEngine, &actions]
+										   {
+											   this_thread::sleep_for(1ms);
+											   ptnEngine.getNumberOfTokens("Input");
+											   ++actions;
+										   } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+	ptnEngine.execute();
+
+	// Only this thread adds tokens, so the place has room once it was seen with room.
+	for (size_t i = 0; i < 20; ++i)
+	{
+		while (ptnEngine.getNumberOfTokens("Input") == 5)
+		{
+			this_thread::sleep_for(1ms);
+		}
+		ptnEngine.incrementInputPlace("Input");
+	}
+	this_thread::sleep_for(200ms);
+	ptnEngine.stop();
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(20, ptnEngine.getNumberOfTokens("Output"));
+	EXPECT_EQ(20, actions);
+}
+
+TEST(PlaceCapacities_, analyses_respect_the_capacities)
+{
+	// Produce leaks tokens into P2, which is bounded by its capacity.
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "P2", .capacity = 3 },
+										  PlaceProperties{ .name = "P3" } };
+	const vector<TransitionProperties> transitions{
+		TransitionProperties{ .name = "Produce",
+							  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P1" }, ArcProperties{ .placeName = "P2" } } },
+		TransitionProperties{ .name = "Stop",
+							  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P3" } } }
+	};
+
+	const ReachabilityResult reachability = exploreReachability(places, transitions);
+	EXPECT_TRUE(reachability.complete);
+	EXPECT_EQ(8, reachability.numberOfMarkings);
+	EXPECT_EQ(3, reachability.placeBounds.at("P2"));
+
+	const CoverabilityResult coverability = exploreCoverability(places, transitions);
+	EXPECT_TRUE(coverability.complete);
+	EXPECT_TRUE(coverability.unboundedPlaces.empty());
+	EXPECT_EQ(3, coverability.placeBounds.at("P2"));
+}
+
+TEST(PlaceCapacities_, coverability_does_not_prune_markings_with_fewer_tokens_in_a_full_place)
+{
+	// Y and W fill P only if P is empty, which needs T2 instead of T1.
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "P", .capacity = 2 },
+										  PlaceProperties{ .name = "X", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "Y", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "W" } };
+	const vector<TransitionProperties> transitions{
+		TransitionProperties{ .name = "T1",
+							  .activationArcs = { ArcProperties{ .placeName = "X" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P" }, ArcProperties{ .placeName = "W" } } },
+		TransitionProperties{ .name = "T2",
+							  .activationArcs = { ArcProperties{ .placeName = "X" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "W" } } },
+		TransitionProperties{ .name = "T3",
+							  .activationArcs = { ArcProperties{ .placeName = "Y" }, ArcProperties{ .placeName = "W" } },
+							  .destinationArcs = { ArcProperties{ .weight = 2, .placeName = "P" } } }
+	};
+
+	const ReachabilityResult reachability = exploreReachability(places, transitions);
+	EXPECT_TRUE(reachability.complete);
+	EXPECT_EQ(2, reachability.placeBounds.at("P"));
+
+	const CoverabilityResult coverability =
+	exploreCoverability(places, transitions, CoverabilityOptions{ .targetMarkings = { { { "P", 2 } } } });
+	EXPECT_TRUE(coverability.complete);
+	EXPECT_EQ(2, coverability.placeBounds.at("P"));
+	ASSERT_EQ(1, coverability.coverableTargetMarkings.size());
+	EXPECT_TRUE(coverability.coverableTargetMarkings[0]);
+}
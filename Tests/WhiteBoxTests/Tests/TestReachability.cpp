@@ -0,0 +1,164 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+#include "PTN_Engine/Analysis/Reachability.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+TEST(Reachability_, explores_all_reachable_markings)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createMutualExclusion(ptnEngine);
+
+	const ReachabilityResult result = exploreReachability(ptnEngine);
+	EXPECT_TRUE(result.complete);
+	EXPECT_EQ(3, result.numberOfMarkings);
+	EXPECT_EQ(4, result.numberOfEdges);
+	EXPECT_EQ(0, result.numberOfDeadlocks);
+	EXPECT_TRUE(result.deadTransitions.empty());
+	for (const auto &[name, bound] : result.placeBounds)
+	{
+		EXPECT_EQ(1, bound) << name;
+	}
+}
+
+TEST(Reachability_, reports_deadlocks_and_dead_transitions)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T3",
+													 .activationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .inhibitorArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	const ReachabilityResult result = exploreReachability(ptnEngine);
+	EXPECT_TRUE(result.complete);
+	EXPECT_EQ(0, result.numberOfDeadlocks);
+
+	ptnEngine.createPlace(PlaceProperties{ .name = "P4" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T4",
+													 .activationArcs = { ArcProperties{ .placeName = "P4" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T5",
+													 .activationArcs = { ArcProperties{ .weight = 2, .placeName = "P3" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P4" } },
+													 .inhibitorArcs = { ArcProperties{ .placeName = "P1" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T6",
+													 .activationArcs = { ArcProperties{ .weight = 3, .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P4" } } });
+
+	const ReachabilityResult deadlockResult = exploreReachability(ptnEngine);
+	EXPECT_TRUE(deadlockResult.complete);
+	EXPECT_EQ(vector<string>{ "T6" }, deadlockResult.deadTransitions);
+	EXPECT_EQ(2, deadlockResult.placeBounds.at("P1"));
+	EXPECT_EQ(2, deadlockResult.placeBounds.at("P3"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P4"));
+}
+
+TEST(Reachability_, deadlock_markings_are_reported)
+{
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "P2" },
+										  PlaceProperties{ .name = "P3" } };
+	const vector<TransitionProperties> transitions{
+		TransitionProperties{ .name = "T1",
+							  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P2" } } },
+		TransitionProperties{ .name = "T2",
+							  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+							  .destinationArcs = { ArcProperties{ .placeName = "P3" } } }
+	};
+
+	const ReachabilityResult result = exploreReachability(places, transitions);
+	EXPECT_EQ(3, result.numberOfMarkings);
+	EXPECT_EQ(2, result.numberOfDeadlocks);
+	ASSERT_EQ(2, result.deadlocks.size());
+	for (const auto &deadlock : result.deadlocks)
+	{
+		EXPECT_EQ(0, deadlock.at("P1"));
+		EXPECT_EQ(1, deadlock.at("P2") + deadlock.at("P3"));
+	}
+
+	const ReachabilityResult limitedResult =
+	exploreReachability(places, transitions, ReachabilityOptions{ .maxReportedDeadlocks = 1 });
+	EXPECT_EQ(2, limitedResult.numberOfDeadlocks);
+	EXPECT_EQ(1, limitedResult.deadlocks.size());
+}
+
+TEST(Reachability_, results_do_not_depend_on_the_number_of_threads)
+{
+	// Independent components, each alternating a token between two places, reach 2^n markings.
+	constexpr size_t numberOfComponents = 12;
+	vector<PlaceProperties> places;
+	vector<TransitionProperties> transitions;
+	for (size_t i = 0; i < numberOfComponents; ++i)
+	{
+		const string a = "A" + to_string(i);
+		const string b = "B" + to_string(i);
+		places.push_back(PlaceProperties{ .name = a, .initialNumberOfTokens = 1 });
+		places.push_back(PlaceProperties{ .name = b });
+		transitions.push_back(TransitionProperties{ .name = "TA" + to_string(i),
+													.activationArcs = { ArcProperties{ .placeName = a } },
+													.destinationArcs = { ArcProperties{ .placeName = b } } });
+		transitions.push_back(TransitionProperties{ .name = "TB" + to_string(i),
+													.activationArcs = { ArcProperties{ .placeName = b } },
+													.destinationArcs = { ArcProperties{ .placeName = a } } });
+	}
+
+	for (const size_t numberOfThreads : { 1, 4 })
+	{
+		const ReachabilityResult result =
+		exploreReachability(places, transitions, ReachabilityOptions{ .numberOfThreads = numberOfThreads });
+		EXPECT_TRUE(result.complete);
+		EXPECT_EQ(size_t{ 1 } << numberOfComponents, result.numberOfMarkings);
+		EXPECT_EQ(numberOfComponents << numberOfComponents, result.numberOfEdges);
+		EXPECT_EQ(0, result.numberOfDeadlocks);
+	}
+}
+
+TEST(Reachability_, exploration_of_unbounded_nets_stops_at_the_limits)
+{
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "P2" } };
+	const vector<TransitionProperties> transitions{ TransitionProperties{
+	.name = "T1",
+	.activationArcs = { ArcProperties{ .placeName = "P1" } },
+	.destinationArcs = { ArcProperties{ .placeName = "P1" }, ArcProperties{ .placeName = "P2" } } } };
+
+	const ReachabilityResult result =
+	exploreReachability(places, transitions, ReachabilityOptions{ .maxMarkings = 100 });
+	EXPECT_FALSE(result.complete);
+	EXPECT_EQ(100, result.numberOfMarkings);
+
+	const ReachabilityResult memoryLimitedResult =
+	exploreReachability(places, transitions, ReachabilityOptions{ .memoryLimit = 1 << 16 });
+	EXPECT_FALSE(memoryLimitedResult.complete);
+	EXPECT_LT(100, memoryLimitedResult.numberOfMarkings);
+}
@@ -0,0 +1,117 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/Verification.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Independent transitions Ti, from Pi to Qi, which all test the resource place R with the given type of arc.
+void createSharedResourceNet(PTN_Engine &ptnEngine, const size_t numberOfTransitions, const ArcProperties::Type type)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "R", .initialNumberOfTokens = 1 });
+	for (size_t i = 0; i < numberOfTransitions; ++i)
+	{
+		const string suffix = to_string(i);
+		ptnEngine.createPlace(PlaceProperties{ .name = "P" + suffix, .initialNumberOfTokens = 1 });
+		ptnEngine.createPlace(PlaceProperties{ .name = "Q" + suffix });
+		ptnEngine.createTransition(TransitionProperties{ .name = "T" + suffix,
+														 .activationArcs = { ArcProperties{ .placeName = "P" + suffix } },
+														 .destinationArcs = { ArcProperties{ .placeName = "Q" + suffix } } });
+		ptnEngine.addArc(ArcProperties{ .placeName = "R", .transitionName = "T" + suffix, .type = type });
+	}
+}
+} // namespace
+
+TEST(ReadArcs_, read_places_enable_the_transition_without_losing_tokens_or_calling_actions)
+{
+	size_t actions = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 3 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Resource",
+										   .initialNumberOfTokens = 2,
+										   .onEnterAction = [&actions] { ++actions; },
+										   .onExitAction = [&actions] { ++actions; } });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } },
+													 .readArcs = { ArcProperties{ .weight = 2, .placeName = "Resource" } } });
+
+	EXPECT_EQ(3, ptnEngine.step(10).firedTransitions);
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Resource"));
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens("Output"));
+	EXPECT_EQ(0, actions);
+}
+
+TEST(ReadArcs_, not_enough_tokens_in_a_read_place_disable_the_transition)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Resource", .initialNumberOfTokens = 1, .input = true });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .readArcs = { ArcProperties{ .weight = 2, .placeName = "Resource" } } });
+
+	EXPECT_EQ(0, ptnEngine.step().firedTransitions);
+	ptnEngine.incrementInputPlace("Resource");
+	EXPECT_EQ(1, ptnEngine.step().firedTransitions);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Resource"));
+}
+
+TEST(ReadArcs_, read_arcs_are_described_added_and_removed_like_the_other_arcs)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createSharedResourceNet(ptnEngine, 1, ArcProperties::Type::READ);
+
+	const vector<ArcProperties> readArcs = ptnEngine.getTransitionsProperties().at(0).readArcs;
+	ASSERT_EQ(1, readArcs.size());
+	EXPECT_EQ("R", readArcs[0].placeName);
+	EXPECT_EQ(ArcProperties::Type::READ, readArcs[0].type);
+	EXPECT_THROW(
+	ptnEngine.addArc(ArcProperties{ .placeName = "R", .transitionName = "T0", .type = ArcProperties::Type::READ }),
+	PTN_Exception);
+
+	ptnEngine.removeArc(ArcProperties{ .placeName = "R", .transitionName = "T0", .type = ArcProperties::Type::READ });
+	EXPECT_TRUE(ptnEngine.getTransitionsProperties().at(0).readArcs.empty());
+	EXPECT_THROW(ptnEngine.createTransition(TransitionProperties{
+				 .name = "T1", .readArcs = { ArcProperties{ .placeName = "R" }, ArcProperties{ .placeName = "R" } } }),
+				 ReadPlaceRepetitionException);
+}
+
+TEST(ReadArcs_, transitions_reading_the_same_place_do_not_conflict)
+{
+	PTN_Engine readingEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createSharedResourceNet(readingEngine, 10, ArcProperties::Type::READ);
+	const VerificationResult readingResult = verify(readingEngine);
+	EXPECT_TRUE(readingResult.deadlockReachable);
+	EXPECT_EQ(11, readingResult.numberOfMarkings);
+
+	// Taking and giving back the resource makes all the transitions conflict, so all the interleavings are explored.
+	PTN_Engine bidirectionalEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createSharedResourceNet(bidirectionalEngine, 10, ArcProperties::Type::BIDIRECTIONAL);
+	const VerificationResult bidirectionalResult = verify(bidirectionalEngine);
+	EXPECT_TRUE(bidirectionalResult.deadlockReachable);
+	EXPECT_EQ(1024, bidirectionalResult.numberOfMarkings);
+}
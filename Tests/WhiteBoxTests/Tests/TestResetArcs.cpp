@@ -0,0 +1,134 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Analysis/Invariants.h"
+#include "PTN_Engine/Analysis/Reachability.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Each token in P1 is moved to P2, adding a token to P3. Each token in P2 is moved back to P1, taking a token
+//! from P3 and emptying it, so that P1 + P3 is an invariant of the incidence matrix only.
+void createResettingCycle(vector<PlaceProperties> &places, vector<TransitionProperties> &transitions)
+{
+	places = { PlaceProperties{ .name = "P1", .initialNumberOfTokens = 2 }, PlaceProperties{ .name = "P2" },
+			   PlaceProperties{ .name = "P3" } };
+	transitions = { TransitionProperties{ .name = "T1",
+										  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+										  .destinationArcs = { ArcProperties{ .placeName = "P2" },
+															   ArcProperties{ .placeName = "P3" } } },
+					TransitionProperties{ .name = "T2",
+										  .activationArcs = { ArcProperties{ .placeName = "P2" },
+															  ArcProperties{ .placeName = "P3" } },
+										  .destinationArcs = { ArcProperties{ .placeName = "P1" } },
+										  .resetArcs = { ArcProperties{ .placeName = "P3" } } } };
+}
+} // namespace
+
+TEST(ResetArcs_, firing_empties_the_reset_places_in_a_single_firing)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .initialNumberOfTokens = 2 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Buffer", .initialNumberOfTokens = 1000 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "Input" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Output" } },
+													 .resetArcs = { ArcProperties{ .placeName = "Buffer" } } });
+
+	EXPECT_EQ(1, ptnEngine.step(1).firedTransitions);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Buffer"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Output"));
+
+	// An empty reset place does not prevent the transition from firing.
+	EXPECT_EQ(1, ptnEngine.step(1).firedTransitions);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Buffer"));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("Output"));
+}
+
+TEST(ResetArcs_, the_tokens_are_consumed_before_the_reset_and_produced_after_it)
+{
+	size_t exitActions = 0;
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1",
+										   .initialNumberOfTokens = 5,
+										   .onExitAction = [&exitActions] { ++exitActions; } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .weight = 2, .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .resetArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	EXPECT_EQ(1, ptnEngine.step(1).firedTransitions);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P1"));
+	// Once for the activation arc and once for the reset.
+	EXPECT_EQ(2, exitActions);
+}
+
+TEST(ResetArcs_, reset_arcs_are_described_added_and_removed_like_the_other_arcs)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .initialNumberOfTokens = 3 });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "T1", .activationArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	ptnEngine.addArc(ArcProperties{ .placeName = "P2", .transitionName = "T1", .type = ArcProperties::Type::RESET });
+	const vector<ArcProperties> resetArcs = ptnEngine.getTransitionsProperties().at(0).resetArcs;
+	ASSERT_EQ(1, resetArcs.size());
+	EXPECT_EQ("P2", resetArcs[0].placeName);
+	EXPECT_EQ(ArcProperties::Type::RESET, resetArcs[0].type);
+	EXPECT_THROW(
+	ptnEngine.addArc(ArcProperties{ .placeName = "P2", .transitionName = "T1", .type = ArcProperties::Type::RESET }),
+	PTN_Exception);
+
+	ptnEngine.removeArc(ArcProperties{ .placeName = "P2", .transitionName = "T1", .type = ArcProperties::Type::RESET });
+	EXPECT_TRUE(ptnEngine.getTransitionsProperties().at(0).resetArcs.empty());
+	ptnEngine.step(1);
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens("P2"));
+}
+
+TEST(ResetArcs_, repeated_reset_places_throw)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1" });
+	EXPECT_THROW(ptnEngine.createTransition(TransitionProperties{
+				 .name = "T1", .resetArcs = { ArcProperties{ .placeName = "P1" }, ArcProperties{ .placeName = "P1" } } }),
+				 ResetPlaceRepetitionException);
+}
+
+TEST(ResetArcs_, the_analyses_consider_the_reset_arcs)
+{
+	vector<PlaceProperties> places;
+	vector<TransitionProperties> transitions;
+	createResettingCycle(places, transitions);
+
+	const ReachabilityResult reachability = exploreReachability(places, transitions);
+	EXPECT_TRUE(reachability.complete);
+	EXPECT_EQ(2, reachability.placeBounds.at("P3"));
+
+	// P1 + P2 is invariant, while P1 + P3 and the cycle T1 + T2 are broken by the reset.
+	const InvariantsResult invariants = computeInvariants(places, transitions);
+	ASSERT_EQ(1, invariants.placeInvariants.size());
+	EXPECT_EQ((map<string, size_t>{ { "P1", 1 }, { "P2", 1 } }), invariants.placeInvariants[0]);
+	EXPECT_TRUE(invariants.transitionInvariants.empty());
+}
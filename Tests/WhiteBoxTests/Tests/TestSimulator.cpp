@@ -0,0 +1,117 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+TEST(Simulator_, deterministic_delays_advance_the_virtual_time)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .minimumDelay = 10min });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } } });
+
+	const SimulationResult result = ptnEngine.simulate(
+	SimulationOptions{ .delays = { { "T2", DelayDistribution{ .minimum = SimulationTime(5.0) } } } });
+
+	EXPECT_EQ(2, result.firedTransitions);
+	EXPECT_EQ(SimulationTime(10min) + SimulationTime(5.0), result.endTime);
+	EXPECT_FALSE(result.workRemaining);
+	EXPECT_EQ(1, result.firingsPerTransition.at("T1"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P3"));
+}
+
+TEST(Simulator_, the_transition_with_the_shortest_delay_wins_a_conflict)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Fast" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Slow" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Slow" } },
+													 .minimumDelay = 2ms });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Fast" } },
+													 .minimumDelay = 1ms });
+
+	const SimulationResult result = ptnEngine.simulate();
+	EXPECT_EQ(1, result.firedTransitions);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Fast"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Slow"));
+}
+
+TEST(Simulator_, simulation_stops_at_its_duration)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 1, 1);
+
+	const SimulationResult result = ptnEngine.simulate(SimulationOptions{
+	.duration = SimulationTime(1000.0), .delays = { { "T1", DelayDistribution{ .minimum = SimulationTime(1.0) } } } });
+	EXPECT_EQ(1000, result.firedTransitions);
+	EXPECT_EQ(SimulationTime(1000.0), result.endTime);
+	EXPECT_TRUE(result.workRemaining);
+}
+
+TEST(Simulator_, exponential_delays_have_the_configured_mean_and_are_reproducible)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 1, 1);
+
+	const SimulationOptions options{ .duration = SimulationTime(200000.0),
+									 .seed = 7,
+									 .delays = { { "T1", DelayDistribution{ .type = DelayDistribution::Type::EXPONENTIAL,
+																			.mean = SimulationTime(2.0) } } } };
+	const SimulationResult result = ptnEngine.simulate(options);
+	EXPECT_NEAR(100000, result.firedTransitions, 3000);
+	EXPECT_EQ(result.firedTransitions, ptnEngine.simulate(options).firedTransitions);
+}
+
+TEST(Simulator_, actions_are_suppressed_unless_requested)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	size_t numberOfActions = 0;
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1",
+										   .initialNumberOfTokens = 1,
+										   .onEnterAction = [&numberOfActions] { ++numberOfActions; } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	ptnEngine.simulate(SimulationOptions{ .maxFirings = 10 });
+	EXPECT_EQ(0, numberOfActions);
+
+	ptnEngine.simulate(SimulationOptions{ .maxFirings = 10, .executeActions = true });
+	EXPECT_EQ(10, numberOfActions);
+
+	// The actions executor is restored after the simulation.
+	ptnEngine.step();
+	EXPECT_EQ(11, numberOfActions);
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Redirect the tokens leaving T2 from one place to another.
+StructureUpdate redirectT2(const string &from, const string &to)
+{
+	using enum ArcProperties::Type;
+	return StructureUpdate{
+		.removedArcs = { ArcProperties{ .placeName = from, .transitionName = "T2", .type = DESTINATION } },
+		.addedArcs = { ArcProperties{ .placeName = to, .transitionName = "T2", .type = DESTINATION } }
+	};
+}
+} // namespace
+
+TEST(StructureUpdate_, places_transitions_and_arcs_can_be_added_while_the_event_loop_runs)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Input", .input = true });
+	ptnEngine.execute();
+
+	ptnEngine.updateStructure(StructureUpdate{
+	.places = { PlaceProperties{ .name = "Output" } },
+	.transitions = { TransitionProperties{ .name = "T1", .activationArcs = { ArcProperties{ .placeName = "Input" } } } },
+	.addedArcs = { ArcProperties{
+	.placeName = "Output", .transitionName = "T1", .type = ArcProperties::Type::DESTINATION } } });
+	EXPECT_TRUE(ptnEngine.isEventLoopRunning());
+
+	ptnEngine.incrementInputPlace("Input");
+	this_thread::sleep_for(50ms);
+	ptnEngine.stop();
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Input"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("Output"));
+}
+
+TEST(StructureUpdate_, addArc_and_removeArc_can_be_called_while_the_event_loop_runs)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	createRing(ptnEngine, 2, 10);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.execute();
+
+	using enum ArcProperties::Type;
+	ptnEngine.removeArc(ArcProperties{ .placeName = "P1", .transitionName = "T2", .type = DESTINATION });
+	ptnEngine.addArc(ArcProperties{ .placeName = "P3", .transitionName = "T2", .type = DESTINATION });
+	this_thread::sleep_for(50ms);
+	ptnEngine.stop();
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens("P3"));
+}
+
+TEST(StructureUpdate_, invalid_updates_throw_and_leave_the_net_unchanged)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 2, 1);
+	const auto transitionsProperties = ptnEngine.getTransitionsProperties();
+
+	StructureUpdate update = redirectT2("P1", "P3");
+	update.places.push_back(PlaceProperties{ .name = "P3" });
+	update.removedArcs.push_back(ArcProperties{ .placeName = "P3", .transitionName = "T1" });
+	EXPECT_THROW(ptnEngine.updateStructure(update), PTN_Exception);
+
+	update = redirectT2("P1", "P3");
+	update.places.push_back(PlaceProperties{ .name = "P2" });
+	EXPECT_THROW(ptnEngine.updateStructure(update), RepeatedPlaceException);
+
+	EXPECT_THROW(ptnEngine.getNumberOfTokens("P3"), PTN_Exception);
+	const auto unchangedProperties = ptnEngine.getTransitionsProperties();
+	ASSERT_EQ(transitionsProperties.size(), unchangedProperties.size());
+	for (const auto &properties : unchangedProperties)
+	{
+		const auto &before = *ranges::find(transitionsProperties, properties.name, &TransitionProperties::name);
+		ASSERT_EQ(1, properties.destinationArcs.size());
+		EXPECT_EQ(before.destinationArcs.front().placeName, properties.destinationArcs.front().placeName);
+	}
+}
+
+TEST(StructureUpdate_, firings_never_see_a_partial_update)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	createRing(ptnEngine, 2, 100);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T3",
+													 .activationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P1" } } });
+	ptnEngine.execute();
+
+	// A firing of T2 between the removal and the addition of its destination arc would destroy a token.
+	for (size_t i = 0; i < 500; ++i)
+	{
+		ptnEngine.updateStructure(i % 2 == 0 ? redirectT2("P1", "P3") : redirectT2("P3", "P1"));
+	}
+	ptnEngine.stop();
+	EXPECT_EQ(100, ptnEngine.getNumberOfTokens("P1") + ptnEngine.getNumberOfTokens("P2") +
+				   ptnEngine.getNumberOfTokens("P3"));
+}
+
+TEST(StructureUpdate_, places_and_transitions_can_be_removed_while_the_event_loop_runs)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	createRing(ptnEngine, 2, 10);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.execute();
+
+	// T2 is replaced by a transition with the same name, sending the tokens to a new place.
+	ptnEngine.updateStructure(StructureUpdate{
+	.places = { PlaceProperties{ .name = "P4" } },
+	.transitions = { TransitionProperties{ .name = "T2",
+										   .activationArcs = { ArcProperties{ .placeName = "P2" } },
+										   .destinationArcs = { ArcProperties{ .placeName = "P4" } } } },
+	.removedPlaces = { "P3" },
+	.removedTransitions = { "T2" } });
+	this_thread::sleep_for(50ms);
+	ptnEngine.stop();
+
+	EXPECT_THROW(ptnEngine.getNumberOfTokens("P3"), PTN_Exception);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens("P4"));
+}
+
+TEST(StructureUpdate_, places_linked_to_remaining_transitions_cannot_be_removed)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createRing(ptnEngine, 2, 1);
+
+	EXPECT_THROW(ptnEngine.updateStructure(StructureUpdate{ .removedPlaces = { "P2" }, .removedTransitions = { "T1" } }),
+				 PTN_Exception);
+	EXPECT_EQ(2, ptnEngine.getTransitionsProperties().size());
+
+	ptnEngine.updateStructure(StructureUpdate{ .removedPlaces = { "P2" }, .removedTransitions = { "T1", "T2" } });
+	EXPECT_TRUE(ptnEngine.getTransitionsProperties().empty());
+	EXPECT_EQ(1, ptnEngine.getPlacesProperties().size());
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P1"));
+}
+
+TEST(StructureUpdate_, places_linked_while_the_update_is_built_are_not_removed)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	promise<void> gate;
+	atomic<bool> actionStarted = false;
+	auto linkP3 = [&ptnEngine, &actionStarted, gateFuture = gate.get_future().share()]
+	{
+		actionStarted = true;
+		gateFuture.wait();
+		ptnEngine.createTransition(
+		TransitionProperties{ .name = "T2", .activationArcs = { ArcProperties{ .placeName = "P3" } } });
+	};
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .onEnterAction = linkP3 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.execute();
+	while (!actionStarted)
+	{
+		this_thread::sleep_for(1ms);
+	}
+
+	// The update is built while the action runs, and links P3 before the update is published.
+	auto update =
+	async(launch::async, [&ptnEngine] { ptnEngine.updateStructure(StructureUpdate{ .removedPlaces = { "P3" } }); });
+	this_thread::sleep_for(100ms);
+	gate.set_value();
+	EXPECT_THROW(update.get(), PTN_Exception);
+	ptnEngine.stop();
+
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P3"));
+	EXPECT_EQ(2, ptnEngine.getTransitionsProperties().size());
+}
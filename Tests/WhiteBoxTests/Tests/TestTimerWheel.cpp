@@ -0,0 +1,135 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/TimerWheel.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <ranges>
+
+using namespace std;
+using namespace ptne;
+
+TEST(TimerWheel_, nextExpiry_of_an_empty_wheel_is_empty)
+{
+	TimerWheel<int> timerWheel;
+	EXPECT_FALSE(timerWheel.nextExpiry().has_value());
+	EXPECT_TRUE(timerWheel.advance(1000).empty());
+	EXPECT_EQ(1000, timerWheel.getCurrentTick());
+}
+
+TEST(TimerWheel_, advance_returns_the_expired_timers_in_order_of_expiry)
+{
+	TimerWheel<int> timerWheel;
+	timerWheel.schedule(1, 300);
+	timerWheel.schedule(2, 10);
+	timerWheel.schedule(3, 70000);
+	EXPECT_EQ(3, timerWheel.size());
+	EXPECT_EQ(10, timerWheel.nextExpiry());
+
+	EXPECT_TRUE(timerWheel.advance(9).empty());
+	EXPECT_EQ(vector<int>({ 2, 1 }), timerWheel.advance(300));
+	EXPECT_EQ(70000, timerWheel.nextExpiry());
+	EXPECT_EQ(vector<int>({ 3 }), timerWheel.advance(100000));
+	EXPECT_EQ(0, timerWheel.size());
+}
+
+TEST(TimerWheel_, cancelled_and_rescheduled_timers_do_not_expire_at_their_previous_expiry)
+{
+	TimerWheel<string> timerWheel;
+	timerWheel.schedule("T1", 50);
+	timerWheel.schedule("T2", 60);
+	EXPECT_TRUE(timerWheel.cancel("T1"));
+	EXPECT_FALSE(timerWheel.cancel("T1"));
+	timerWheel.schedule("T2", 5000);
+	EXPECT_TRUE(timerWheel.contains("T2"));
+
+	EXPECT_TRUE(timerWheel.advance(4999).empty());
+	EXPECT_EQ(vector<string>({ "T2" }), timerWheel.advance(5000));
+	EXPECT_FALSE(timerWheel.contains("T2"));
+}
+
+TEST(TimerWheel_, timers_beyond_the_range_of_the_levels_expire)
+{
+	TimerWheel<int> timerWheel;
+	const TimerWheel<int>::Tick farAway = (uint64_t{ 1 } << 40) + 7;
+	timerWheel.schedule(1, farAway);
+	timerWheel.schedule(2, 1);
+	EXPECT_EQ(1, timerWheel.nextExpiry());
+	EXPECT_EQ(vector<int>({ 2 }), timerWheel.advance(farAway - 1));
+	EXPECT_EQ(farAway, timerWheel.nextExpiry());
+	EXPECT_EQ(vector<int>({ 1 }), timerWheel.advance(farAway));
+}
+
+TEST(TimerWheel_, behaves_as_an_ordered_map_of_expiries)
+{
+	TimerWheel<size_t> timerWheel;
+	map<size_t, TimerWheel<size_t>::Tick> reference;
+	mt19937_64 generator(42);
+	uniform_int_distribution<uint64_t> delay(0, 1 << 20);
+	uniform_int_distribution<size_t> key(0, 999);
+	uniform_int_distribution<int> operation(0, 9);
+
+	TimerWheel<size_t>::Tick now = 0;
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		if (const int op = operation(generator); op < 6)
+		{
+			const size_t k = key(generator);
+			const auto expiry = now + delay(generator);
+			timerWheel.schedule(k, expiry);
+			reference[k] = expiry;
+		}
+		else if (op < 8)
+		{
+			const size_t k = key(generator);
+			EXPECT_EQ(reference.erase(k) == 1, timerWheel.cancel(k));
+		}
+		else
+		{
+			now += delay(generator) / 16;
+			auto expired = timerWheel.advance(now);
+			vector<size_t> expectedExpired;
+			for (auto it = reference.begin(); it != reference.end();)
+			{
+				if (it->second <= now)
+				{
+					expectedExpired.push_back(it->first);
+					it = reference.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+			ranges::sort(expired);
+			ASSERT_EQ(expectedExpired, expired);
+		}
+
+		ASSERT_EQ(reference.size(), timerWheel.size());
+		if (reference.empty())
+		{
+			ASSERT_FALSE(timerWheel.nextExpiry().has_value());
+		}
+		else
+		{
+			ASSERT_EQ(ranges::min(reference | views::values), timerWheel.nextExpiry());
+		}
+	}
+}
@@ -74,6 +74,35 @@ TEST_F(Transition_PTNEngineAndPlace, constructor_with_repeated_inhibitor_arcs_th
 				 InhibitorPlaceRepetitionException);
 }
 
+TEST(Transition_, constructor_with_maximum_delay_shorter_than_minimum_delay_throws)
+{
+	EXPECT_THROW(Transition("T1", {}, {}, {}, {}, false, 20ms, 10ms), InvalidFiringWindowException);
+	EXPECT_NO_THROW(Transition("T1", {}, {}, {}, {}, false, 20ms, 0ms));
+	EXPECT_NO_THROW(Transition("T1", {}, {}, {}, {}, false, 20ms, 20ms));
+}
+
+TEST(Transition_, timed_transition_can_only_fire_within_its_firing_window)
+{
+	Transition transition("T1", {}, {}, {}, {}, false, 10ms, 20ms);
+	EXPECT_TRUE(transition.isTimed());
+	EXPECT_EQ(10ms, transition.getTransitionProperties().minimumDelay);
+	EXPECT_EQ(20ms, transition.getTransitionProperties().maximumDelay);
+
+	const auto now = chrono::steady_clock::now();
+	EXPECT_FALSE(transition.isWithinFiringWindow(now));
+	EXPECT_EQ(now + 10ms, transition.startEnabledTime(now));
+	EXPECT_FALSE(transition.startEnabledTime(now + 1ms).has_value());
+
+	EXPECT_FALSE(transition.isWithinFiringWindow(now + 9ms));
+	EXPECT_TRUE(transition.isWithinFiringWindow(now + 10ms));
+	EXPECT_TRUE(transition.isWithinFiringWindow(now + 20ms));
+	EXPECT_FALSE(transition.isWithinFiringWindow(now + 21ms));
+
+	transition.resetEnabledTime();
+	EXPECT_FALSE(transition.isWithinFiringWindow(now + 10ms));
+	EXPECT_FALSE(Transition("T2", {}, {}, {}, {}, false).isTimed());
+}
+
 TEST(Transition_, getTransitionProperties_empty_transition_properties_is_exported)
 {
 	Transition t("", {}, {}, {}, {}, false);
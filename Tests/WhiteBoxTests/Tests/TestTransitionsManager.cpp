@@ -36,7 +36,7 @@ TEST_F(TransitionsManager_Obj, clear)
 
 	TransitionProperties transitionProperties;
 	auto t = make_shared<Transition>("T1", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
-									 vector<pair<string, ConditionFunction>>{}, false);
+									 vector<pair<string, Condition>>{}, false);
 	transitionsManager.insert(t);
 	ASSERT_FALSE(transitionsManager.getTransitionsProperties().empty());
 	ASSERT_NO_THROW(transitionsManager.clear());
@@ -57,7 +57,7 @@ TEST_F(TransitionsManager_Obj, collectEnabledTransitionsRandomly)
 
 	TransitionProperties transitionProperties;
 	auto t = make_shared<Transition>("T1", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
-									 vector<pair<string, ConditionFunction>>{}, false);
+									 vector<pair<string, Condition>>{}, false);
 
 	transitionsManager.insert(t);
 	EXPECT_TRUE(transitionsManager.contains("T1"));
@@ -69,7 +69,7 @@ TEST_F(TransitionsManager_Obj, contains_returns_if_the_container_contains_an_ele
 	EXPECT_FALSE(transitionsManager.contains("T1"));
 	TransitionProperties transitionProperties;
 	auto t = make_shared<Transition>("T1", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
-									 vector<pair<string, ConditionFunction>>{}, false);
+									 vector<pair<string, Condition>>{}, false);
 	transitionsManager.insert(t);
 	EXPECT_TRUE(transitionsManager.contains("T1"));
 }
@@ -88,7 +88,7 @@ TEST_F(TransitionsManager_Obj, getTransition_returns_the_transition_by_name)
 {
 	TransitionProperties transitionProperties;
 	auto t = make_shared<Transition>("T1", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
-									 vector<pair<string, ConditionFunction>>{}, false);
+									 vector<pair<string, Condition>>{}, false);
 	transitionsManager.insert(t);
 	auto exported_t = transitionsManager.getTransition("T1");
 	EXPECT_EQ(t, exported_t);
@@ -98,11 +98,11 @@ TEST_F(TransitionsManager_Obj, getTransitionsProperties_exports_all_properties_f
 {
 	TransitionProperties transitionProperties;
 	auto t1 = make_shared<Transition>("T1", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
-									  vector<pair<string, ConditionFunction>>{}, false);
+									  vector<pair<string, Condition>>{}, false);
 	auto t2 = make_shared<Transition>("T2", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
-									  vector<pair<string, ConditionFunction>>{}, false);
+									  vector<pair<string, Condition>>{}, false);
 	auto t3 = make_shared<Transition>("T3", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
-									  vector<pair<string, ConditionFunction>>{}, false);
+									  vector<pair<string, Condition>>{}, false);
 	transitionsManager.insert(t1);
 	transitionsManager.insert(t2);
 	transitionsManager.insert(t3);
@@ -0,0 +1,146 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fixtures/Nets.h"
+#include "PTN_Engine/Analysis/Verification.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace ptne;
+
+namespace
+{
+//! Independent components, each moving its token once.
+void createIndependentComponents(PTN_Engine &ptnEngine, const size_t numberOfComponents)
+{
+	for (size_t i = 0; i < numberOfComponents; ++i)
+	{
+		const string a = "A" + to_string(i);
+		const string b = "B" + to_string(i);
+		ptnEngine.createPlace(PlaceProperties{ .name = a, .initialNumberOfTokens = 1 });
+		ptnEngine.createPlace(PlaceProperties{ .name = b });
+		ptnEngine.createTransition(TransitionProperties{ .name = "T" + to_string(i),
+														 .activationArcs = { ArcProperties{ .placeName = a } },
+														 .destinationArcs = { ArcProperties{ .placeName = b } } });
+	}
+}
+} // namespace
+
+TEST(Verification_, partial_order_reduction_skips_interleavings_of_independent_transitions)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createIndependentComponents(ptnEngine, 10);
+
+	const VerificationResult fullResult = verify(ptnEngine, VerificationOptions{ .partialOrderReduction = false });
+	EXPECT_TRUE(fullResult.deadlockReachable);
+	EXPECT_EQ(1024, fullResult.numberOfMarkings);
+
+	const VerificationResult result = verify(ptnEngine);
+	EXPECT_TRUE(result.deadlockReachable);
+	EXPECT_TRUE(result.deadlockCheckComplete);
+	EXPECT_EQ(11, result.numberOfMarkings);
+	ASSERT_EQ(10, result.deadlockFiringSequence.size());
+
+	// The firing sequence can be replayed through the engine.
+	for (const string &transition : result.deadlockFiringSequence)
+	{
+		EXPECT_TRUE(ptnEngine.fireTransition(transition));
+	}
+	EXPECT_FALSE(ptnEngine.step().workRemaining);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("B9"));
+}
+
+TEST(Verification_, deadlock_free_nets_are_verified)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	createMutualExclusion(ptnEngine);
+
+	const VerificationResult result =
+	verify(ptnEngine, VerificationOptions{ .targetMarkings = { { { "Critical1", 1 }, { "Critical2", 1 } },
+															   { { "Critical2", 1 }, { "Idle1", 1 } } } });
+	EXPECT_FALSE(result.deadlockReachable);
+	EXPECT_TRUE(result.deadlockCheckComplete);
+	EXPECT_TRUE(result.deadlockFiringSequence.empty());
+
+	ASSERT_EQ(2, result.targetMarkings.size());
+	EXPECT_FALSE(result.targetMarkings[0].reachable);
+	EXPECT_TRUE(result.targetMarkings[0].complete);
+	EXPECT_TRUE(result.targetMarkings[1].reachable);
+	EXPECT_EQ(vector<string>{ "Enter2" }, result.targetMarkings[1].firingSequence);
+}
+
+TEST(Verification_, reduction_respects_inhibitor_arcs)
+{
+	// T2 can only fire before T1, which inhibits it.
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Q1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Q2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "Q1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "Q2" } },
+													 .inhibitorArcs = { ArcProperties{ .placeName = "P2" } } });
+
+	const VerificationResult result =
+	verify(ptnEngine,
+		   VerificationOptions{ .targetMarkings = { { { "P2", 1 }, { "Q1", 1 } }, { { "P2", 1 }, { "Q2", 1 } } } });
+	EXPECT_TRUE(result.deadlockReachable);
+	ASSERT_EQ(2, result.targetMarkings.size());
+	EXPECT_TRUE(result.targetMarkings[0].reachable);
+	EXPECT_EQ(vector<string>{ "T1" }, result.targetMarkings[0].firingSequence);
+	EXPECT_TRUE(result.targetMarkings[1].reachable);
+	EXPECT_EQ((vector<string>{ "T2", "T1" }), result.targetMarkings[1].firingSequence);
+
+	// Q1 and Q2 always hold one token together.
+	const VerificationResult unreachableResult =
+	verify(ptnEngine,
+		   VerificationOptions{ .checkDeadlocks = false,
+								.targetMarkings = { { { "P1", 1 }, { "Q2", 0 }, { "Q1", 0 } } } });
+	EXPECT_FALSE(unreachableResult.targetMarkings[0].reachable);
+	EXPECT_TRUE(unreachableResult.targetMarkings[0].complete);
+}
+
+TEST(Verification_, incomplete_checks_are_reported)
+{
+	const vector<PlaceProperties> places{ PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 },
+										  PlaceProperties{ .name = "P2" } };
+	const vector<TransitionProperties> transitions{ TransitionProperties{
+	.name = "T1",
+	.activationArcs = { ArcProperties{ .placeName = "P1" } },
+	.destinationArcs = { ArcProperties{ .placeName = "P1" }, ArcProperties{ .placeName = "P2" } } } };
+
+	const VerificationResult result =
+	verify(places,
+		   transitions,
+		   VerificationOptions{ .targetMarkings = { { { "P2", 5 } }, { { "P2", 500 } } }, .maxMarkings = 100 });
+	EXPECT_FALSE(result.deadlockReachable);
+	EXPECT_FALSE(result.deadlockCheckComplete);
+	EXPECT_TRUE(result.targetMarkings[0].reachable);
+	EXPECT_EQ(5, result.targetMarkings[0].firingSequence.size());
+	EXPECT_FALSE(result.targetMarkings[1].reachable);
+	EXPECT_FALSE(result.targetMarkings[1].complete);
+
+	EXPECT_THROW(verify(places, transitions, VerificationOptions{ .targetMarkings = { { { "P3", 1 } } } }),
+				 InvalidNameException);
+}